@@ -73,6 +73,11 @@ namespace djv
                 }
                 AV::IO::ReadOptions readOptions;
                 readOptions.videoQueueSize = _readQueueSize;
+                readOptions.mmap = _readMMap;
+                readOptions.readAhead = _readAhead;
+                readOptions.prefetch = _prefetch;
+                readOptions.unpackType = _readUnpackType;
+                readOptions.rleThreadCount = _readRLEThreadCount;
                 _read = io->read(readFileInfo, readOptions);
                 _read->setThreadCount(_readThreadCount);
                 auto info = _read->getInfo().get();
@@ -94,6 +99,7 @@ namespace djv
                 }
                 AV::IO::WriteOptions writeOptions;
                 writeOptions.videoQueueSize = _writeQueueSize;
+                writeOptions.directIO = _writeDirect;
                 _write = io->write(writeFileInfo, info, writeOptions);
                 _write->setThreadCount(_writeThreadCount);
                 
@@ -105,7 +111,6 @@ namespace djv
                 {
                     Core::Frame::Number frame = 0;
                     {
-                        std::lock_guard<std::mutex> lock(_read->getMutex());
                         auto& queue = _read->getVideoQueue();
                         if (!queue.isEmpty())
                         {
@@ -135,22 +140,20 @@ namespace djv
                 CmdLine::Application::tick(dt);
                 if (_read && _write)
                 {
-                    std::unique_lock<std::mutex> readLock(_read->getMutex(), std::try_to_lock);
-                    if (readLock.owns_lock())
+                    auto& readQueue = _read->getVideoQueue();
+                    auto& writeQueue = _write->getVideoQueue();
+                    const bool readFinished = readQueue.isFinished();
+                    if (!readQueue.isEmpty())
                     {
-                        std::lock_guard<std::mutex> writeLock(_write->getMutex());
-                        auto& readQueue = _read->getVideoQueue();
-                        auto& writeQueue = _write->getVideoQueue();
-                        if (!readQueue.isEmpty() && writeQueue.getCount() < writeQueue.getMax())
+                        if (writeQueue.getCount() < writeQueue.getMax())
                         {
-                            auto frame = readQueue.popFrame();
-                            writeQueue.addFrame(frame);
-                        }
-                        else if (readQueue.isFinished())
-                        {
-                            writeQueue.setFinished(true);
+                            writeQueue.addFrame(readQueue.popFrame());
                         }
                     }
+                    else if (readFinished)
+                    {
+                        writeQueue.setFinished(true);
+                    }
                 }
                 if (_write && !_write->isRunning())
                 {
@@ -186,11 +189,21 @@ namespace djv
                         i = args.erase(i);
                         _readSeq = true;
                     }
+                    else if ("-readMMap" == *i)
+                    {
+                        i = args.erase(i);
+                        _readMMap = true;
+                    }
                     else if ("-writeSeq" == *i)
                     {
                         i = args.erase(i);
                         _writeSeq = true;
                     }
+                    else if ("-writeDirect" == *i)
+                    {
+                        i = args.erase(i);
+                        _writeDirect = true;
+                    }
                     else if ("-readQueue" == *i)
                     {
                         i = args.erase(i);
@@ -218,6 +231,40 @@ namespace djv
                         i = args.erase(i);
                         _readThreadCount = std::max(value, 1);
                     }
+                    else if ("-readAhead" == *i)
+                    {
+                        i = args.erase(i);
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _readAhead = std::max(value, 0);
+                    }
+                    else if ("-prefetch" == *i)
+                    {
+                        i = args.erase(i);
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _prefetch = std::max(value, 0);
+                    }
+                    else if ("-readUnpack" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _readUnpackType;
+                        i = args.erase(i);
+                    }
+                    else if ("-readRLEThreads" == *i)
+                    {
+                        i = args.erase(i);
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _readRLEThreadCount = std::max(value, 1);
+                    }
                     else if ("-writeThreads" == *i)
                     {
                         i = args.erase(i);
@@ -260,9 +307,15 @@ namespace djv
                 std::cout << DJV_TEXT("   -readSeq") << std::endl;
                 std::cout << DJV_TEXT("   Interpret the input file name as a sequence.") << std::endl;
                 std::cout << std::endl;
+                std::cout << DJV_TEXT("   -readMMap") << std::endl;
+                std::cout << DJV_TEXT("   Read the input with memory mapping.") << std::endl;
+                std::cout << std::endl;
                 std::cout << DJV_TEXT("   -writeSeq") << std::endl;
                 std::cout << DJV_TEXT("   Interpret the output file name as a sequence.") << std::endl;
                 std::cout << std::endl;
+                std::cout << DJV_TEXT("   -writeDirect") << std::endl;
+                std::cout << DJV_TEXT("   Write large DPX and Cineon frames without going through the operating system cache.") << std::endl;
+                std::cout << std::endl;
                 std::cout << DJV_TEXT("   -readQueue (value)") << std::endl;
                 std::cout << DJV_TEXT("   Set the size of the read queue.") << std::endl;
                 std::cout << std::endl;
@@ -272,6 +325,18 @@ namespace djv
                 std::cout << DJV_TEXT("   -readThreads (value)") << std::endl;
                 std::cout << DJV_TEXT("   Set the number of threads for reading.") << std::endl;
                 std::cout << std::endl;
+                std::cout << DJV_TEXT("   -readAhead (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the number of frames read asynchronously ahead of decoding.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -prefetch (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the maximum number of frames prefetched into the operating system cache.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -readUnpack (type)") << std::endl;
+                std::cout << DJV_TEXT("   Unpack 10-bit and 12-bit DPX and Cineon data to the given image type, for example RGB_U16, RGBA_F16 or RGBA_U8.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -readRLEThreads (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the number of threads for decoding each SGI, RLA or IFF image.") << std::endl;
+                std::cout << std::endl;
                 std::cout << DJV_TEXT("   -writeThreads (value)") << std::endl;
                 std::cout << DJV_TEXT("   Set the number of threads for writing.") << std::endl;
                 std::cout << std::endl;
@@ -281,11 +346,17 @@ namespace djv
             std::string _output;
             std::unique_ptr<AV::Image::Size> _resize;
             bool _readSeq = false;
+            bool _readMMap = false;
             bool _writeSeq = false;
+            bool _writeDirect = false;
             //! \todo What's a good default for this?
             size_t _readQueueSize = 10;
             size_t _writeQueueSize = 10;
             size_t _readThreadCount = 4;
+            size_t _readAhead = 0;
+            size_t _prefetch = 0;
+            AV::Image::Type _readUnpackType = AV::Image::Type::None;
+            size_t _readRLEThreadCount = 1;
             size_t _writeThreadCount = 4;
             std::shared_ptr<AV::IO::IRead> _read;
             std::shared_ptr<Core::Time::Timer> _statsTimer;
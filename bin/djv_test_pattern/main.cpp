@@ -153,7 +153,6 @@ namespace djv
         {
             CmdLine::Application::tick(dt);
             {
-                std::lock_guard<std::mutex> writeLock(_write->getMutex());
                 auto& writeQueue = _write->getVideoQueue();
                 if (_images.size() && writeQueue.getCount() < writeQueue.getMax())
                 {
@@ -221,13 +221,11 @@ namespace djv
 
                 } // namespace
 
-                Header read(FileSystem::FileIO& io, Info& info, ColorProfile& colorProfile)
+                Header readHeader(FileSystem::FileIO& io)
                 {
                     Header out;
                     zero(out);
 
-                    info.fileName = io.getFileName();
-
                     // Read the file section of the header.
                     io.read(&out.file, sizeof(Header::File));
 
@@ -246,50 +244,68 @@ namespace djv
                         throw FileSystem::Error(ss.str());
                     }
 
-                    // Read the rest of the header.
-                    io.read(&out.image, sizeof(Header::Image));
-                    io.read(&out.source, sizeof(Header::Source));
-                    io.read(&out.film, sizeof(Header::Film));
+                    // Read the rest of the header with a single read.
+                    const size_t imageByteCount = sizeof(Header::Image);
+                    const size_t sourceByteCount = sizeof(Header::Source);
+                    const size_t filmByteCount = sizeof(Header::Film);
+                    uint8_t buf[imageByteCount + sourceByteCount + filmByteCount];
+                    io.read(buf, sizeof(buf));
+                    const uint8_t* p = buf;
+                    memcpy(&out.image, p, imageByteCount);
+                    p += imageByteCount;
+                    memcpy(&out.source, p, sourceByteCount);
+                    p += sourceByteCount;
+                    memcpy(&out.film, p, filmByteCount);
 
                     // Flip the endian of the data if necessary.
                     if (flipEndian)
                     {
                         io.setEndianConversion(true);
                         convertEndian(out);
+                    }
+
+                    return out;
+                }
+
+                void parseInfo(const FileSystem::FileIO& io, const Header& header, Info& info, ColorProfile& colorProfile)
+                {
+                    info.fileName = io.getFileName();
+                    if (magic[1] == header.file.magic)
+                    {
                         info.video[0].info.layout.endian = Memory::opposite(Memory::getEndian());
                     }
 
                     // Read the image section of the header.
-                    if (!out.image.channels)
+                    if (!header.image.channels)
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("No image channels.");
                         throw FileSystem::Error(ss.str());
                     }
                     uint8_t i = 1;
-                    for (; i < out.image.channels; ++i)
+                    for (; i < header.image.channels; ++i)
                     {
-                        if ((out.image.channel[i].size[0] != out.image.channel[0].size[0]) ||
-                            (out.image.channel[i].size[1] != out.image.channel[0].size[1]))
+                        if ((header.image.channel[i].size[0] != header.image.channel[0].size[0]) ||
+                            (header.image.channel[i].size[1] != header.image.channel[0].size[1]))
                         {
                             break;
                         }
-                        if (out.image.channel[i].bitDepth != out.image.channel[0].bitDepth)
+                        if (header.image.channel[i].bitDepth != header.image.channel[0].bitDepth)
                         {
                             break;
                         }
                     }
-                    if (i < out.image.channels)
+                    if (i < header.image.channels)
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Image channels must have the same size and bit depth.");
                         throw FileSystem::Error(ss.str());
                     }
                     Image::Type imageType = Image::Type::None;
-                    switch (out.image.channels)
+                    switch (header.image.channels)
                     {
                     case 3:
-                        switch (out.image.channel[0].bitDepth)
+                        switch (header.image.channel[0].bitDepth)
                         {
                         case 10:
                             imageType = Image::Type::RGB_U10;
@@ -305,13 +321,13 @@ namespace djv
                         ss << DJV_TEXT("Unsupported bit depth.");
                         throw FileSystem::Error(ss.str());
                     }
-                    if (isValid(&out.image.linePadding) && out.image.linePadding)
+                    if (isValid(&header.image.linePadding) && header.image.linePadding)
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Line padding is unsupported.");
                         throw FileSystem::Error(ss.str());
                     }
-                    if (isValid(&out.image.channelPadding) && out.image.channelPadding)
+                    if (isValid(&header.image.channelPadding) && header.image.channelPadding)
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Channel padding is unsupported.");
@@ -320,15 +336,15 @@ namespace djv
 
                     // Collect information.
                     info.video[0].info.type = imageType;
-                    info.video[0].info.size.w = out.image.channel[0].size[0];
-                    info.video[0].info.size.h = out.image.channel[0].size[1];
-                    if (io.getSize() - out.file.imageOffset != info.video[0].info.getDataByteCount())
+                    info.video[0].info.size.w = header.image.channel[0].size[0];
+                    info.video[0].info.size.h = header.image.channel[0].size[1];
+                    if (io.getSize() - header.file.imageOffset != info.video[0].info.getDataByteCount())
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Incomplete file.");
                         throw FileSystem::Error(ss.str());
                     }
-                    switch (static_cast<Orient>(out.image.orient))
+                    switch (static_cast<Orient>(header.image.orient))
                     {
                     case Orient::LeftRightBottomTop:
                         info.video[0].info.layout.mirror.y = true;
@@ -348,87 +364,136 @@ namespace djv
                         break;
                     default: break;
                     }
-                    if (isValid(out.file.time, 24))
+                    switch (static_cast<Descriptor>(header.image.channel[0].descriptor[1]))
+                    {
+                    case Descriptor::RedFilmPrint: colorProfile = ColorProfile::FilmPrint; break;
+                    default:                       colorProfile = ColorProfile::Raw;       break;
+                    }
+                }
+
+                Packing getPacking(const Header& header)
+                {
+                    // The 10-bit samples are always stored with the padding in
+                    // the least significant bits, see parseInfo().
+                    Packing out;
+                    if (10 == header.image.channel[0].bitDepth)
+                    {
+                        out.bitDepth = 10;
+                    }
+                    return out;
+                }
+
+                void parseTags(const Header& header, Info& info)
+                {
+                    if (isValid(header.file.time, 24))
                     {
-                        info.tags.setTag("Time", toString(out.file.time, 24));
+                        info.tags.setTag("Time", toString(header.file.time, 24));
                     }
-                    if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
+                    if (isValid(&header.source.offset[0]) && isValid(&header.source.offset[1]))
                     {
                         std::stringstream ss;
-                        ss << out.source.offset[0] << " " << out.source.offset[1];
+                        ss << header.source.offset[0] << " " << header.source.offset[1];
                         info.tags.setTag("Source Offset", ss.str());
                     }
-                    if (isValid(out.source.file, 100))
+                    if (isValid(header.source.file, 100))
                     {
-                        info.tags.setTag("Source File", toString(out.source.file, 100));
+                        info.tags.setTag("Source File", toString(header.source.file, 100));
                     }
-                    if (isValid(out.source.time, 24))
+                    if (isValid(header.source.time, 24))
                     {
-                        info.tags.setTag("Source Time", toString(out.source.time, 24));
+                        info.tags.setTag("Source Time", toString(header.source.time, 24));
                     }
-                    if (isValid(out.source.inputDevice, 64))
+                    if (isValid(header.source.inputDevice, 64))
                     {
-                        info.tags.setTag("Source Input Device", toString(out.source.inputDevice, 64));
+                        info.tags.setTag("Source Input Device", toString(header.source.inputDevice, 64));
                     }
-                    if (isValid(out.source.inputModel, 32))
+                    if (isValid(header.source.inputModel, 32))
                     {
-                        info.tags.setTag("Source Input Model", toString(out.source.inputModel, 32));
+                        info.tags.setTag("Source Input Model", toString(header.source.inputModel, 32));
                     }
-                    if (isValid(out.source.inputSerial, 32))
+                    if (isValid(header.source.inputSerial, 32))
                     {
-                        info.tags.setTag("Source Input Serial", toString(out.source.inputSerial, 32));
+                        info.tags.setTag("Source Input Serial", toString(header.source.inputSerial, 32));
                     }
-                    if (isValid(&out.source.inputPitch[0]) && isValid(&out.source.inputPitch[1]))
+                    if (isValid(&header.source.inputPitch[0]) && isValid(&header.source.inputPitch[1]))
                     {
                         std::stringstream ss;
-                        ss << out.source.inputPitch[0] << " " << out.source.inputPitch[1];
+                        ss << header.source.inputPitch[0] << " " << header.source.inputPitch[1];
                         info.tags.setTag("Source Input Pitch", ss.str());
                     }
-                    if (isValid(&out.source.gamma))
+                    if (isValid(&header.source.gamma))
                     {
                         std::stringstream ss;
-                        ss << out.source.gamma;
+                        ss << header.source.gamma;
                         info.tags.setTag("Source Gamma", ss.str());
                     }
-                    if (isValid(&out.film.id) &&
-                        isValid(&out.film.type) &&
-                        isValid(&out.film.offset) &&
-                        isValid(&out.film.prefix) &&
-                        isValid(&out.film.count))
+                    if (isValid(&header.film.id) &&
+                        isValid(&header.film.type) &&
+                        isValid(&header.film.offset) &&
+                        isValid(&header.film.prefix) &&
+                        isValid(&header.film.count))
                     {
                         info.tags.setTag("Keycode", Time::keycodeToString(
-                            out.film.id, out.film.type, out.film.prefix, out.film.count, out.film.offset));
+                            header.film.id, header.film.type, header.film.prefix, header.film.count, header.film.offset));
                     }
-                    if (isValid(out.film.format, 32))
+                    if (isValid(header.film.format, 32))
                     {
-                        info.tags.setTag("Film Format", toString(out.film.format, 32));
+                        info.tags.setTag("Film Format", toString(header.film.format, 32));
                     }
-                    if (isValid(&out.film.frame))
+                    if (isValid(&header.film.frame))
                     {
                         std::stringstream ss;
-                        ss << out.film.frame;
+                        ss << header.film.frame;
                         info.tags.setTag("Film Frame", ss.str());
                     }
-                    if (isValid(&out.film.frameRate) && out.film.frameRate >= _minSpeed)
+                    if (isValid(&header.film.frameRate) && header.film.frameRate >= _minSpeed)
                     {
-                        info.video[0].speed = Time::Speed(Math::Rational::fromFloat(out.film.frameRate));
+                        info.video[0].speed = Time::Speed(Math::Rational::fromFloat(header.film.frameRate));
                         std::stringstream ss;
-                        ss << out.film.frameRate;
+                        ss << header.film.frameRate;
                         info.tags.setTag("Film Frame Rate", ss.str());
                     }
-                    if (isValid(out.film.frameId, 32))
-                    {
-                        info.tags.setTag("Film Frame ID", toString(out.film.frameId, 32));
-                    }
-                    if (isValid(out.film.slate, 200))
+                    if (isValid(header.film.frameId, 32))
                     {
-                        info.tags.setTag("Film Slate", toString(out.film.slate, 200));
+                        info.tags.setTag("Film Frame ID", toString(header.film.frameId, 32));
                     }
-                    switch (static_cast<Descriptor>(out.image.channel[0].descriptor[1]))
+                    if (isValid(header.film.slate, 200))
                     {
-                    case Descriptor::RedFilmPrint: colorProfile = ColorProfile::FilmPrint; break;
-                    default:                       colorProfile = ColorProfile::Raw;       break;
+                        info.tags.setTag("Film Slate", toString(header.film.slate, 200));
                     }
+                }
+
+                std::vector<uint8_t> getTemplateKey(const FileSystem::FileIO& io, const Header& header)
+                {
+                    // The fields that determine how the image data is read.
+                    const uint64_t fileSize = io.getSize();
+                    std::vector<uint8_t> out;
+                    auto append = [&out](const void* data, size_t size)
+                    {
+                        const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+                        out.insert(out.end(), p, p + size);
+                    };
+                    append(&fileSize, sizeof(fileSize));
+                    append(&header.file.magic, sizeof(header.file.magic));
+                    append(&header.file.imageOffset, sizeof(header.file.imageOffset));
+                    append(&header.image.orient, sizeof(header.image.orient));
+                    append(&header.image.channels, sizeof(header.image.channels));
+                    for (uint8_t i = 0; i < header.image.channels && i < 8; ++i)
+                    {
+                        append(header.image.channel[i].descriptor, sizeof(header.image.channel[i].descriptor));
+                        append(&header.image.channel[i].bitDepth, sizeof(header.image.channel[i].bitDepth));
+                        append(header.image.channel[i].size, sizeof(header.image.channel[i].size));
+                    }
+                    append(&header.image.linePadding, sizeof(header.image.linePadding));
+                    append(&header.image.channelPadding, sizeof(header.image.channelPadding));
+                    return out;
+                }
+
+                Header read(FileSystem::FileIO& io, Info& info, ColorProfile& colorProfile)
+                {
+                    const Header out = readHeader(io);
+                    parseInfo(io, out, info, colorProfile);
+                    parseTags(out, info);
 
                     // Set the file position.
                     if (out.file.imageOffset)
@@ -617,7 +682,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo & fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _threadPool, _cacheManager, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
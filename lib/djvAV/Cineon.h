@@ -56,6 +56,24 @@ namespace djv
                     First = Raw
                 };
 
+                //! This struct provides how 10-bit and 12-bit samples are packed
+                //! into 32-bit words (10-bit RGB) or 16-bit words (12-bit).
+                struct Packing
+                {
+                    uint8_t bitDepth = 0;     //!< 10 or 12, zero for data that is not packed
+                    bool    methodB  = false; //!< The padding is in the most significant bits instead of the least
+                };
+
+                //! Get the image type that packed data is unpacked to, given the
+                //! type requested with ReadOptions::unpackType. Image::Type::None
+                //! is returned if the data can be used as it is.
+                Image::Type getUnpackType(Image::Type, const Packing&, Image::Type requested);
+
+                //! Unpack 10-bit or 12-bit image data, converting the endian and
+                //! the packing in the same pass. The output type comes from
+                //! getUnpackType().
+                std::shared_ptr<Image::Image> unpack(const std::shared_ptr<Image::Image>&, const Packing&, Image::Type);
+
                 //! This constant provides the Cineon file header magic numbers.
                 const uint32_t magic[] =
                 {
@@ -189,6 +207,29 @@ namespace djv
                 //! Zero out the data in a Cineon file header.
                 void zero(Header&);
 
+                //! Read a Cineon file header without parsing it. The header is
+                //! converted to the native endian.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                Header readHeader(Core::FileSystem::FileIO&);
+
+                //! Parse the image information from a Cineon file header.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                void parseInfo(const Core::FileSystem::FileIO&, const Header&, Info&, ColorProfile&);
+
+                //! Get how the samples are packed from a Cineon file header.
+                Packing getPacking(const Header&);
+
+                //! Parse the tags from a Cineon file header.
+                void parseTags(const Header&, Info&);
+
+                //! Get the header template key for a Cineon file, see
+                //! ISequenceRead.
+                std::vector<uint8_t> getTemplateKey(const Core::FileSystem::FileIO&, const Header&);
+
                 //! Read a Cineon file header.
                 //!
                 //! Throws:
@@ -204,6 +245,37 @@ namespace djv
                 //! Finish writing the Cineon file header after image data is written.
                 void writeFinish(Core::FileSystem::FileIO&);
 
+                //! Get the image type that images are converted to before they
+                //! are given to writeImage().
+                Image::Type getWriteType(Image::Type);
+
+                //! Pack a scanline to 10-bit RGB words (method A) in the given
+                //! endian. The image type comes from getWriteType(), and the
+                //! scanline is mirrored if the layout is mirrored in X.
+                void packScanline(const uint8_t*, const Image::Info&, Core::Memory::Endian, uint8_t*);
+
+                //! Write the image data of a Cineon or DPX file after the header
+                //! with a second file handle that bypasses the operating system
+                //! cache. The blocks are written from an aligned buffer at
+                //! aligned file positions, as required by O_DIRECT, so the end of
+                //! the header is read back into the start of the first block.
+                //! Returns false if the file cannot be opened for direct I/O.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                bool writeImageDirect(Core::FileSystem::FileIO&, const Image::Image&, Core::Memory::Endian);
+
+                //! Write the image data of a Cineon or DPX file after the header,
+                //! packing the pixels to 10-bit RGB words (method A) in the given
+                //! endian. The image type comes from getWriteType(), and the image
+                //! can have any layout. The file is preallocated and the scanlines
+                //! are packed into a large buffer that is written in blocks. Large
+                //! images are written with writeImageDirect() if directIO is set.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                void writeImage(Core::FileSystem::FileIO&, const Image::Image&, Core::Memory::Endian, bool directIO);
+
                 //! This class provides the Cineon file reader.
                 class Read : public ISequenceRead
                 {
@@ -218,19 +290,31 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    //! Read the image data. If the file is memory mapped the
+                    //! image refers to the file instead of being copied. Only
+                    //! the scanlines needed for the region of interest and proxy
+                    //! scale are read. Packed data is unpacked when the packing
+                    //! is not supported by OpenGL, or when it is requested with
+                    //! ReadOptions::unpackType.
                     static std::shared_ptr<Image::Image> readImage(
                         const Info&,
-                        Core::FileSystem::FileIO&);
+                        const std::shared_ptr<Core::FileSystem::FileIO>&,
+                        const ReadOptions&,
+                        const Packing&);
 
                 protected:
                     Info _readInfo(const std::string &) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
+                    bool _hasReadAhead() const override;
+                    bool _hasProxy() const override;
 
                 private:
-                    Info _open(const std::string&, Core::FileSystem::FileIO&);
+                    Info _open(const std::string&, Core::FileSystem::FileIO&, Packing&);
 
                     DJV_PRIVATE();
                 };
@@ -256,6 +340,7 @@ namespace djv
                 protected:
                     Image::Type _getImageType(Image::Type) const override;
                     Image::Layout _getImageLayout() const override;
+                    bool _hasImageLayoutConversion() const override;
                     void _write(const std::string & fileName, const std::shared_ptr<Image::Image> &) override;
 
                 private:
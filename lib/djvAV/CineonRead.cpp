@@ -29,7 +29,22 @@
 
 #include <djvAV/Cineon.h>
 
+#include <djvAV/ImageUtil.h>
+
 #include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define DJV_CINEON_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+#if defined(__AVX2__)
+#define DJV_CINEON_AVX2
+#include <immintrin.h>
+#endif // __AVX2__
 
 using namespace djv::Core;
 
@@ -41,6 +56,391 @@ namespace djv
         {
             namespace Cineon
             {
+                namespace
+                {
+                    inline uint32_t swap32(uint32_t value)
+                    {
+                        return (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+                    }
+
+                    inline uint16_t swap16(uint16_t value)
+                    {
+                        return static_cast<uint16_t>((value >> 8) | (value << 8));
+                    }
+
+#if defined(DJV_CINEON_SSE2)
+                    // SSE2 does not have a byte shuffle, so the 16-bit halves
+                    // are swapped first and then the bytes.
+                    inline __m128i swap32(__m128i value)
+                    {
+                        value = _mm_or_si128(_mm_slli_epi32(value, 16), _mm_srli_epi32(value, 16));
+                        return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+                    }
+
+                    inline __m128i swap16(__m128i value)
+                    {
+                        return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+                    }
+#endif // DJV_CINEON_SSE2
+
+#if defined(DJV_CINEON_AVX2)
+                    inline __m256i swap32(__m256i value)
+                    {
+                        const __m256i mask = _mm256_setr_epi8(
+                            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+                        return _mm256_shuffle_epi8(value, mask);
+                    }
+#endif // DJV_CINEON_AVX2
+
+                    //! Repack 10-bit RGB words to method A in the machine
+                    //! endian (Image::Type::RGB_U10).
+                    void repackU10(const uint8_t* in, size_t count, bool convertEndian, bool methodB, uint8_t* out)
+                    {
+                        size_t i = 0;
+#if defined(DJV_CINEON_AVX2)
+                        for (; i + 8 <= count; i += 8, in += 32, out += 32)
+                        {
+                            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+                            if (convertEndian)
+                            {
+                                v = swap32(v);
+                            }
+                            if (methodB)
+                            {
+                                v = _mm256_slli_epi32(v, 2);
+                            }
+                            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+                        }
+#endif // DJV_CINEON_AVX2
+#if defined(DJV_CINEON_SSE2)
+                        for (; i + 4 <= count; i += 4, in += 16, out += 16)
+                        {
+                            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                            if (convertEndian)
+                            {
+                                v = swap32(v);
+                            }
+                            if (methodB)
+                            {
+                                v = _mm_slli_epi32(v, 2);
+                            }
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+                        }
+#endif // DJV_CINEON_SSE2
+                        for (; i < count; ++i, in += 4, out += 4)
+                        {
+                            uint32_t v = 0;
+                            memcpy(&v, in, 4);
+                            if (convertEndian)
+                            {
+                                v = swap32(v);
+                            }
+                            if (methodB)
+                            {
+                                v <<= 2;
+                            }
+                            memcpy(out, &v, 4);
+                        }
+                    }
+
+                    //! Unpack 10-bit RGB words to Image::Type::RGBA_U8.
+                    void unpackU10ToRGBA_U8(const uint8_t* in, size_t count, bool convertEndian, bool methodB, uint8_t* out)
+                    {
+                        size_t i = 0;
+#if defined(DJV_CINEON_AVX2)
+                        {
+                            const __m256i mask = _mm256_set1_epi32(0xff);
+                            const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xff000000));
+                            for (; i + 8 <= count; i += 8, in += 32, out += 32)
+                            {
+                                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+                                if (convertEndian)
+                                {
+                                    v = swap32(v);
+                                }
+                                if (methodB)
+                                {
+                                    v = _mm256_slli_epi32(v, 2);
+                                }
+                                const __m256i r = _mm256_srli_epi32(v, 24);
+                                const __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 14), mask);
+                                const __m256i b = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask);
+                                v = _mm256_or_si256(
+                                    _mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                    _mm256_or_si256(_mm256_slli_epi32(b, 16), alpha));
+                                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+                            }
+                        }
+#endif // DJV_CINEON_AVX2
+#if defined(DJV_CINEON_SSE2)
+                        {
+                            const __m128i mask = _mm_set1_epi32(0xff);
+                            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+                            for (; i + 4 <= count; i += 4, in += 16, out += 16)
+                            {
+                                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                                if (convertEndian)
+                                {
+                                    v = swap32(v);
+                                }
+                                if (methodB)
+                                {
+                                    v = _mm_slli_epi32(v, 2);
+                                }
+                                const __m128i r = _mm_srli_epi32(v, 24);
+                                const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 14), mask);
+                                const __m128i b = _mm_and_si128(_mm_srli_epi32(v, 4), mask);
+                                v = _mm_or_si128(
+                                    _mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                    _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+                                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+                            }
+                        }
+#endif // DJV_CINEON_SSE2
+                        for (; i < count; ++i, in += 4, out += 4)
+                        {
+                            uint32_t v = 0;
+                            memcpy(&v, in, 4);
+                            if (convertEndian)
+                            {
+                                v = swap32(v);
+                            }
+                            if (methodB)
+                            {
+                                v <<= 2;
+                            }
+                            out[0] = static_cast<uint8_t>(v >> 24);
+                            out[1] = static_cast<uint8_t>(v >> 14);
+                            out[2] = static_cast<uint8_t>(v >> 4);
+                            out[3] = 255;
+                        }
+                    }
+
+                    //! Unpack 12-bit samples to 16-bit samples.
+                    void unpackU12ToU16(const uint8_t* in, size_t count, bool convertEndian, bool methodB, uint8_t* out)
+                    {
+                        size_t i = 0;
+#if defined(DJV_CINEON_SSE2)
+                        {
+                            const __m128i mask = _mm_set1_epi16(static_cast<short>(0xfff0));
+                            for (; i + 8 <= count; i += 8, in += 16, out += 16)
+                            {
+                                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                                if (convertEndian)
+                                {
+                                    v = swap16(v);
+                                }
+                                v = methodB ? _mm_slli_epi16(v, 4) : _mm_and_si128(v, mask);
+                                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+                            }
+                        }
+#endif // DJV_CINEON_SSE2
+                        for (; i < count; ++i, in += 2, out += 2)
+                        {
+                            uint16_t v = 0;
+                            memcpy(&v, in, 2);
+                            if (convertEndian)
+                            {
+                                v = swap16(v);
+                            }
+                            v = methodB ? static_cast<uint16_t>(v << 4) : (v & 0xfff0);
+                            memcpy(out, &v, 2);
+                        }
+                    }
+
+                    //! Unpack 10-bit or 12-bit pixels with a look-up table from
+                    //! the sample values to the output data type.
+                    template<typename T>
+                    void unpackLUT(
+                        const uint8_t*        in,
+                        size_t                count,
+                        const Packing&        packing,
+                        bool                  convertEndian,
+                        uint8_t               inChannels,
+                        uint8_t               outChannels,
+                        const std::vector<T>& lut,
+                        T*                    out)
+                    {
+                        const uint16_t max = static_cast<uint16_t>(lut.size() - 1);
+                        uint16_t rgba[4] = { 0, 0, 0, max };
+                        for (size_t i = 0; i < count; ++i, out += outChannels)
+                        {
+                            if (10 == packing.bitDepth)
+                            {
+                                uint32_t v = 0;
+                                memcpy(&v, in, 4);
+                                in += 4;
+                                if (convertEndian)
+                                {
+                                    v = swap32(v);
+                                }
+                                if (packing.methodB)
+                                {
+                                    v <<= 2;
+                                }
+                                rgba[0] = v >> 22;
+                                rgba[1] = (v >> 12) & 0x3ff;
+                                rgba[2] = (v >> 2) & 0x3ff;
+                            }
+                            else
+                            {
+                                uint16_t samples[4] = { 0, 0, 0, max };
+                                for (uint8_t c = 0; c < inChannels; ++c, in += 2)
+                                {
+                                    uint16_t v = 0;
+                                    memcpy(&v, in, 2);
+                                    if (convertEndian)
+                                    {
+                                        v = swap16(v);
+                                    }
+                                    samples[c] = packing.methodB ? (v & 0xfff) : (v >> 4);
+                                }
+                                switch (inChannels)
+                                {
+                                case 1:
+                                    rgba[0] = rgba[1] = rgba[2] = samples[0];
+                                    break;
+                                case 2:
+                                    rgba[0] = rgba[1] = rgba[2] = samples[0];
+                                    rgba[3] = samples[1];
+                                    break;
+                                default:
+                                    memcpy(rgba, samples, sizeof(rgba));
+                                    break;
+                                }
+                            }
+                            switch (outChannels)
+                            {
+                            case 1:
+                                out[0] = lut[rgba[0]];
+                                break;
+                            case 2:
+                                out[0] = lut[rgba[0]];
+                                out[1] = lut[rgba[3]];
+                                break;
+                            case 3:
+                                out[0] = lut[rgba[0]];
+                                out[1] = lut[rgba[1]];
+                                out[2] = lut[rgba[2]];
+                                break;
+                            case 4:
+                                out[0] = lut[rgba[0]];
+                                out[1] = lut[rgba[1]];
+                                out[2] = lut[rgba[2]];
+                                out[3] = lut[rgba[3]];
+                                break;
+                            default: break;
+                            }
+                        }
+                    }
+
+                } // namespace
+
+                Image::Type getUnpackType(Image::Type type, const Packing& packing, Image::Type requested)
+                {
+                    Image::Type out = Image::Type::None;
+                    if (packing.bitDepth)
+                    {
+                        const uint8_t channelCount = std::max(Image::getChannelCount(type), Image::getChannelCount(requested));
+                        switch (Image::getDataType(requested))
+                        {
+                        case Image::DataType::U8:  out = Image::getIntType(channelCount, 8);    break;
+                        case Image::DataType::U16: out = Image::getIntType(channelCount, 16);   break;
+                        case Image::DataType::F16: out = Image::getFloatType(channelCount, 16); break;
+                        default: break;
+                        }
+                        if (Image::Type::None == out && packing.methodB)
+                        {
+                            // OpenGL only supports the padding in the least
+                            // significant bits.
+                            out = type;
+                        }
+                    }
+                    return out;
+                }
+
+                std::shared_ptr<Image::Image> unpack(const std::shared_ptr<Image::Image>& in, const Packing& packing, Image::Type type)
+                {
+                    const auto& inInfo = in->getInfo();
+                    auto info = inInfo;
+                    info.type = type;
+                    info.layout.endian = Memory::getEndian();
+                    auto out = Image::Image::create(info);
+
+                    const bool convertEndian = inInfo.layout.endian != Memory::getEndian();
+                    const uint8_t inChannels = Image::getChannelCount(inInfo.type);
+                    const uint8_t outChannels = Image::getChannelCount(type);
+                    const Image::DataType dataType = Image::getDataType(type);
+                    const size_t lutSize = static_cast<size_t>(1) << packing.bitDepth;
+                    const float lutMax = static_cast<float>(lutSize - 1);
+                    std::vector<Image::U8_T> lutU8;
+                    std::vector<Image::U16_T> lutU16;
+                    std::vector<Image::F16_T> lutF16;
+                    switch (dataType)
+                    {
+                    case Image::DataType::U8:
+                        lutU8.resize(lutSize);
+                        for (size_t i = 0; i < lutSize; ++i)
+                        {
+                            lutU8[i] = static_cast<Image::U8_T>(i >> (packing.bitDepth - 8));
+                        }
+                        break;
+                    case Image::DataType::U16:
+                        lutU16.resize(lutSize);
+                        for (size_t i = 0; i < lutSize; ++i)
+                        {
+                            lutU16[i] = static_cast<Image::U16_T>(i << (16 - packing.bitDepth));
+                        }
+                        break;
+                    case Image::DataType::F16:
+                        lutF16.resize(lutSize);
+                        for (size_t i = 0; i < lutSize; ++i)
+                        {
+                            lutF16[i] = i / lutMax;
+                        }
+                        break;
+                    default: break;
+                    }
+
+                    const Image::Image& inImage = *in;
+                    const size_t w = info.size.w;
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        const uint8_t* inP = inImage.getData(y);
+                        uint8_t* outP = out->getData(y);
+                        if (10 == packing.bitDepth && Image::Type::RGB_U10 == type)
+                        {
+                            repackU10(inP, w, convertEndian, packing.methodB, outP);
+                        }
+                        else if (10 == packing.bitDepth && Image::Type::RGBA_U8 == type)
+                        {
+                            unpackU10ToRGBA_U8(inP, w, convertEndian, packing.methodB, outP);
+                        }
+                        else if (12 == packing.bitDepth && Image::DataType::U16 == dataType && inChannels == outChannels)
+                        {
+                            unpackU12ToU16(inP, w * inChannels, convertEndian, packing.methodB, outP);
+                        }
+                        else
+                        {
+                            switch (dataType)
+                            {
+                            case Image::DataType::U8:
+                                unpackLUT(inP, w, packing, convertEndian, inChannels, outChannels, lutU8, reinterpret_cast<Image::U8_T*>(outP));
+                                break;
+                            case Image::DataType::U16:
+                                unpackLUT(inP, w, packing, convertEndian, inChannels, outChannels, lutU16, reinterpret_cast<Image::U16_T*>(outP));
+                                break;
+                            case Image::DataType::F16:
+                                unpackLUT(inP, w, packing, convertEndian, inChannels, outChannels, lutF16, reinterpret_cast<Image::F16_T*>(outP));
+                                break;
+                            default: break;
+                            }
+                        }
+                    }
+                    return out;
+                }
+
                 struct Read::Private
                 {
                     ColorProfile colorProfile = ColorProfile::FilmPrint;
@@ -58,72 +458,145 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo & fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
                 
                 std::shared_ptr<Image::Image> Read::readImage(
                     const Info& info,
-                    FileSystem::FileIO& io)
+                    const std::shared_ptr<FileSystem::FileIO>& io,
+                    const ReadOptions& options,
+                    const Packing& packing)
                 {
-#if defined(DJV_MMAP)
-                    auto out = Image::Image::create(info.video[0].info, io);
-#else // DJV_MMAP
-                    auto infoTmp = info;
-                    bool convertEndian = false;
-                    if (infoTmp.video[0].info.layout.endian != Memory::getEndian())
+                    std::shared_ptr<Image::Image> out;
+                    const auto& fileInfo = info.video[0].info;
+                    const bool fullRead = isFullRead(fileInfo.size, options);
+                    const Image::Type unpackType = getUnpackType(fileInfo.type, packing, options.unpackType);
+                    if (io->isMMap())
                     {
-                        convertEndian = true;
-                        infoTmp.video[0].info.layout.endian = Memory::getEndian();
+                        // Use the file data directly, the endian conversion is
+                        // done when the image is uploaded to OpenGL or when the
+                        // data is unpacked.
+                        if (fullRead)
+                        {
+                            io->mmapWillNeed(fileInfo.getDataByteCount());
+                            out = Image::Image::create(fileInfo, io);
+                        }
+                        else
+                        {
+                            // Only the pages with the pixels that are kept
+                            // are read from the file.
+                            out = Image::decimate(
+                                Image::Image::create(fileInfo, io),
+                                getReadRegion(fileInfo.size, options),
+                                getProxyScale(options.proxy));
+                        }
                     }
-                    auto out = Image::Image::create(infoTmp.video[0].info);
-                    io.read(out->getData(), io.getSize() - io.getPos());
-                    if (convertEndian)
+                    else
                     {
-                        const size_t dataByteCount = out->getDataByteCount();
-                        switch (Image::getDataType(infoTmp.video[0].info.type))
+                        auto imageInfo = fileInfo;
+                        bool convertEndian = false;
+                        if (imageInfo.layout.endian != Memory::getEndian() && Image::Type::None == unpackType)
                         {
-                            case Image::DataType::U10:
-                                Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                break;
-                            case Image::DataType::U16:
-                                Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                break;
-                            default: break;                            
+                            convertEndian = true;
+                            imageInfo.layout.endian = Memory::getEndian();
+                        }
+                        if (fullRead)
+                        {
+                            out = Image::Image::create(imageInfo);
+                            io->read(out->getData(), io->getSize() - io->getPos());
+                        }
+                        else
+                        {
+                            out = _readScanlines(*io, imageInfo, options);
+                        }
+                        if (convertEndian)
+                        {
+                            const size_t dataByteCount = out->getDataByteCount();
+                            switch (Image::getDataType(imageInfo.type))
+                            {
+                                case Image::DataType::U10:
+                                    Memory::endian(out->getData(), dataByteCount / 4, 4);
+                                    break;
+                                case Image::DataType::U16:
+                                    Memory::endian(out->getData(), dataByteCount / 2, 2);
+                                    break;
+                                default: break;                            
+                            }
                         }
                     }
-#endif // DJV_MMAP
-                    out->setTags(infoTmp.tags);
+                    if (unpackType != Image::Type::None)
+                    {
+                        out = unpack(out, packing, unpackType);
+                    }
+                    out->setTags(info.tags);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    Packing packing;
+                    return _open(fileName, io, packing);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     DJV_PRIVATE_PTR();
-                    FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
-                    auto out = readImage(info, io);
+                    auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                    io->setMMap(_options.mmap);
+                    Packing packing;
+                    const auto info = _open(fileName, *io, packing);
+                    auto out = readImage(info, io, _options, packing);
                     out->setPluginName(pluginName);
                     return out;
                 }
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io)
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
+                }
+
+                bool Read::_hasProxy() const
+                {
+                    return true;
+                }
+
+                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io, Packing & packing)
                 {
                     DJV_PRIVATE_PTR();
-                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    if (!_openReadAhead(fileName, io))
+                    {
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    }
+
+                    // The image information is only parsed if the header does
+                    // not match the template from an earlier file.
+                    const auto header = readHeader(io);
+                    const auto key = getTemplateKey(io, header);
                     Info info;
-                    info.video.resize(1);
-                    read(io, info, p.colorProfile);
+                    if (_getHeaderTemplate(key, info))
+                    {
+                        info.fileName = io.getFileName();
+                    }
+                    else
+                    {
+                        info.video.resize(1);
+                        parseInfo(io, header, info, p.colorProfile);
+                        _addHeaderTemplate(key, info);
+                    }
+                    parseTags(header, info);
+                    packing = getPacking(header);
+                    if (header.file.imageOffset)
+                    {
+                        io.setPos(header.file.imageOffset);
+                    }
                     info.video[0].sequence = _sequence;
                     return info;
                 }
@@ -30,6 +30,18 @@
 #include <djvAV/Cineon.h>
 
 #include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#if defined(DJV_PLATFORM_LINUX) || defined(DJV_PLATFORM_OSX)
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif // DJV_PLATFORM_LINUX
 
 using namespace djv::Core;
 
@@ -41,6 +53,238 @@ namespace djv
         {
             namespace Cineon
             {
+                namespace
+                {
+                    //! The size of the buffer that the scanlines are packed into.
+                    const size_t bufferByteCount = 4 * Memory::megabyte;
+
+                    //! The minimum image data size for direct I/O.
+                    const size_t directIOMinByteCount = 8 * Memory::megabyte;
+
+                    //! The alignment of the buffer, file positions and sizes
+                    //! for direct I/O.
+                    const size_t directIOAlignment = 4096;
+
+                    inline uint32_t swap32(uint32_t value)
+                    {
+                        return (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+                    }
+
+                    inline uint32_t toU10(uint8_t value, bool)
+                    {
+                        // Replicate the high bits so that 255 maps to 1023.
+                        return (static_cast<uint32_t>(value) << 2) | (value >> 6);
+                    }
+
+                    inline uint32_t toU10(uint16_t value, bool convertEndian)
+                    {
+                        if (convertEndian)
+                        {
+                            value = static_cast<uint16_t>((value >> 8) | (value << 8));
+                        }
+                        return static_cast<uint32_t>(value) >> 6;
+                    }
+
+                    template<typename T>
+                    void packScanline(const uint8_t* in, const Image::Info& info, bool convertEndian, uint8_t* out)
+                    {
+                        const size_t w = info.size.w;
+                        const uint8_t channelCount = Image::getChannelCount(info.type);
+                        const bool inConvertEndian = info.layout.endian != Memory::getEndian();
+                        const T* inP = reinterpret_cast<const T*>(in);
+                        for (size_t x = 0; x < w; ++x, out += 4)
+                        {
+                            const T* p = inP + (info.layout.mirror.x ? (w - 1 - x) : x) * channelCount;
+                            uint32_t value =
+                                (toU10(p[0], inConvertEndian) << 22) |
+                                (toU10(p[1], inConvertEndian) << 12) |
+                                (toU10(p[2], inConvertEndian) << 2);
+                            if (convertEndian)
+                            {
+                                value = swap32(value);
+                            }
+                            memcpy(out, &value, 4);
+                        }
+                    }
+
+                    //! Get a scanline of an image, from the top of the image.
+                    const uint8_t* getScanline(const Image::Image& image, uint16_t y)
+                    {
+                        const auto& info = image.getInfo();
+                        return image.getData(info.layout.mirror.y ? (info.size.h - 1 - y) : y);
+                    }
+
+                } // namespace
+
+                Image::Type getWriteType(Image::Type value)
+                {
+                    Image::Type out = Image::Type::RGB_U10;
+                    switch (value)
+                    {
+                    case Image::Type::RGB_U8:
+                    case Image::Type::RGBA_U8:
+                    case Image::Type::RGB_U16:
+                    case Image::Type::RGBA_U16: out = value; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                void packScanline(const uint8_t* in, const Image::Info& info, Memory::Endian endian, uint8_t* out)
+                {
+                    const bool convertEndian = endian != Memory::getEndian();
+                    switch (info.type)
+                    {
+                    case Image::Type::RGB_U10:
+                    {
+                        const size_t w = info.size.w;
+                        const bool swap = info.layout.endian != endian;
+                        if (!info.layout.mirror.x)
+                        {
+                            if (swap)
+                            {
+                                Memory::endian(in, out, w, 4);
+                            }
+                            else
+                            {
+                                memcpy(out, in, w * 4);
+                            }
+                        }
+                        else
+                        {
+                            for (size_t x = 0; x < w; ++x, out += 4)
+                            {
+                                uint32_t value = 0;
+                                memcpy(&value, in + (w - 1 - x) * 4, 4);
+                                if (swap)
+                                {
+                                    value = swap32(value);
+                                }
+                                memcpy(out, &value, 4);
+                            }
+                        }
+                        break;
+                    }
+                    case Image::Type::RGB_U8:
+                    case Image::Type::RGBA_U8:
+                        packScanline<uint8_t>(in, info, convertEndian, out);
+                        break;
+                    case Image::Type::RGB_U16:
+                    case Image::Type::RGBA_U16:
+                        packScanline<uint16_t>(in, info, convertEndian, out);
+                        break;
+                    default: break;
+                    }
+                }
+
+#if defined(DJV_PLATFORM_LINUX) || defined(DJV_PLATFORM_OSX)
+                bool writeImageDirect(FileSystem::FileIO& io, const Image::Image& image, Memory::Endian endian)
+                {
+#if defined(DJV_PLATFORM_LINUX)
+                    const int f = ::open(io.getFileName().c_str(), O_RDWR | O_DIRECT);
+#else // DJV_PLATFORM_LINUX
+                    const int f = ::open(io.getFileName().c_str(), O_RDWR);
+                    if (f != -1)
+                    {
+                        fcntl(f, F_NOCACHE, 1);
+                    }
+#endif // DJV_PLATFORM_LINUX
+                    if (-1 == f)
+                    {
+                        return false;
+                    }
+                    struct File
+                    {
+                        ~File()
+                        {
+                            ::close(f);
+                        }
+
+                        int f;
+                    };
+                    const File file = { f };
+
+                    const auto& info = image.getInfo();
+                    const size_t scanlineByteCount = static_cast<size_t>(info.size.w) * 4;
+                    void* p = nullptr;
+                    if (posix_memalign(&p, directIOAlignment, bufferByteCount + scanlineByteCount + directIOAlignment) != 0)
+                    {
+                        return false;
+                    }
+                    std::unique_ptr<uint8_t, void(*)(void*)> buf(reinterpret_cast<uint8_t*>(p), free);
+
+                    const size_t pos = io.getPos();
+                    size_t filePos = pos / directIOAlignment * directIOAlignment;
+                    size_t size = pos - filePos;
+                    if (size && pread(f, buf.get(), directIOAlignment, filePos) != static_cast<ssize_t>(size))
+                    {
+                        return false;
+                    }
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        packScanline(getScanline(image, y), info, endian, buf.get() + size);
+                        size += scanlineByteCount;
+                        if (size >= bufferByteCount)
+                        {
+                            if (pwrite(f, buf.get(), bufferByteCount, filePos) != static_cast<ssize_t>(bufferByteCount))
+                            {
+                                throw FileSystem::Error(DJV_TEXT("Error writing file."));
+                            }
+                            filePos += bufferByteCount;
+                            size -= bufferByteCount;
+                            memmove(buf.get(), buf.get() + bufferByteCount, size);
+                        }
+                    }
+                    if (size)
+                    {
+                        // Pad the last block and then truncate the file.
+                        const size_t alignedSize = (size + directIOAlignment - 1) / directIOAlignment * directIOAlignment;
+                        memset(buf.get() + size, 0, alignedSize - size);
+                        if (pwrite(f, buf.get(), alignedSize, filePos) != static_cast<ssize_t>(alignedSize))
+                        {
+                            throw FileSystem::Error(DJV_TEXT("Error writing file."));
+                        }
+                    }
+                    const size_t end = pos + scanlineByteCount * info.size.h;
+                    if (ftruncate(f, static_cast<off_t>(end)) != 0)
+                    {
+                        throw FileSystem::Error(DJV_TEXT("Error writing file."));
+                    }
+                    io.setPos(end);
+                    return true;
+                }
+#else // DJV_PLATFORM_LINUX
+                bool writeImageDirect(FileSystem::FileIO&, const Image::Image&, Memory::Endian)
+                {
+                    return false;
+                }
+#endif // DJV_PLATFORM_LINUX
+
+                void writeImage(FileSystem::FileIO& io, const Image::Image& image, Memory::Endian endian, bool directIO)
+                {
+                    const auto& info = image.getInfo();
+                    const size_t scanlineByteCount = static_cast<size_t>(info.size.w) * 4;
+                    const size_t dataByteCount = scanlineByteCount * info.size.h;
+                    io.preallocate(io.getPos() + dataByteCount);
+                    if (directIO && dataByteCount >= directIOMinByteCount && writeImageDirect(io, image, endian))
+                    {
+                        return;
+                    }
+                    const uint16_t bufferScanlines = static_cast<uint16_t>(std::max(
+                        std::min(bufferByteCount / std::max(scanlineByteCount, size_t(1)), static_cast<size_t>(info.size.h)),
+                        size_t(1)));
+                    std::vector<uint8_t> buf(bufferScanlines * scanlineByteCount);
+                    for (uint16_t y = 0; y < info.size.h; y += bufferScanlines)
+                    {
+                        const uint16_t scanlines = std::min(bufferScanlines, static_cast<uint16_t>(info.size.h - y));
+                        for (uint16_t i = 0; i < scanlines; ++i)
+                        {
+                            packScanline(getScanline(image, y + i), info, endian, buf.data() + i * scanlineByteCount);
+                        }
+                        io.write(buf.data(), scanlines * scanlineByteCount);
+                    }
+                }
+
                 struct Write::Private
                 {};
 
@@ -65,9 +309,9 @@ namespace djv
                     return out;
                 }
 
-                Image::Type Write::_getImageType(Image::Type) const
+                Image::Type Write::_getImageType(Image::Type value) const
                 {
-                    return Image::Type::RGB_U10;
+                    return getWriteType(value);
                 }
 
                 Image::Layout Write::_getImageLayout() const
@@ -77,6 +321,11 @@ namespace djv
                     out.alignment = 4;
                     return out;
                 }
+
+                bool Write::_hasImageLayoutConversion() const
+                {
+                    return true;
+                }
                 
                 void Write::_write(const std::string & fileName, const std::shared_ptr<Image::Image> & image)
                 {
@@ -85,9 +334,10 @@ namespace djv
                     io.open(fileName, FileSystem::FileIO::Mode::Write);
                     Info info;
                     info.video.push_back(image->getInfo());
+                    info.video[0].info.type = Image::Type::RGB_U10;
                     info.tags = image->getTags();
                     write(io, info, _options.colorSpace.empty() ? ColorProfile::Raw : ColorProfile::FilmPrint);
-                    io.write(image->getData(), image->getDataByteCount());
+                    writeImage(io, *image, Memory::Endian::MSB, _options.directIO);
                     writeFinish(io);
                 }
 
@@ -169,13 +169,11 @@ namespace djv
 
                 } // namespace
 
-                Header read(FileSystem::FileIO& io, Info& info, Cineon::ColorProfile& colorProfile)
+                Header readHeader(FileSystem::FileIO& io)
                 {
                     Header out;
                     zero(out);
 
-                    info.fileName = io.getFileName();
-
                     // Read the file section of the header.
                     io.read(&out.file, sizeof(Header::File));
 
@@ -196,31 +194,54 @@ namespace djv
                         throw FileSystem::Error(ss.str());
                     }
 
-                    // Read the reset of the header.
-                    io.read(&out.image, sizeof(Header::Image));
-                    io.read(&out.source, sizeof(Header::Source));
-                    io.read(&out.film, sizeof(Header::Film));
-                    io.read(&out.tv, sizeof(Header::TV));
+                    // Read the rest of the header with a single read.
+                    const size_t imageByteCount = sizeof(Header::Image);
+                    const size_t sourceByteCount = sizeof(Header::Source);
+                    const size_t filmByteCount = sizeof(Header::Film);
+                    const size_t tvByteCount = sizeof(Header::TV);
+                    uint8_t buf[imageByteCount + sourceByteCount + filmByteCount + tvByteCount];
+                    io.read(buf, sizeof(buf));
+                    const uint8_t* p = buf;
+                    memcpy(&out.image, p, imageByteCount);
+                    p += imageByteCount;
+                    memcpy(&out.source, p, sourceByteCount);
+                    p += sourceByteCount;
+                    memcpy(&out.film, p, filmByteCount);
+                    p += filmByteCount;
+                    memcpy(&out.tv, p, tvByteCount);
 
                     // Flip the endian of the data if necessary.
                     if (fileEndian != Memory::getEndian())
                     {
                         io.setEndianConversion(true);
                         convertEndian(out);
+                    }
+
+                    return out;
+                }
+
+                void parseInfo(const FileSystem::FileIO& io, const Header& header, Info& info, Cineon::ColorProfile& colorProfile)
+                {
+                    info.fileName = io.getFileName();
+                    const Memory::Endian fileEndian = 0 == memcmp(&header.file.magic, magic[0], 4) ?
+                        Memory::Endian::MSB :
+                        Memory::Endian::LSB;
+                    if (fileEndian != Memory::getEndian())
+                    {
                         info.video[0].info.layout.endian = Memory::opposite(Memory::getEndian());
                     }
 
                     // Collect information.
-                    if (out.image.elemSize != 1)
+                    if (header.image.elemSize != 1)
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Unsupported file.");
                         throw FileSystem::Error(ss.str());
                     }
-                    info.video[0].info.size.w = out.image.size[0];
-                    info.video[0].info.size.h = out.image.size[1];
+                    info.video[0].info.size.w = header.image.size[0];
+                    info.video[0].info.size.h = header.image.size[1];
 
-                    switch (static_cast<Orient>(out.image.orient))
+                    switch (static_cast<Orient>(header.image.orient))
                     {
                     case Orient::LeftRightBottomTop:
                         info.video[0].info.layout.mirror.y = true;
@@ -236,42 +257,58 @@ namespace djv
                     }
 
                     info.video[0].info.type = Image::Type::None;
-                    switch (static_cast<Components>(out.image.elem[0].packing))
+                    switch (static_cast<Components>(header.image.elem[0].packing))
                     {
                     case Components::Pack:
                     {
                         uint8_t channels = 0;
-                        switch (static_cast<Descriptor>(out.image.elem[0].descriptor))
+                        switch (static_cast<Descriptor>(header.image.elem[0].descriptor))
                         {
                         case Descriptor::L:    channels = 1; break;
                         case Descriptor::RGB:  channels = 3; break;
                         case Descriptor::RGBA: channels = 4; break;
                         default: break;
                         }
-                        info.video[0].info.type = Image::getIntType(channels, out.image.elem[0].bitDepth);
+                        info.video[0].info.type = Image::getIntType(channels, header.image.elem[0].bitDepth);
                     }
                     break;
                     case Components::TypeA:
-                        switch (out.image.elem[0].bitDepth)
+                    case Components::TypeB:
+                        switch (header.image.elem[0].bitDepth)
                         {
                         case 10:
-                            if (Descriptor::RGB == static_cast<Descriptor>(out.image.elem[0].descriptor))
+                            if (Descriptor::RGB == static_cast<Descriptor>(header.image.elem[0].descriptor))
                             {
                                 info.video[0].info.type = Image::Type::RGB_U10;
                                 info.video[0].info.layout.alignment = 4;
                             }
                             break;
+                        case 12:
+                        {
+                            // The 12-bit samples are stored in 16-bit words and
+                            // unpacked when the image is read, see getPacking().
+                            uint8_t channels = 0;
+                            switch (static_cast<Descriptor>(header.image.elem[0].descriptor))
+                            {
+                            case Descriptor::L:    channels = 1; break;
+                            case Descriptor::RGB:  channels = 3; break;
+                            case Descriptor::RGBA: channels = 4; break;
+                            default: break;
+                            }
+                            info.video[0].info.type = Image::getIntType(channels, 16);
+                            break;
+                        }
                         case 16:
                         {
                             uint8_t channels = 0;
-                            switch (static_cast<Descriptor>(out.image.elem[0].descriptor))
+                            switch (static_cast<Descriptor>(header.image.elem[0].descriptor))
                             {
                             case Descriptor::L:    channels = 1; break;
                             case Descriptor::RGB:  channels = 3; break;
                             case Descriptor::RGBA: channels = 4; break;
                             default: break;
                             }
-                            info.video[0].info.type = Image::getIntType(channels, out.image.elem[0].bitDepth);
+                            info.video[0].info.type = Image::getIntType(channels, header.image.elem[0].bitDepth);
                             break;
                         }
                         default: break;
@@ -285,238 +322,294 @@ namespace djv
                         ss << DJV_TEXT("Unsupported file.");
                         throw FileSystem::Error(ss.str());
                     }
-                    if (io.getSize() - out.file.imageOffset != info.video[0].info.getDataByteCount())
+                    if (io.getSize() - header.file.imageOffset != info.video[0].info.getDataByteCount())
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Incomplete file.");
                         throw FileSystem::Error(ss.str());
                     }
 
-                    if (out.image.elem[0].encoding)
+                    if (header.image.elem[0].encoding)
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Unsupported file.");
                         throw FileSystem::Error(ss.str());
                     }
 
-                    if (isValid(&out.image.elem[0].linePadding) && out.image.elem[0].linePadding)
+                    if (isValid(&header.image.elem[0].linePadding) && header.image.elem[0].linePadding)
                     {
                         std::stringstream ss;
                         ss << DJV_TEXT("Unsupported file.");
                         throw FileSystem::Error(ss.str());
                     }
 
-                    if (Transfer::FilmPrint == static_cast<Transfer>(out.image.elem[0].transfer))
+                    if (Transfer::FilmPrint == static_cast<Transfer>(header.image.elem[0].transfer))
                     {
                         colorProfile = Cineon::ColorProfile::FilmPrint;
                     }
 
-                    if (Cineon::isValid(out.file.time, 24))
+                }
+
+                Cineon::Packing getPacking(const Header& header)
+                {
+                    Cineon::Packing out;
+                    const uint8_t bitDepth = header.image.elem[0].bitDepth;
+                    switch (static_cast<Components>(header.image.elem[0].packing))
+                    {
+                    case Components::TypeA:
+                    case Components::TypeB:
+                        if (10 == bitDepth || 12 == bitDepth)
+                        {
+                            out.bitDepth = bitDepth;
+                            out.methodB = Components::TypeB == static_cast<Components>(header.image.elem[0].packing);
+                        }
+                        break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                void parseTags(const Header& header, Info& info)
+                {
+                    if (Cineon::isValid(header.file.time, 24))
                     {
-                        info.tags.setTag("Time", Cineon::toString(out.file.time, 24));
+                        info.tags.setTag("Time", Cineon::toString(header.file.time, 24));
                     }
-                    if (Cineon::isValid(out.file.creator, 100))
+                    if (Cineon::isValid(header.file.creator, 100))
                     {
-                        info.tags.setTag("Creator", Cineon::toString(out.file.creator, 100));
+                        info.tags.setTag("Creator", Cineon::toString(header.file.creator, 100));
                     }
-                    if (Cineon::isValid(out.file.project, 200))
+                    if (Cineon::isValid(header.file.project, 200))
                     {
-                        info.tags.setTag("Project", Cineon::toString(out.file.project, 200));
+                        info.tags.setTag("Project", Cineon::toString(header.file.project, 200));
                     }
-                    if (Cineon::isValid(out.file.copyright, 200))
+                    if (Cineon::isValid(header.file.copyright, 200))
                     {
-                        info.tags.setTag("Copyright", Cineon::toString(out.file.copyright, 200));
+                        info.tags.setTag("Copyright", Cineon::toString(header.file.copyright, 200));
                     }
 
-                    if (isValid(&out.source.offset[0]) && isValid(&out.source.offset[1]))
+                    if (isValid(&header.source.offset[0]) && isValid(&header.source.offset[1]))
                     {
                         std::stringstream ss;
-                        ss << out.source.offset[0] << " " << out.source.offset[1];
+                        ss << header.source.offset[0] << " " << header.source.offset[1];
                         info.tags.setTag("Source Offset", ss.str());
                     }
-                    if (isValid(&out.source.center[0]) && isValid(&out.source.center[1]))
+                    if (isValid(&header.source.center[0]) && isValid(&header.source.center[1]))
                     {
                         std::stringstream ss;
-                        ss << out.source.center[0] << " " << out.source.center[1];
+                        ss << header.source.center[0] << " " << header.source.center[1];
                         info.tags.setTag("Source Center", ss.str());
                     }
-                    if (isValid(&out.source.size[0]) && isValid(&out.source.size[1]))
+                    if (isValid(&header.source.size[0]) && isValid(&header.source.size[1]))
                     {
                         std::stringstream ss;
-                        ss << out.source.size[0] << " " << out.source.size[1];
+                        ss << header.source.size[0] << " " << header.source.size[1];
                         info.tags.setTag("Source Size", ss.str());
                     }
-                    if (Cineon::isValid(out.source.file, 100))
+                    if (Cineon::isValid(header.source.file, 100))
                     {
-                        info.tags.setTag("Source File", Cineon::toString(out.source.file, 100));
+                        info.tags.setTag("Source File", Cineon::toString(header.source.file, 100));
                     }
-                    if (Cineon::isValid(out.source.time, 24))
+                    if (Cineon::isValid(header.source.time, 24))
                     {
-                        info.tags.setTag("Source Time", Cineon::toString(out.source.time, 24));
+                        info.tags.setTag("Source Time", Cineon::toString(header.source.time, 24));
                     }
-                    if (Cineon::isValid(out.source.inputDevice, 32))
+                    if (Cineon::isValid(header.source.inputDevice, 32))
                     {
-                        info.tags.setTag("Source Input Device", Cineon::toString(out.source.inputDevice, 32));
+                        info.tags.setTag("Source Input Device", Cineon::toString(header.source.inputDevice, 32));
                     }
-                    if (Cineon::isValid(out.source.inputSerial, 32))
+                    if (Cineon::isValid(header.source.inputSerial, 32))
                     {
-                        info.tags.setTag("Source Input Serial", Cineon::toString(out.source.inputSerial, 32));
+                        info.tags.setTag("Source Input Serial", Cineon::toString(header.source.inputSerial, 32));
                     }
-                    if (isValid(&out.source.border[0]) && isValid(&out.source.border[1]) &&
-                        isValid(&out.source.border[2]) && isValid(&out.source.border[3]))
+                    if (isValid(&header.source.border[0]) && isValid(&header.source.border[1]) &&
+                        isValid(&header.source.border[2]) && isValid(&header.source.border[3]))
                     {
                         std::stringstream ss;
-                        ss << out.source.border[0] << " ";
-                        ss << out.source.border[1] << " ";
-                        ss << out.source.border[2] << " ";
-                        ss << out.source.border[3];
+                        ss << header.source.border[0] << " ";
+                        ss << header.source.border[1] << " ";
+                        ss << header.source.border[2] << " ";
+                        ss << header.source.border[3];
                         info.tags.setTag("Source Border", ss.str());
                     }
-                    if (isValid(&out.source.pixelAspect[0]) && isValid(&out.source.pixelAspect[1]))
+                    if (isValid(&header.source.pixelAspect[0]) && isValid(&header.source.pixelAspect[1]))
                     {
                         std::stringstream ss;
-                        ss << out.source.pixelAspect[0] << " " << out.source.pixelAspect[1];
+                        ss << header.source.pixelAspect[0] << " " << header.source.pixelAspect[1];
                         info.tags.setTag("Source Pixel Aspect", ss.str());
                     }
-                    if (isValid(&out.source.scanSize[0]) && isValid(&out.source.scanSize[1]))
+                    if (isValid(&header.source.scanSize[0]) && isValid(&header.source.scanSize[1]))
                     {
                         std::stringstream ss;
-                        ss << out.source.scanSize[0] << " " << out.source.scanSize[1];
+                        ss << header.source.scanSize[0] << " " << header.source.scanSize[1];
                         info.tags.setTag("Source Scan Size", ss.str());
                     }
 
-                    if (Cineon::isValid(out.film.id, 2) && Cineon::isValid(out.film.type, 2) &&
-                        Cineon::isValid(out.film.offset, 2) && Cineon::isValid(out.film.prefix, 6) &&
-                        Cineon::isValid(out.film.count, 4))
+                    if (Cineon::isValid(header.film.id, 2) && Cineon::isValid(header.film.type, 2) &&
+                        Cineon::isValid(header.film.offset, 2) && Cineon::isValid(header.film.prefix, 6) &&
+                        Cineon::isValid(header.film.count, 4))
                     {
                         info.tags.setTag("Keycode", Time::keycodeToString(
-                            std::stoi(std::string(out.film.id, 2)),
-                            std::stoi(std::string(out.film.type, 2)),
-                            std::stoi(std::string(out.film.prefix, 6)),
-                            std::stoi(std::string(out.film.count, 4)),
-                            std::stoi(std::string(out.film.offset, 2))));
+                            std::stoi(std::string(header.film.id, 2)),
+                            std::stoi(std::string(header.film.type, 2)),
+                            std::stoi(std::string(header.film.prefix, 6)),
+                            std::stoi(std::string(header.film.count, 4)),
+                            std::stoi(std::string(header.film.offset, 2))));
                     }
-                    if (Cineon::isValid(out.film.format, 32))
+                    if (Cineon::isValid(header.film.format, 32))
                     {
-                        info.tags.setTag("Film Format", std::string(out.film.format, 32));
+                        info.tags.setTag("Film Format", std::string(header.film.format, 32));
                     }
-                    if (isValid(&out.film.frame))
+                    if (isValid(&header.film.frame))
                     {
                         std::stringstream ss;
-                        ss << out.film.frame;
+                        ss << header.film.frame;
                         info.tags.setTag("Film Frame", ss.str());
                     }
-                    if (isValid(&out.film.sequence))
+                    if (isValid(&header.film.sequence))
                     {
                         std::stringstream ss;
-                        ss << out.film.sequence;
+                        ss << header.film.sequence;
                         info.tags.setTag("Film Sequence", ss.str());
                     }
-                    if (isValid(&out.film.hold))
+                    if (isValid(&header.film.hold))
                     {
                         std::stringstream ss;
-                        ss << out.film.hold;
+                        ss << header.film.hold;
                         info.tags.setTag("Film Hold", ss.str());
                     }
-                    if (isValid(&out.film.frameRate) && out.film.frameRate > _minSpeed)
+                    if (isValid(&header.film.frameRate) && header.film.frameRate > _minSpeed)
                     {
-                        info.video[0].speed = Time::Speed(out.film.frameRate);
+                        info.video[0].speed = Time::Speed(header.film.frameRate);
                         std::stringstream ss;
-                        ss << out.film.frameRate;
+                        ss << header.film.frameRate;
                         info.tags.setTag("Film Frame Rate", ss.str());
                     }
-                    if (isValid(&out.film.shutter))
+                    if (isValid(&header.film.shutter))
                     {
                         std::stringstream ss;
-                        ss << out.film.shutter;
+                        ss << header.film.shutter;
                         info.tags.setTag("Film Shutter", ss.str());
                     }
-                    if (Cineon::isValid(out.film.frameId, 32))
+                    if (Cineon::isValid(header.film.frameId, 32))
                     {
-                        info.tags.setTag("Film Frame ID", std::string(out.film.frameId, 32));
+                        info.tags.setTag("Film Frame ID", std::string(header.film.frameId, 32));
                     }
-                    if (Cineon::isValid(out.film.slate, 100))
+                    if (Cineon::isValid(header.film.slate, 100))
                     {
-                        info.tags.setTag("Film Slate", std::string(out.film.slate, 100));
+                        info.tags.setTag("Film Slate", std::string(header.film.slate, 100));
                     }
 
-                    if (isValid(&out.tv.timecode))
+                    if (isValid(&header.tv.timecode))
                     {
-                        info.tags.setTag("Timecode", Time::timecodeToString(out.tv.timecode));
+                        info.tags.setTag("Timecode", Time::timecodeToString(header.tv.timecode));
                     }
-                    if (isValid(&out.tv.interlace))
+                    if (isValid(&header.tv.interlace))
                     {
                         std::stringstream ss;
-                        ss << static_cast<unsigned int>(out.tv.interlace);
+                        ss << static_cast<unsigned int>(header.tv.interlace);
                         info.tags.setTag("TV Interlace", ss.str());
                     }
-                    if (isValid(&out.tv.field))
+                    if (isValid(&header.tv.field))
                     {
                         std::stringstream ss;
-                        ss << static_cast<unsigned int>(out.tv.field);
+                        ss << static_cast<unsigned int>(header.tv.field);
                         info.tags.setTag("TV Field", ss.str());
                     }
-                    if (isValid(&out.tv.videoSignal))
+                    if (isValid(&header.tv.videoSignal))
                     {
                         std::stringstream ss;
-                        ss << static_cast<unsigned int>(out.tv.videoSignal);
+                        ss << static_cast<unsigned int>(header.tv.videoSignal);
                         info.tags.setTag("TV Video Signal", ss.str());
                     }
-                    if (isValid(&out.tv.sampleRate[0]) && isValid(&out.tv.sampleRate[1]))
+                    if (isValid(&header.tv.sampleRate[0]) && isValid(&header.tv.sampleRate[1]))
                     {
                         std::stringstream ss;
-                        ss << out.tv.sampleRate[0] << " " << out.tv.sampleRate[1];
+                        ss << header.tv.sampleRate[0] << " " << header.tv.sampleRate[1];
                         info.tags.setTag("TV Sample Rate", ss.str());
                     }
-                    if (isValid(&out.tv.frameRate) && out.tv.frameRate > _minSpeed)
+                    if (isValid(&header.tv.frameRate) && header.tv.frameRate > _minSpeed)
                     {
-                        info.video[0].speed = Time::Speed(out.tv.frameRate);
+                        info.video[0].speed = Time::Speed(header.tv.frameRate);
                         std::stringstream ss;
-                        ss << out.tv.frameRate;
+                        ss << header.tv.frameRate;
                         info.tags.setTag("TV Frame Rate", ss.str());
                     }
-                    if (isValid(&out.tv.timeOffset))
+                    if (isValid(&header.tv.timeOffset))
                     {
                         std::stringstream ss;
-                        ss << out.tv.timeOffset;
+                        ss << header.tv.timeOffset;
                         info.tags.setTag("TV Time Offset", ss.str());
                     }
-                    if (isValid(&out.tv.gamma))
+                    if (isValid(&header.tv.gamma))
                     {
                         std::stringstream ss;
-                        ss << out.tv.gamma;
+                        ss << header.tv.gamma;
                         info.tags.setTag("TV Gamma", ss.str());
                     }
-                    if (isValid(&out.tv.blackLevel))
+                    if (isValid(&header.tv.blackLevel))
                     {
                         std::stringstream ss;
-                        ss << out.tv.blackLevel;
+                        ss << header.tv.blackLevel;
                         info.tags.setTag("TV Black Level", ss.str());
                     }
-                    if (isValid(&out.tv.blackGain))
+                    if (isValid(&header.tv.blackGain))
                     {
                         std::stringstream ss;
-                        ss << out.tv.blackGain;
+                        ss << header.tv.blackGain;
                         info.tags.setTag("TV Black Gain", ss.str());
                     }
-                    if (isValid(&out.tv.breakpoint))
+                    if (isValid(&header.tv.breakpoint))
                     {
                         std::stringstream ss;
-                        ss << out.tv.breakpoint;
+                        ss << header.tv.breakpoint;
                         info.tags.setTag("TV Breakpoint", ss.str());
                     }
-                    if (isValid(&out.tv.whiteLevel))
+                    if (isValid(&header.tv.whiteLevel))
                     {
                         std::stringstream ss;
-                        ss << out.tv.whiteLevel;
+                        ss << header.tv.whiteLevel;
                         info.tags.setTag("TV White Level", ss.str());
                     }
-                    if (isValid(&out.tv.integrationTimes))
+                    if (isValid(&header.tv.integrationTimes))
                     {
                         std::stringstream ss;
-                        ss << out.tv.integrationTimes;
+                        ss << header.tv.integrationTimes;
                         info.tags.setTag("TV Integration Times", ss.str());
                     }
+                }
+
+                std::vector<uint8_t> getTemplateKey(const FileSystem::FileIO& io, const Header& header)
+                {
+                    // The fields that determine how the image data is read.
+                    const uint64_t fileSize = io.getSize();
+                    const Header::Image::Elem& elem = header.image.elem[0];
+                    std::vector<uint8_t> out;
+                    auto append = [&out](const void* data, size_t size)
+                    {
+                        const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+                        out.insert(out.end(), p, p + size);
+                    };
+                    append(&fileSize, sizeof(fileSize));
+                    append(&header.file.magic, sizeof(header.file.magic));
+                    append(&header.file.imageOffset, sizeof(header.file.imageOffset));
+                    append(&header.image.orient, sizeof(header.image.orient));
+                    append(&header.image.elemSize, sizeof(header.image.elemSize));
+                    append(header.image.size, sizeof(header.image.size));
+                    append(&elem.descriptor, sizeof(elem.descriptor));
+                    append(&elem.transfer, sizeof(elem.transfer));
+                    append(&elem.bitDepth, sizeof(elem.bitDepth));
+                    append(&elem.packing, sizeof(elem.packing));
+                    append(&elem.encoding, sizeof(elem.encoding));
+                    append(&elem.linePadding, sizeof(elem.linePadding));
+                    return out;
+                }
+
+                Header read(FileSystem::FileIO& io, Info& info, Cineon::ColorProfile& colorProfile)
+                {
+                    const Header out = readHeader(io);
+                    parseInfo(io, out, info, colorProfile);
+                    parseTags(out, info);
 
                     // Set the file position.
                     if (out.file.imageOffset)
@@ -891,7 +984,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _p->options, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _cacheManager, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
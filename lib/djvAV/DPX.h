@@ -289,6 +289,29 @@ namespace djv
                 //! Zero out the data in a DPX file header.
                 void zero(Header&);
 
+                //! Read a DPX file header without parsing it. The header is
+                //! converted to the native endian.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                Header readHeader(Core::FileSystem::FileIO&);
+
+                //! Parse the image information from a DPX file header.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                void parseInfo(const Core::FileSystem::FileIO&, const Header&, Info&, Cineon::ColorProfile&);
+
+                //! Get how the samples are packed from a DPX file header.
+                Cineon::Packing getPacking(const Header&);
+
+                //! Parse the tags from a DPX file header.
+                void parseTags(const Header&, Info&);
+
+                //! Get the header template key for a DPX file, see
+                //! ISequenceRead.
+                std::vector<uint8_t> getTemplateKey(const Core::FileSystem::FileIO&, const Header&);
+
                 //! Read a DPX file header.
                 //!
                 //! Throws:
@@ -326,15 +349,19 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string &) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
+                    bool _hasReadAhead() const override;
+                    bool _hasProxy() const override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO &);
+                    Info _open(const std::string &, Core::FileSystem::FileIO &, Cineon::Packing &);
 
                     DJV_PRIVATE();
                 };
@@ -361,6 +388,7 @@ namespace djv
                 protected:
                     Image::Type _getImageType(Image::Type) const override;
                     Image::Layout _getImageLayout() const override;
+                    bool _hasImageLayoutConversion() const override;
                     void _write(const std::string & fileName, const std::shared_ptr<Image::Image> &) override;
 
                 private:
@@ -60,38 +60,75 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    Cineon::Packing packing;
+                    return _open(fileName, io, packing);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     DJV_PRIVATE_PTR();
-                    FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
-                    auto out = Cineon::Read::readImage(info, io);
+                    auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                    io->setMMap(_options.mmap);
+                    Cineon::Packing packing;
+                    const auto info = _open(fileName, *io, packing);
+                    auto out = Cineon::Read::readImage(info, io, _options, packing);
                     out->setPluginName(pluginName);
                     return out;
                 }
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io)
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
+                }
+
+                bool Read::_hasProxy() const
+                {
+                    return true;
+                }
+
+                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io, Cineon::Packing & packing)
                 {
                     DJV_PRIVATE_PTR();
-                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    if (!_openReadAhead(fileName, io))
+                    {
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    }
+
+                    // The image information is only parsed if the header does
+                    // not match the template from an earlier file.
+                    const auto header = DPX::readHeader(io);
+                    const auto key = DPX::getTemplateKey(io, header);
                     Info info;
-                    info.video.resize(1);
-                    DPX::read(io, info, p.colorProfile);
+                    if (_getHeaderTemplate(key, info))
+                    {
+                        info.fileName = io.getFileName();
+                    }
+                    else
+                    {
+                        info.video.resize(1);
+                        DPX::parseInfo(io, header, info, p.colorProfile);
+                        _addHeaderTemplate(key, info);
+                    }
+                    DPX::parseTags(header, info);
+                    packing = DPX::getPacking(header);
+                    if (header.file.imageOffset)
+                    {
+                        io.setPos(header.file.imageOffset);
+                    }
                     info.video[0].sequence = _sequence;
                     return info;
                 }
@@ -30,6 +30,7 @@
 #include <djvAV/DPX.h>
 
 #include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
 
 using namespace djv::Core;
 
@@ -69,9 +70,9 @@ namespace djv
                     return out;
                 }
 
-                Image::Type Write::_getImageType(Image::Type) const
+                Image::Type Write::_getImageType(Image::Type value) const
                 {
-                    return Image::Type::RGB_U10;
+                    return Cineon::getWriteType(value);
                 }
 
                 Image::Layout Write::_getImageLayout() const
@@ -81,6 +82,11 @@ namespace djv
                     out.alignment = 4;
                     return out;
                 }
+
+                bool Write::_hasImageLayoutConversion() const
+                {
+                    return true;
+                }
                 
                 void Write::_write(const std::string & fileName, const std::shared_ptr<Image::Image> & image)
                 {
@@ -89,6 +95,7 @@ namespace djv
                     io.open(fileName, FileSystem::FileIO::Mode::Write);
                     Info info;
                     info.video.push_back(image->getInfo());
+                    info.video[0].info.type = Image::Type::RGB_U10;
                     info.tags = image->getTags();
                     write(
                         io,
@@ -96,7 +103,14 @@ namespace djv
                         p.options.version,
                         p.options.endian,
                         _options.colorSpace.empty() ? Cineon::ColorProfile::Raw : Cineon::ColorProfile::FilmPrint);
-                    io.write(image->getData(), image->getDataByteCount());
+                    Memory::Endian fileEndian = Memory::getEndian();
+                    switch (p.options.endian)
+                    {
+                    case Endian::MSB: fileEndian = Memory::Endian::MSB; break;
+                    case Endian::LSB: fileEndian = Memory::Endian::LSB; break;
+                    default: break;
+                    }
+                    Cineon::writeImage(io, *image, fileEndian, _options.directIO);
                     writeFinish(io);
                 }
 
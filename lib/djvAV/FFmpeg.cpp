@@ -92,6 +92,54 @@ namespace djv
                     return std::string(buf);
                 }
 
+                int getThreadTypeFlags(ThreadType value, const AVCodec* codec)
+                {
+                    int out = 0;
+                    const bool frame = codec && (codec->capabilities & AV_CODEC_CAP_FRAME_THREADS);
+                    const bool slice = codec && (codec->capabilities & AV_CODEC_CAP_SLICE_THREADS);
+                    switch (value)
+                    {
+                    case ThreadType::Auto:
+                        if (frame)
+                        {
+                            out = FF_THREAD_FRAME;
+                        }
+                        else if (slice)
+                        {
+                            out = FF_THREAD_SLICE;
+                        }
+                        break;
+                    case ThreadType::Frame: out = frame ? FF_THREAD_FRAME : 0; break;
+                    case ThreadType::Slice: out = slice ? FF_THREAD_SLICE : 0; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                ThreadType getThreadType(int value)
+                {
+                    ThreadType out = ThreadType::None;
+                    if (value & FF_THREAD_FRAME)
+                    {
+                        out = ThreadType::Frame;
+                    }
+                    else if (value & FF_THREAD_SLICE)
+                    {
+                        out = ThreadType::Slice;
+                    }
+                    return out;
+                }
+
+                float DecodeStats::getFramesPerSecond() const
+                {
+                    return decodeTime > 0.0 ? static_cast<float>(frameCount / decodeTime) : 0.F;
+                }
+
+                float DecodeStats::getSeekLatency() const
+                {
+                    return seekCount ? static_cast<float>(seekTime / seekCount) : 0.F;
+                }
+
                 namespace
                 {
                     std::weak_ptr<LogSystem> _logSystem;
@@ -166,6 +214,9 @@ namespace djv
     {
         picojson::value out(picojson::object_type, true);
         {
+            std::stringstream ss;
+            ss << value.threadType;
+            out.get<picojson::object>()["ThreadType"] = picojson::value(ss.str());
             out.get<picojson::object>()["ThreadCount"] = toJSON(value.threadCount);
         }
         return out;
@@ -177,7 +228,12 @@ namespace djv
         {
             for (const auto& i : value.get<picojson::object>())
             {
-                if ("ThreadCount" == i.first)
+                if ("ThreadType" == i.first)
+                {
+                    std::stringstream ss(i.second.get<std::string>());
+                    ss >> out.threadType;
+                }
+                else if ("ThreadCount" == i.first)
                 {
                     fromJSON(i.second, out.threadCount);
                 }
@@ -189,5 +245,13 @@ namespace djv
         }
     }
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO::FFmpeg,
+        ThreadType,
+        DJV_TEXT("None"),
+        DJV_TEXT("Auto"),
+        DJV_TEXT("Frame"),
+        DJV_TEXT("Slice"));
+
 } // namespace djv
 
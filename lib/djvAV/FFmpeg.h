@@ -66,10 +66,50 @@ namespace djv
 
                 std::string getErrorString(int);
 
+                //! This enumeration provides the video decoder threading models.
+                enum class ThreadType
+                {
+                    None,   //!< Decode on a single thread
+                    Auto,   //!< Frame threading if the codec supports it, otherwise slice threading
+                    Frame,  //!< Decode several frames at once, which adds latency
+                    Slice,  //!< Decode the slices of each frame at once
+
+                    Count,
+                    First = None
+                };
+                DJV_ENUM_HELPERS(ThreadType);
+
+                //! Get the FFmpeg thread type flags (FF_THREAD_FRAME and
+                //! FF_THREAD_SLICE) for a codec. Returns zero if the codec
+                //! does not support the threading model.
+                int getThreadTypeFlags(ThreadType, const AVCodec*);
+
+                //! Get the threading model from FFmpeg thread type flags.
+                ThreadType getThreadType(int);
+
                 //! This struct provides the FFmpeg file I/O optioms.
                 struct Options
                 {
-                    size_t threadCount = 4;
+                    ThreadType threadType  = ThreadType::Auto;
+                    size_t     threadCount = 4;
+                };
+
+                //! This struct provides video decoding statistics.
+                struct DecodeStats
+                {
+                    ThreadType threadType       = ThreadType::None; //!< The threading model used by the decoder
+                    size_t     threadCount      = 0;
+                    size_t     frameCount       = 0;
+                    double     decodeTime       = 0.0; //!< The time spent in the decoder in seconds
+                    size_t     seekCount        = 0;
+                    double     seekTime         = 0.0; //!< The time from seeking to the first frame in seconds
+                    size_t     delayFrameCount  = 0;   //!< The number of packets sent before the first frame
+
+                    //! Get the number of frames decoded per second of decoding time.
+                    float getFramesPerSecond() const;
+
+                    //! Get the average time from seeking to the first frame in seconds.
+                    float getSeekLatency() const;
                 };
 
                 //! This class provides the FFmpeg file reader.
@@ -101,6 +141,11 @@ namespace djv
                     std::future<Info> getInfo() override;
 
                     void seek(int64_t, Direction) override;
+                    bool isSeeking() const override;
+
+                    //! Get the video decoding statistics. The statistics are
+                    //! also logged when the file is closed.
+                    DecodeStats getDecodeStats() const;
 
                 private:
                     struct DecodeVideo
@@ -153,6 +198,8 @@ namespace djv
     //! - std::exception
     void fromJSON(const picojson::value&, AV::IO::FFmpeg::Options&);
 
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::FFmpeg::ThreadType);
+
 } // namespace djv
 
 #include <djvAV/FFmpegInline.h>
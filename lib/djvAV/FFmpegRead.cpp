@@ -34,6 +34,9 @@
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
 
+#include <algorithm>
+#include <chrono>
+
 extern "C"
 {
 #include <libavformat/avformat.h>
@@ -66,6 +69,13 @@ namespace djv
                     std::thread thread;
                     std::atomic<bool> running;
 
+                    bool video = false;
+                    DecodeStats stats;
+                    bool seeking = false;
+                    std::chrono::steady_clock::time_point seekTime;
+                    bool delay = true;
+                    size_t delayPacketCount = 0;
+
                     AVFormatContext * avFormatContext = nullptr;
                     int avVideoStream = -1;
                     int avAudioStream = -1;
@@ -183,7 +193,7 @@ namespace djv
                                     throw FileSystem::Error(ss.str());
                                 }
                                 p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
-                                p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
+                                p.avCodecContext[p.avVideoStream]->thread_type = getThreadTypeFlags(p.options.threadType, avVideoCodec);
                                 r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
                                 if (r < 0)
                                 {
@@ -192,6 +202,15 @@ namespace djv
                                         DJV_TEXT("cannot be opened") << ". " << FFmpeg::getErrorString(r);
                                     throw FileSystem::Error(ss.str());
                                 }
+                                {
+                                    // The codec may use a different threading model than
+                                    // was requested, or no threading at all.
+                                    const ThreadType activeThreadType = getThreadType(p.avCodecContext[p.avVideoStream]->active_thread_type);
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    p.video = true;
+                                    p.stats.threadType = activeThreadType;
+                                    p.stats.threadCount = activeThreadType != ThreadType::None ? p.avCodecContext[p.avVideoStream]->thread_count : 1;
+                                }
 
                                 // Initialize the buffers.
                                 p.avFrameRgb = av_frame_alloc();
@@ -449,6 +468,8 @@ namespace djv
                                         if (p.avVideoStream != -1)
                                         {
                                             avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                                            p.delay = true;
+                                            p.delayPacketCount = 0;
                                         }
                                         if (p.avAudioStream != -1)
                                         {
@@ -565,6 +586,7 @@ namespace djv
                                         std::lock_guard<std::mutex> lock(_mutex);
                                         _videoQueue.setFinished(true);
                                         _audioQueue.setFinished(true);
+                                        p.seeking = false;
                                     }
                                 }
                             }
@@ -574,6 +596,17 @@ namespace djv
                             p.infoPromise.set_value(Info());
                             _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), LogLevel::Error);
                         }
+                        const DecodeStats stats = getDecodeStats();
+                        if (stats.frameCount)
+                        {
+                            std::stringstream ss;
+                            ss << _fileInfo << ": " << stats.threadType << " threading, " <<
+                                stats.threadCount << " threads, " <<
+                                stats.getFramesPerSecond() << " decoded frames per second, " <<
+                                stats.getSeekLatency() * 1000.F << "ms average seek latency, " <<
+                                stats.delayFrameCount << " frames of decoder delay";
+                            _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
+                        }
                         if (p.swsContext)
                         {
                             sws_freeContext(p.swsContext);
@@ -644,20 +677,63 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     {
                         std::lock_guard<std::mutex> lock(_mutex);
-                        _videoQueue.clearFrames();
-                        _audioQueue.clearFrames();
                         p.seek = value;
+                        if (p.video)
+                        {
+                            if (!p.seeking)
+                            {
+                                p.seekTime = std::chrono::steady_clock::now();
+                            }
+                            p.seeking = true;
+                        }
                     }
                     p.queueCV.notify_one();
                 }
 
+                bool Read::isSeeking() const
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _p->seeking;
+                }
+
+                DecodeStats Read::getDecodeStats() const
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _p->stats;
+                }
+
                 int Read::_decodeVideo(const DecodeVideo& dv, Frame::Number& frame)
                 {
                     DJV_PRIVATE_PTR();
+                    auto t = std::chrono::steady_clock::now();
                     int r = avcodec_send_packet(p.avCodecContext[p.avVideoStream], dv.packet);
+                    if (dv.packet && p.delay)
+                    {
+                        ++p.delayPacketCount;
+                    }
                     while (r >= 0)
                     {
                         r = avcodec_receive_frame(p.avCodecContext[p.avVideoStream], p.avFrame);
+                        const auto now = std::chrono::steady_clock::now();
+                        const std::chrono::duration<double> decodeTime = now - t;
+                        t = now;
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            p.stats.decodeTime += decodeTime.count();
+                            if (r >= 0)
+                            {
+                                ++p.stats.frameCount;
+                                if (p.delay)
+                                {
+                                    // With frame threading the decoder buffers a frame
+                                    // per thread before returning the first one.
+                                    p.stats.delayFrameCount = std::max(
+                                        p.stats.delayFrameCount,
+                                        p.delayPacketCount > 0 ? p.delayPacketCount - 1 : static_cast<size_t>(0));
+                                    p.delay = false;
+                                }
+                            }
+                        }
                         if (AVERROR(EAGAIN) == r)
                         {
                             r = 0;
@@ -713,13 +789,28 @@ namespace djv
                                 }
                             }
                             {
-                                std::lock_guard<std::mutex> lock(_mutex);
-                                if (Frame::invalid == p.seek)
+                                // Wait for room in the queue instead of dropping
+                                // the frame, unless there is a new seek.
+                                std::unique_lock<std::mutex> lock(_mutex);
+                                const VideoFrame videoFrame(frame, image);
+                                bool added = false;
+                                while (Frame::invalid == p.seek && p.running && !(added = _videoQueue.addFrame(videoFrame)))
                                 {
-                                    _videoQueue.addFrame(VideoFrame(frame, image));
+                                    p.queueCV.wait_for(lock, Time::getMilliseconds(Time::TimerValue::Fast));
+                                }
+                                if (added)
+                                {
+                                    if (p.seeking)
+                                    {
+                                        const std::chrono::duration<double> seekTime = std::chrono::steady_clock::now() - p.seekTime;
+                                        p.stats.seekTime += seekTime.count();
+                                        ++p.stats.seekCount;
+                                        p.seeking = false;
+                                    }
                                 }
                             }
                         }
+                        t = std::chrono::steady_clock::now();
                     }
                     return r;
                 }
@@ -892,10 +983,12 @@ namespace djv
                             default: break;
                             }
                             {
-                                std::lock_guard<std::mutex> lock(_mutex);
-                                if (Frame::invalid == p.seek)
+                                // Wait for room in the queue, see above.
+                                std::unique_lock<std::mutex> lock(_mutex);
+                                const AudioFrame audioFrame(audioData);
+                                while (Frame::invalid == p.seek && p.running && !_audioQueue.addFrame(audioFrame))
                                 {
-                                    _audioQueue.addFrame(AudioFrame(audioData));
+                                    p.queueCV.wait_for(lock, Time::getMilliseconds(Time::TimerValue::Fast));
                                 }
                             }
                         }
@@ -52,6 +52,11 @@ namespace djv
                 static const std::string pluginName = "IFF";
                 static const std::set<std::string> fileExtensions = { ".iff", ".z" };
 
+                //! Decode run-length encoded data, advancing the pointer past
+                //! the data that is read. Returns false if the data is
+                //! truncated or overflows the output.
+                bool readRle(const uint8_t*& p, const uint8_t* end, uint8_t* out, size_t size);
+
                 //! This class provides the IFF file reader.
                 class Read : public ISequenceRead
                 {
@@ -66,18 +71,18 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    bool _hasReadAhead() const override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO &);
-                    
-                    int  _tiles       = 0;
-                    bool _compression = false;
+                    Info _open(const std::string &, Core::FileSystem::FileIO &, int & tiles);
                 };
 
                 //! This class provides the IFF file I/O plugin.
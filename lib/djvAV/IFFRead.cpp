@@ -33,6 +33,9 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace djv::Core;
 
 namespace djv
@@ -56,37 +59,159 @@ namespace djv
                         return size;
                     }
 
-                    size_t readRle(FileSystem::FileIO& io, uint8_t* out, size_t size)
+                    //! Read a big-endian value from memory.
+                    uint32_t getU32(const uint8_t* p)
+                    {
+                        return (static_cast<uint32_t>(p[0]) << 24) |
+                            (static_cast<uint32_t>(p[1]) << 16) |
+                            (static_cast<uint32_t>(p[2]) << 8) |
+                            static_cast<uint32_t>(p[3]);
+                    }
+
+                    uint16_t getU16(const uint8_t* p)
+                    {
+                        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+                    }
+
+                    bool isType(const uint8_t* p, const char* type)
+                    {
+                        return
+                            p[0] == type[0] &&
+                            p[1] == type[1] &&
+                            p[2] == type[2] &&
+                            p[3] == type[3];
+                    }
+
+                } // namespace
+
+                bool readRle(const uint8_t*& p, const uint8_t* end, uint8_t* out, size_t size)
+                {
+                    const uint8_t* const outEnd = out + size;
+                    while (out < outEnd)
                     {
-                        const size_t pos = io.getPos();
-                        const uint8_t* const end = out + size;
-                        while (out < end)
+                        // Information.
+                        if (p >= end)
                         {
-                            // Information.
-                            uint8_t in = 0;
-                            io.readU8(&in);
-                            const uint8_t count = (in & 0x7f) + 1;
-                            const bool run = (in & 0x80) ? true : false;
-
-                            // Find runs.
-                            if (!run)
+                            return false;
+                        }
+                        const uint8_t in = *p++;
+                        const size_t count = (in & 0x7f) + 1;
+                        const bool run = (in & 0x80) ? true : false;
+                        if (count > static_cast<size_t>(outEnd - out))
+                        {
+                            return false;
+                        }
+
+                        // Find runs.
+                        if (!run)
+                        {
+                            // Verbatim.
+                            if (count > static_cast<size_t>(end - p))
                             {
-                                // Verbatim.
-                                io.readU8(out, count);
-                                out += count;
+                                return false;
                             }
-                            else
+                            memcpy(out, p, count);
+                            p += count;
+                        }
+                        else
+                        {
+                            // Duplicate.
+                            if (p >= end)
                             {
-                                // Duplicate.
-                                io.readU8(&in);
-                                const uint8_t p = in;
-                                for (int i = 0; i < count; i++)
+                                return false;
+                            }
+                            memset(out, *p++, count);
+                        }
+                        out += count;
+                    }
+                    return true;
+                }
+
+                namespace
+                {
+                    //! This struct provides the location of a tile in the file.
+                    struct Tile
+                    {
+                        uint16_t       xmin = 0;
+                        uint16_t       ymin = 0;
+                        uint16_t       xmax = 0;
+                        uint16_t       ymax = 0;
+                        const uint8_t* data = nullptr;
+                        size_t         size = 0;
+                    };
+
+                    void readTile(const Tile& tile, Image::Image& out)
+                    {
+                        const Image::Type type = out.getType();
+                        const size_t channels = Image::getChannelCount(type);
+                        const size_t channelByteCount = Image::getByteCount(Image::getDataType(type));
+                        const size_t byteCount = Image::getByteCount(type);
+                        const size_t tw = tile.xmax - tile.xmin + 1;
+                        const size_t th = tile.ymax - tile.ymin + 1;
+                        const uint8_t* p = tile.data;
+                        const uint8_t* const end = tile.data + tile.size;
+
+                        // If tile compression fails to be less than image data
+                        // stored uncompressed, the tile is written uncompressed.
+                        if (tw * th * byteCount > tile.size)
+                        {
+                            // The channel bytes are stored as separate planes,
+                            // which are mapped from BGRA to RGBA.
+                            const bool u16 = Image::Type::RGB_U16 == type || Image::Type::RGBA_U16 == type;
+                            const bool rgba = Image::Type::RGBA_U8 == type || Image::Type::RGBA_U16 == type;
+                            const int rgb16Map[2][6] = { { 1, 3, 5, 0, 2, 4 }, { 0, 2, 4, 1, 3, 5 } };
+                            const int rgba16Map[2][8] = { { 1, 3, 5, 7, 0, 2, 4, 6 }, { 0, 2, 4, 7, 1, 3, 5, 6 } };
+                            const size_t endianIndex = Memory::Endian::LSB == Memory::getEndian() ? 1 : 0;
+                            std::vector<uint8_t> plane(tw * th);
+                            for (int c = static_cast<int>(channels * channelByteCount) - 1; c >= 0; --c)
+                            {
+                                if (!readRle(p, end, plane.data(), plane.size()))
+                                {
+                                    throw FileSystem::Error(DJV_TEXT("File not supported."));
+                                }
+                                const size_t mc = u16 ? (rgba ? rgba16Map[endianIndex][c] : rgb16Map[endianIndex][c]) : c;
+                                const uint8_t* inP = plane.data();
+                                for (uint16_t py = tile.ymin; py <= tile.ymax; ++py)
                                 {
-                                    *out++ = p;
+                                    uint8_t* outP = out.getData(tile.xmin, py) + mc;
+                                    for (size_t px = 0; px < tw; ++px, outP += byteCount)
+                                    {
+                                        *outP = *inP++;
+                                    }
+                                }
+                            }
+
+                            // Test.
+                            if (p != end)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("File not supported."));
+                            }
+                        }
+                        else
+                        {
+                            // The pixels are stored as ABGR.
+                            for (uint16_t py = tile.ymin; py <= tile.ymax; ++py)
+                            {
+                                uint8_t* outP = out.getData(tile.xmin, py);
+                                for (size_t px = 0; px < tw; ++px, p += byteCount)
+                                {
+                                    for (int c = static_cast<int>(channels) - 1; c >= 0; --c)
+                                    {
+                                        const uint8_t* inP = p + c * channelByteCount;
+                                        if (1 == channelByteCount)
+                                        {
+                                            *outP++ = *inP;
+                                        }
+                                        else
+                                        {
+                                            const uint16_t pixel = getU16(inP);
+                                            memcpy(outP, &pixel, 2);
+                                            outP += 2;
+                                        }
+                                    }
                                 }
                             }
                         }
-                        return io.getPos() - pos;
                     }
 
                 } // namespace
@@ -102,393 +227,161 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    int tiles = 0;
+                    return _open(fileName, io, tiles);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
-                    std::shared_ptr<Image::Image> out;
                     FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
-                    out = Image::Image::create(info.video[0].info);
+                    io.setMMap(_options.mmap);
+                    int tiles = 0;
+                    const auto info = _open(fileName, io, tiles);
+                    auto out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
+                    const Image::Type type = info.video[0].info.type;
+                    if (type != Image::Type::RGB_U8 &&
+                        type != Image::Type::RGBA_U8 &&
+                        type != Image::Type::RGB_U16 &&
+                        type != Image::Type::RGBA_U16)
+                    {
+                        return out;
+                    }
 
-                    uint8_t type[4];
-                    uint8_t pixels[32];
-                    uint32_t size;
-                    uint32_t chunkSize;
-                    uint32_t tilesRgba = _tiles;
+                    // The rest of the file is read once and the tiles are
+                    // found, then they are decoded in parallel chunks.
+                    const size_t pos = io.getPos();
+                    const size_t fileSize = io.getSize() - pos;
+                    std::vector<uint8_t> buf;
+                    const uint8_t* p = nullptr;
+                    if (io.isMMap())
+                    {
+                        io.mmapWillNeed(fileSize);
+                        p = io.mmapP();
+                    }
+                    else
+                    {
+                        buf.resize(fileSize);
+                        io.read(buf.data(), fileSize);
+                        p = buf.data();
+                    }
+                    const uint8_t* const end = p + fileSize;
 
-                    const size_t channelByteCount = Image::getByteCount(Image::getDataType(info.video[0].info.type));
-                    const size_t byteCount = Image::getByteCount(info.video[0].info.type);
+                    std::vector<Tile> tileList;
+                    int tilesRgba = tiles;
 
                     // Read FOR4 <size> TBMP block
-                    while (!io.isEOF())
+                    while (end - p >= 8)
                     {
-                        // Get type.
-                        io.read(&type, 4);
-
-                        // Get length.
-                        io.readU32(&size, 1);
-                        chunkSize = getAlignSize(size, 4);
-
-                        if (type[0] == 'A' &&
-                            type[1] == 'U' &&
-                            type[2] == 'T' &&
-                            type[3] == 'H')
+                        // Get type and length.
+                        const uint8_t* chunkType = p;
+                        uint32_t size = getU32(p + 4);
+                        p += 8;
+                        size_t chunkSize = std::min(
+                            static_cast<size_t>(getAlignSize(size, 4)),
+                            static_cast<size_t>(end - p));
+
+                        if (isType(chunkType, "AUTH"))
                         {
-                            std::vector<uint8_t> buf(chunkSize);
-                            io.readU8(buf.data(), chunkSize);
-                            std::string s;
-                            for (const auto& i : buf)
-                            {
-                                s.push_back(i);
-                            }
-
                             // Get tag.
                             Tags tags;
-                            tags.setTag("Creator", s);
+                            tags.setTag("Creator", std::string(reinterpret_cast<const char*>(p), chunkSize));
 
                             // Set tag.
                             out->setTags(tags);
+                            p += chunkSize;
                         }
-                        else if (type[0] == 'F' &&
-                            type[1] == 'O' &&
-                            type[2] == 'R' &&
-                            type[3] == '4')
+                        else if (isType(chunkType, "FOR4"))
                         {
-                            // Get type.
-                            io.read(&type, 4);
-
                             // Check if TBMP.
-                            if (type[0] == 'T' &&
-                                type[1] == 'B' &&
-                                type[2] == 'M' &&
-                                type[3] == 'P')
+                            if (end - p < 4)
+                            {
+                                break;
+                            }
+                            const bool tbmp = isType(p, "TBMP");
+                            p += 4;
+                            if (tbmp)
                             {
                                 // Read RGBA and ZBUF block.
-                                while (!io.isEOF())
+                                while (tilesRgba && end - p >= 8)
                                 {
-                                    // Get type.
-                                    io.read(&type, 4);
-
-                                    // Get length.
-                                    io.readU32(&size, 1);
+                                    // Get type and length.
+                                    chunkType = p;
+                                    size = getU32(p + 4);
+                                    p += 8;
                                     chunkSize = getAlignSize(size, 4);
+                                    if (chunkSize > static_cast<size_t>(end - p))
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("File not supported."));
+                                    }
 
                                     // Tiles and RGBA.
-                                    if (tilesRgba &&
-                                        type[0] == 'R' &&
-                                        type[1] == 'G' &&
-                                        type[2] == 'B' &&
-                                        type[3] == 'A')
+                                    if (isType(chunkType, "RGBA"))
                                     {
-                                        // Set image size.
-                                        uint32_t imageSize = size;
-
                                         // Get tile coordinates.
-                                        uint16_t xmin;
-                                        uint16_t xmax;
-                                        uint16_t ymin;
-                                        uint16_t ymax;
-                                        io.readU16(&xmin, 1);
-                                        io.readU16(&ymin, 1);
-                                        io.readU16(&xmax, 1);
-                                        io.readU16(&ymax, 1);
-
-                                        if (xmin > xmax ||
-                                            ymin > ymax ||
-                                            xmax >= info.video[0].info.size.w ||
-                                            ymax >= info.video[0].info.size.h)
+                                        if (size < 8)
                                         {
                                             throw FileSystem::Error(DJV_TEXT("File not supported."));
                                         }
-
-                                        // NOTE: tile w = xmax - xmin + 1
-                                        //       tile h = ymax - ymin + 1
-
-                                        uint32_t tw = xmax - xmin + 1;
-                                        uint32_t th = ymax - ymin + 1;
-
-                                        if (!tw || !th)
+                                        Tile tile;
+                                        tile.xmin = getU16(p);
+                                        tile.ymin = getU16(p + 2);
+                                        tile.xmax = getU16(p + 4);
+                                        tile.ymax = getU16(p + 6);
+                                        tile.data = p + 8;
+                                        tile.size = size - 8;
+                                        if (tile.xmin > tile.xmax ||
+                                            tile.ymin > tile.ymax ||
+                                            tile.xmax >= info.video[0].info.size.w ||
+                                            tile.ymax >= info.video[0].info.size.h)
                                         {
                                             throw FileSystem::Error(DJV_TEXT("File not supported."));
                                         }
-
-                                        bool tile_compress = false;
-
-                                        // If tile compression fails to be less than
-                                        // image data stored uncompressed, the tile
-                                        // is written uncompressed.
-
-                                        // Set channels.
-                                        uint8_t channels = Image::getChannelCount(info.video[0].info.type);
-
-                                        // Set tile pixels.
-
-                                        // Append xmin, xmax, ymin and ymax.
-                                        uint32_t tileSize =
-                                            tw * th * channels *
-                                            Image::getByteCount(Image::getDataType(info.video[0].info.type)) + 8;
-
-                                        // Test compressed.
-                                        if (tileSize > imageSize)
-                                        {
-                                            tile_compress = true;
-                                        }
-
-                                        // Handle 8-bit data.
-                                        if (info.video[0].info.type == Image::Type::RGB_U8 ||
-                                            info.video[0].info.type == Image::Type::RGBA_U8)
-                                        {
-                                            // Tile compress.
-                                            if (tile_compress)
-                                            {
-                                                int p = 0;
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1;
-                                                    c >= 0;
-                                                    --c)
-                                                {
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + c;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
-                                                {
-                                                    throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                }
-                                            }
-                                            else
-                                            {
-                                                for (uint16_t py = ymin; py <= ymax; py++)
-                                                {
-                                                    uint8_t* out_dy = out->getData(xmin, py);
-
-                                                    // Tile scanline.
-                                                    std::vector<uint8_t> scanline(tw * byteCount);
-                                                    uint8_t* outP = scanline.data();
-
-                                                    // Set bytes.
-                                                    for (uint16_t px = xmin; px <= xmax; px++)
-                                                    {
-                                                        // Get pixels.
-                                                        io.read(&pixels, byteCount);
-
-                                                        if (size < static_cast<uint32_t>(byteCount))
-                                                        {
-                                                            throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                        }
-
-                                                        size -= byteCount;
-
-                                                        // Map: RGB(A)8 ABGR to ARGB
-                                                        for (int c = channels - 1; c >= 0; --c)
-                                                        {
-                                                            uint8_t pixel;
-                                                            uint8_t* inP = pixels + c * channelByteCount;
-                                                            memcpy(&pixel, inP, 1);
-                                                            *outP++ = pixel;
-                                                        }
-                                                    }
-
-                                                    // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
-                                                }
-                                            }
-                                        }
-                                        // Handle 16-bit data.
-                                        else if (
-                                            info.video[0].info.type == Image::Type::RGB_U16 ||
-                                            info.video[0].info.type == Image::Type::RGBA_U16)
-                                        {
-                                            if (tile_compress)
-                                            {
-                                                // Set bytes.
-                                                int p = 0;
-
-                                                // Set map.
-                                                int* map = NULL;
-
-                                                if (Memory::getEndian() == Memory::Endian::LSB)
-                                                {
-                                                    int rgb16[] = { 0, 2, 4, 1, 3, 5 };
-                                                    int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
-
-                                                    if (info.video[0].info.type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-                                                else
-                                                {
-                                                    int rgb16[] = { 1, 3, 5, 0, 2, 4 };
-                                                    int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
-
-                                                    if (info.video[0].info.type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
-                                                {
-                                                    int mc = map[c];
-
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + mc;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
-                                                {
-                                                    throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                }
-                                            }
-                                            else
-                                            {
-                                                for (uint16_t py = ymin; py <= ymax; py++)
-                                                {
-                                                    uint8_t* out_dy = out->getData(xmin, py);
-
-                                                    // Tile scanline.
-                                                    std::vector<uint16_t> scanline(tw * byteCount);
-                                                    uint16_t* outP = scanline.data();
-
-                                                    // Set bytes.
-                                                    for (uint16_t px = xmin; px <= xmax; px++)
-                                                    {
-                                                        // Get pixels.
-                                                        io.read(&pixels, byteCount);
-
-                                                        if (size < static_cast<uint32_t>(byteCount))
-                                                        {
-                                                            throw FileSystem::Error(DJV_TEXT("File not supported."));
-                                                        }
-
-                                                        size -= byteCount;
-
-                                                        // Map: RGB8 ABGR to ARGB
-                                                        for (int c = channels - 1; c >= 0; --c)
-                                                        {
-                                                            uint16_t pixel;
-                                                            uint8_t* in = pixels + c * channelByteCount;
-
-                                                            if (Memory::getEndian() == Memory::Endian::LSB)
-                                                            {
-                                                                Memory::endian(in, &pixel, 1, 2);
-                                                            }
-                                                            else
-                                                            {
-                                                                memcpy(&pixel, in, 2);
-                                                            }
-
-                                                            // Set pixel.
-                                                            *outP++ = pixel;
-                                                        }
-                                                    }
-
-                                                    // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
-                                                }
-                                            }
-                                        }
-                                        else
-                                        {
-                                            io.seek(chunkSize);
-                                        }
-
-                                        // Seek to align to chunksize.
-                                        size = chunkSize - imageSize;
-
-                                        if (size)
-                                        {
-                                            io.seek(size);
-                                        }
-
+                                        tileList.push_back(tile);
                                         tilesRgba--;
                                     }
-                                    else
-                                    {
-                                        io.seek(chunkSize);
-                                    }
-
-                                    if (tilesRgba)
-                                    {
-                                        continue;
-                                    }
-                                    else
-                                    {
-                                        break;
-                                    }
-
+                                    p += chunkSize;
                                 }
 
                                 // TBMP done, break.
                                 break;
                             }
-
                         }
                         else
                         {
                             // Skip to the next block.
-                            io.seek(chunkSize);
+                            p += chunkSize;
                         }
                     }
 
+                    parallelChunks(
+                        tileList.size(),
+                        _options.rleThreadCount,
+                        [&tileList, &out](size_t begin, size_t end)
+                        {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                readTile(tileList[i], *out);
+                            }
+                        });
+
                     return out;
                 }
 
+
                 namespace
                 {
                     class Header
@@ -737,12 +630,21 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io)
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
+                }
+
+                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io, int & tiles)
                 {
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
-                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    if (!_openReadAhead(fileName, io))
+                    {
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    }
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _tiles, _compression);
+                    bool compression = false;
+                    Header().read(io, imageInfo, tiles, compression);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -33,6 +33,9 @@
 #include <djvAV/DPX.h>
 #include <djvAV/GLFWSystem.h>
 #include <djvAV/IFF.h>
+#include <djvAV/IOCacheManager.h>
+#include <djvAV/IOCachePolicy.h>
+#include <djvAV/IOThreadPool.h>
 #include <djvAV/OCIOSystem.h>
 #include <djvAV/PPM.h>
 #include <djvAV/RLA.h>
@@ -58,10 +61,18 @@
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/OS.h>
 #include <djvCore/Path.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/String.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <sstream>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -70,72 +81,162 @@ namespace djv
     {
         namespace IO
         {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t queueCapacityMin = 8;
+
+                //! The ring buffers are larger than the maximum number of frames
+                //! so the producer can continue adding frames after the queue has
+                //! been cleared, before the consumer has released the old frames.
+                size_t getQueueCapacity(size_t value)
+                {
+                    size_t out = queueCapacityMin;
+                    while (out < value * 4)
+                    {
+                        out *= 2;
+                    }
+                    return out;
+                }
+
+            } // namespace
+
             void VideoQueue::setMax(size_t value)
             {
                 _max = value;
+                const size_t capacity = getQueueCapacity(value);
+                _mask = capacity - 1;
+                _frames = std::vector<VideoFrame>(capacity);
+                _frameNumbers.reset(new std::atomic<Frame::Number>[capacity]);
+                for (size_t i = 0; i < capacity; ++i)
+                {
+                    _frameNumbers[i].store(Frame::invalid);
+                }
+                _head.store(0);
+                _tail.store(0);
+                _clear.store(0);
+            }
+
+            bool VideoQueue::isEmpty()
+            {
+                return _releaseCleared() == _tail.load(std::memory_order_acquire);
             }
 
-            void VideoQueue::addFrame(const VideoFrame& value)
+            VideoFrame VideoQueue::getFrame()
             {
-                _queue.push(value);
+                const size_t head = _releaseCleared();
+                return head != _tail.load(std::memory_order_acquire) ? _frames[head & _mask] : VideoFrame();
+            }
+
+            bool VideoQueue::addFrame(const VideoFrame& value)
+            {
+                // The consumer may still be reading the slots from the head up
+                // to the tail, including the frames that were cleared, so only
+                // the slots before the head are reused.
+                const size_t tail = _tail.load(std::memory_order_relaxed);
+                if (tail - _head.load(std::memory_order_acquire) >= _frames.size())
+                    return false;
+                _frames[tail & _mask] = value;
+                _frameNumbers[tail & _mask].store(value.frame, std::memory_order_relaxed);
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
             }
 
             VideoFrame VideoQueue::popFrame()
             {
                 VideoFrame out;
-                if (_queue.size())
+                size_t head = _releaseCleared();
+                if (head != _tail.load(std::memory_order_acquire))
                 {
-                    out = _queue.front();
-                    _queue.pop();
+                    std::swap(out, _frames[head & _mask]);
+                    _head.store(head + 1, std::memory_order_release);
                 }
                 return out;
             }
 
             void VideoQueue::clearFrames()
             {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
+                _clear.store(_tail.load(std::memory_order_relaxed), std::memory_order_release);
             }
 
-            void VideoQueue::setFinished(bool value)
+            size_t VideoQueue::_releaseCleared()
             {
-                _finished = value;
+                // Move the head past the frames that were cleared. The frames
+                // are released when the producer overwrites their slots.
+                const size_t head = _head.load(std::memory_order_relaxed);
+                const size_t clear = _clear.load(std::memory_order_acquire);
+                if (clear > head)
+                {
+                    _head.store(clear, std::memory_order_release);
+                    return clear;
+                }
+                return head;
             }
 
             void AudioQueue::setMax(size_t value)
             {
                 _max = value;
+                const size_t capacity = getQueueCapacity(value);
+                _mask = capacity - 1;
+                _frames = std::vector<AudioFrame>(capacity);
+                _head.store(0);
+                _tail.store(0);
+                _clear.store(0);
+            }
+
+            bool AudioQueue::isEmpty()
+            {
+                return _releaseCleared() == _tail.load(std::memory_order_acquire);
+            }
+
+            AudioFrame AudioQueue::getFrame()
+            {
+                const size_t head = _releaseCleared();
+                return head != _tail.load(std::memory_order_acquire) ? _frames[head & _mask] : AudioFrame();
             }
 
-            void AudioQueue::addFrame(const AudioFrame& value)
+            bool AudioQueue::addFrame(const AudioFrame& value)
             {
-                _queue.push(value);
+                // The consumer may still be reading the slots from the head up
+                // to the tail, including the frames that were cleared, so only
+                // the slots before the head are reused.
+                const size_t tail = _tail.load(std::memory_order_relaxed);
+                if (tail - _head.load(std::memory_order_acquire) >= _frames.size())
+                    return false;
+                _frames[tail & _mask] = value;
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
             }
 
             AudioFrame AudioQueue::popFrame()
             {
                 AudioFrame out;
-                if (_queue.size())
+                size_t head = _releaseCleared();
+                if (head != _tail.load(std::memory_order_acquire))
                 {
-                    out = _queue.front();
-                    _queue.pop();
+                    std::swap(out, _frames[head & _mask]);
+                    _head.store(head + 1, std::memory_order_release);
                 }
                 return out;
             }
 
             void AudioQueue::clearFrames()
             {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
+                _clear.store(_tail.load(std::memory_order_relaxed), std::memory_order_release);
             }
 
-            void AudioQueue::setFinished(bool value)
+            size_t AudioQueue::_releaseCleared()
             {
-                _finished = value;
+                // Move the head past the frames that were cleared. The frames
+                // are released when the producer overwrites their slots.
+                const size_t head = _head.load(std::memory_order_relaxed);
+                const size_t clear = _clear.load(std::memory_order_acquire);
+                if (clear > head)
+                {
+                    _head.store(clear, std::memory_order_release);
+                    return clear;
+                }
+                return head;
             }
 
             void IIO::_init(
@@ -160,41 +261,292 @@ namespace djv
                 _threadCount = value;
             }
 
-            Frame::Sequence Cache::getFrames() const
+            size_t getProxyScale(Proxy value)
             {
-                Frame::Sequence out;
-                std::vector<Frame::Index> frames;
-                for (const auto& i : _cache)
+                return static_cast<size_t>(1) << static_cast<size_t>(value);
+            }
+
+            BBox2i getReadRegion(const Image::Size& size, const ReadOptions& options)
+            {
+                const BBox2i bbox(0, 0, size.w, size.h);
+                BBox2i out = bbox;
+                if (options.roi.isValid())
                 {
-                    frames.push_back(i.first);
+                    const BBox2i roi = options.roi.intersect(bbox);
+                    if (roi.min.x <= roi.max.x && roi.min.y <= roi.max.y)
+                    {
+                        out = roi;
+                    }
                 }
-                const size_t size = frames.size();
-                if (size)
-                {
-                    std::sort(frames.begin(), frames.end());
-                    Frame::Number rangeStart = frames[0];
-                    Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
+                return out;
+            }
+
+            Image::Size getReadSize(const Image::Size& size, const ReadOptions& options)
+            {
+                const BBox2i region = getReadRegion(size, options);
+                const int scale = static_cast<int>(getProxyScale(options.proxy));
+                return Image::Size(
+                    static_cast<uint16_t>((region.w() + scale - 1) / scale),
+                    static_cast<uint16_t>((region.h() + scale - 1) / scale));
+            }
+
+            bool isFullRead(const Image::Size& size, const ReadOptions& options)
+            {
+                return Proxy::None == options.proxy && getReadRegion(size, options) == BBox2i(0, 0, size.w, size.h);
+            }
+
+            namespace
+            {
+                //! This class provides a process wide set of worker threads
+                //! for parallelChunks(). The number of threads is bounded by
+                //! the hardware, no matter how many readers and writers split
+                //! their images into chunks at the same time.
+                class ChunkWorkers
+                {
+                public:
+                    ChunkWorkers()
+                    {
+                        const size_t threadCount = std::max(
+                            static_cast<size_t>(std::thread::hardware_concurrency()),
+                            static_cast<size_t>(1));
+                        for (size_t i = 0; i < threadCount; ++i)
+                        {
+                            _threads.push_back(std::thread(
+                                [this]
+                                {
+                                    _run();
+                                }));
+                        }
+                    }
+
+                    ~ChunkWorkers()
                     {
-                        if (frames[i] != prevFrame + 1)
                         {
-                            out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _running = false;
+                        }
+                        _cv.notify_all();
+                        for (auto& i : _threads)
+                        {
+                            i.join();
                         }
                     }
-                    if (size > 1)
+
+                    static ChunkWorkers& get()
                     {
-                        out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
+                        static ChunkWorkers workers;
+                        return workers;
                     }
-                    else
+
+                    void add(const std::function<void(void)>& value)
                     {
-                        out.ranges.push_back(Frame::Range(rangeStart));
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _tasks.push_back(value);
+                        }
+                        _cv.notify_one();
+                    }
+
+                private:
+                    void _run()
+                    {
+                        while (true)
+                        {
+                            std::function<void(void)> task;
+                            {
+                                std::unique_lock<std::mutex> lock(_mutex);
+                                _cv.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return !_tasks.empty() || !_running;
+                                    });
+                                if (_tasks.empty())
+                                {
+                                    break;
+                                }
+                                task = std::move(_tasks.front());
+                                _tasks.pop_front();
+                            }
+                            task();
+                        }
+                    }
+
+                    std::vector<std::thread> _threads;
+                    std::deque<std::function<void(void)> > _tasks;
+                    bool _running = true;
+                    std::mutex _mutex;
+                    std::condition_variable _cv;
+                };
+
+                //! This struct provides the state shared between the threads
+                //! of a parallelChunks() call.
+                struct Chunks
+                {
+                    size_t count = 0;
+                    size_t chunkCount = 0;
+                    std::function<void(size_t begin, size_t end)> function;
+                    size_t next = 0;
+                    size_t active = 0;
+                    std::exception_ptr error;
+                    std::mutex mutex;
+                    std::condition_variable cv;
+                };
+
+                //! Handle chunks until there are none left. Chunks are claimed
+                //! under the lock, so a helper that starts after all of the
+                //! chunks are finished returns without calling the function.
+                void runChunks(const std::shared_ptr<Chunks>& chunks)
+                {
+                    while (true)
+                    {
+                        size_t i = 0;
+                        {
+                            std::lock_guard<std::mutex> lock(chunks->mutex);
+                            if (chunks->next >= chunks->chunkCount)
+                            {
+                                break;
+                            }
+                            i = chunks->next++;
+                            ++chunks->active;
+                        }
+                        std::exception_ptr error;
+                        try
+                        {
+                            chunks->function(
+                                i * chunks->count / chunks->chunkCount,
+                                (i + 1) * chunks->count / chunks->chunkCount);
+                        }
+                        catch (...)
+                        {
+                            error = std::current_exception();
+                        }
+                        {
+                            std::lock_guard<std::mutex> lock(chunks->mutex);
+                            if (error && !chunks->error)
+                            {
+                                chunks->error = error;
+                            }
+                            --chunks->active;
+                        }
+                        chunks->cv.notify_all();
                     }
                 }
+
+            } // namespace
+
+            void parallelChunks(
+                size_t count,
+                size_t threadCount,
+                const std::function<void(size_t begin, size_t end)>& function)
+            {
+                const size_t chunkCount = std::max(std::min(threadCount, count), static_cast<size_t>(1));
+                if (1 == chunkCount)
+                {
+                    function(0, count);
+                    return;
+                }
+
+                // The calling thread handles chunks as well, so the call
+                // finishes even if all of the workers are busy.
+                auto chunks = std::make_shared<Chunks>();
+                chunks->count = count;
+                chunks->chunkCount = chunkCount;
+                chunks->function = function;
+                auto& workers = ChunkWorkers::get();
+                for (size_t i = 1; i < chunkCount; ++i)
+                {
+                    workers.add(
+                        [chunks]
+                        {
+                            runChunks(chunks);
+                        });
+                }
+                runChunks(chunks);
+                std::exception_ptr error;
+                {
+                    std::unique_lock<std::mutex> lock(chunks->mutex);
+                    chunks->cv.wait(
+                        lock,
+                        [chunks]
+                        {
+                            return chunks->next >= chunks->chunkCount && 0 == chunks->active;
+                        });
+                    error = std::move(chunks->error);
+                }
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+
+            size_t CacheWindow::getSize() const
+            {
+                size_t out = 0;
+                for (const auto& i : spans)
+                {
+                    out += i.getSize();
+                }
                 return out;
             }
 
+            bool CacheWindow::getPosition(Frame::Index frame, size_t& out) const
+            {
+                size_t position = 0;
+                for (const auto& i : spans)
+                {
+                    if (i.range.contains(frame))
+                    {
+                        out = position + static_cast<size_t>(Direction::Forward == i.direction ?
+                            (frame - i.range.min) :
+                            (i.range.max - frame));
+                        return true;
+                    }
+                    position += i.getSize();
+                }
+                return false;
+            }
+
+            Frame::Sequence CacheWindow::getSequence() const
+            {
+                Frame::Sequence out;
+                for (const auto& i : spans)
+                {
+                    out.ranges.push_back(i.range);
+                }
+                out.sort();
+                return out;
+            }
+
+            Cache::Cache() :
+                _policy(CachePolicy::create()),
+                _manager(CacheManager::create())
+            {
+                _manager->setMaxByteCount(std::numeric_limits<size_t>::max());
+                _client = _manager->addClient();
+                _cacheUpdate();
+            }
+
+            Cache::~Cache()
+            {
+                _manager->removeClient(_client);
+            }
+
+            size_t Cache::getCount() const
+            {
+                return _manager->getCount(_client);
+            }
+
+            size_t Cache::getTotalByteCount() const
+            {
+                return _manager->getByteCount(_client);
+            }
+
+            Frame::Sequence Cache::getFrames() const
+            {
+                return _manager->getFrames(_client);
+            }
+
             void Cache::setMax(size_t value)
             {
                 if (value == _max)
@@ -232,123 +584,104 @@ namespace djv
                 if (value == _currentFrame)
                     return;
                 _currentFrame = value;
+                _manager->touch(_client);
+                _cacheUpdate();
+            }
+
+            void Cache::setPlayback(bool value)
+            {
+                if (value == _playback)
+                    return;
+                _playback = value;
+                _cacheUpdate();
+            }
+
+            void Cache::setPlaybackSpeed(const Time::Speed& value)
+            {
+                if (value == _playbackSpeed)
+                    return;
+                _playbackSpeed = value;
+                _cacheUpdate();
+            }
+
+            void Cache::setPlaybackMode(PlaybackMode value)
+            {
+                if (value == _playbackMode)
+                    return;
+                _playbackMode = value;
                 _cacheUpdate();
             }
 
+            void Cache::setPolicy(const std::shared_ptr<ICachePolicy>& value)
+            {
+                if (value == _policy)
+                    return;
+                _policy = value;
+                _cacheUpdate();
+            }
+
+            void Cache::setManager(const std::shared_ptr<CacheManager>& value)
+            {
+                if (value == _manager)
+                    return;
+                _manager->removeClient(_client);
+                _manager = value;
+                _client = _manager->addClient();
+                _cacheUpdate();
+            }
+
+            size_t Cache::getAvailableByteCount() const
+            {
+                return _manager->getAvailableByteCount(_client);
+            }
+
             bool Cache::contains(Frame::Index value) const
             {
-                return _cache.find(value) != _cache.end();
+                return _manager->contains(_client, value);
             }
 
             bool Cache::get(Frame::Index index, std::shared_ptr<AV::Image::Image>& out) const
             {
-                const auto i = _cache.find(index);
-                const bool found = i != _cache.end();
-                if (found)
-                {
-                    out = i->second;
-                }
-                return found;
+                return _manager->get(_client, index, out);
             }
 
-            void Cache::add(Frame::Index index, const std::shared_ptr<AV::Image::Image>& image)
+            bool Cache::getCompressed(Frame::Index index, std::shared_ptr<AV::Image::CompressedData>& out) const
             {
-                _cache[index] = image;
-                _cacheUpdate();
+                return _manager->getCompressed(_client, index, out);
+            }
+
+            void Cache::add(Frame::Index index, const std::shared_ptr<AV::Image::Image>& image, const DiskCacheKey& diskCacheKey)
+            {
+                _manager->add(_client, index, image, diskCacheKey);
+            }
+
+            void Cache::add(Frame::Index index, const std::shared_ptr<AV::Image::CompressedData>& data, const DiskCacheKey& diskCacheKey)
+            {
+                _manager->add(_client, index, data, diskCacheKey);
             }
 
             void Cache::clear()
             {
-                _cache.clear();
+                _manager->clear(_client);
             }
 
             void Cache::_cacheUpdate()
             {
-                const auto range = _inOutPoints.getRange(_sequenceSize);
-                Frame::Index frame = _currentFrame;
-                _sequence = Frame::Sequence();
-                switch (_direction)
-                {
-                case Direction::Forward:
-                {
-                    for (size_t i = 0; i < _readBehind; ++i)
-                    {
-                        --frame;
-                        if (frame < range.min)
-                        {
-                            frame = range.max;
-                        }
-                    }
-                    _sequence.ranges.push_back(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
-                    {
-                        ++frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame > range.max)
-                        {
-                            frame = range.min;
-                            if (frame != _sequence.ranges.back().max)
-                            {
-                                _sequence.ranges.push_back(Frame::Range(frame));
-                            }
-                        }
-                        else
-                        {
-                            _sequence.ranges.back().max = frame;
-                        }
-                    }
-                    break;
-                }
-                case Direction::Reverse:
-                {
-                    for (size_t i = 0; i < _readBehind; ++i)
-                    {
-                        ++frame;
-                        if (frame > range.max)
-                        {
-                            frame = range.min;
-                        }
-                    }
-                    _sequence.ranges.push_back(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
-                    {
-                        --frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame < range.min)
-                        {
-                            frame = range.max;
-                            if (frame != _sequence.ranges.back().max)
-                            {
-                                _sequence.ranges.push_back(Frame::Range(frame));
-                            }
-                        }
-                        else
-                        {
-                            _sequence.ranges.back().min = frame;
-                        }
-                    }
-                    break;
-                }
-                default: break;
-                }
-                auto i = _cache.begin();
-                while (i != _cache.end())
-                {
-                    auto j = i;
-                    ++i;
-                    if (!_sequence.contains(j->first))
-                    {
-                        _cache.erase(j);
-                    }
-                }
+                CacheState state;
+                state.max = _max;
+                state.sequenceSize = _sequenceSize;
+                state.inOutPoints = _inOutPoints;
+                state.currentFrame = _currentFrame;
+                state.direction = _direction;
+                state.playback = _playback;
+                state.playbackSpeed = _playbackSpeed;
+                state.playbackMode = _playbackMode;
+                auto window = _policy->getWindow(state);
+                if (window == _window)
+                    return;
+                _window = std::move(window);
+                _sequence = _window.getSequence();
+                _manager->setWindow(_client, _window);
             }
 
             void IRead::_init(
@@ -370,6 +703,18 @@ namespace djv
                 _playback = value;
             }
             
+            void IRead::setPlaybackSpeed(const Time::Speed& value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _playbackSpeed = value;
+            }
+
+            void IRead::setPlaybackMode(PlaybackMode value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _playbackMode = value;
+            }
+
             void IRead::setInOutPoints(const InOutPoints& value)
             {
                 std::lock_guard<std::mutex> lock(_mutex);
@@ -416,6 +761,12 @@ namespace djv
                 _cacheMaxByteCount = value;
             }
 
+            CacheCompressionStats IRead::getCacheCompressionStats()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _cacheCompressionStats;
+            }
+
             void IWrite::_init(
                 const FileSystem::FileInfo& fileInfo,
                 const Info & info,
@@ -439,6 +790,11 @@ namespace djv
                 _context        = context;
                 _logSystem      = context->getSystemT<LogSystem>();
                 _resourceSystem = context->getSystemT<ResourceSystem>();
+                if (auto system = context->getSystemT<System>())
+                {
+                    _threadPool = system->getThreadPool();
+                    _cacheManager = system->getCacheManager();
+                }
                 _pluginName     = pluginName;
                 _pluginInfo     = pluginInfo;
                 _fileExtensions = fileExtensions;
@@ -496,6 +852,8 @@ namespace djv
             struct System::Private
             {
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
+                std::shared_ptr<ThreadPool> threadPool;
+                std::shared_ptr<CacheManager> cacheManager;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
             };
@@ -511,6 +869,34 @@ namespace djv
 
                 p.optionsChanged = ValueSubject<bool>::create();
 
+                p.threadPool = ThreadPool::create();
+                {
+                    std::stringstream ss;
+                    ss << "Thread pool size: " << p.threadPool->getThreadCount();
+                    _log(ss.str());
+                }
+                p.cacheManager = CacheManager::create();
+
+                // Create the disk cache if a scratch directory is given. The
+                // size is given in gigabytes.
+                const std::string diskCachePath = OS::getEnv("DJV_DISK_CACHE");
+                if (!diskCachePath.empty())
+                {
+                    const int diskCacheSize = OS::getIntEnv("DJV_DISK_CACHE_SIZE");
+                    const size_t diskCacheByteCount = (diskCacheSize > 0 ? diskCacheSize : 10) * Memory::gigabyte;
+                    try
+                    {
+                        p.cacheManager->setDiskCache(DiskCache::create(diskCachePath, diskCacheByteCount));
+                        std::stringstream ss;
+                        ss << "Disk cache: " << diskCachePath << ", " << diskCacheByteCount / Memory::gigabyte << "GB";
+                        _log(ss.str());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), LogLevel::Error);
+                    }
+                }
+
                 p.plugins[Cineon::pluginName] = Cineon::Plugin::create(context);
                 p.plugins[DPX::pluginName] = DPX::Plugin::create(context);
                 p.plugins[IFF::pluginName] = IFF::Plugin::create(context);
@@ -614,6 +1000,16 @@ namespace djv
                 return _p->optionsChanged;
             }
 
+            const std::shared_ptr<ThreadPool>& System::getThreadPool() const
+            {
+                return _p->threadPool;
+            }
+
+            const std::shared_ptr<CacheManager>& System::getCacheManager() const
+            {
+                return _p->cacheManager;
+            }
+
             const std::set<std::string>& System::getSequenceExtensions() const
             {
                 return _p->sequenceExtensions;
@@ -698,4 +1094,13 @@ namespace djv
 
         } // namespace IO
     } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO,
+        Proxy,
+        DJV_TEXT("None"),
+        DJV_TEXT("Half"),
+        DJV_TEXT("Quarter"),
+        DJV_TEXT("Eighth"));
+
 } // namespace djv
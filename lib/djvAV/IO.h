@@ -30,21 +30,28 @@
 #pragma once
 
 #include <djvAV/AudioData.h>
+#include <djvAV/IODiskCache.h>
 #include <djvAV/Image.h>
 #include <djvAV/Tags.h>
 
+#include <djvCore/BBox.h>
+#include <djvCore/Enum.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/ISystem.h>
 #include <djvCore/PicoJSON.h>
 #include <djvCore/Speed.h>
 #include <djvCore/Time.h>
+#include <djvCore/UID.h>
 #include <djvCore/ValueObserver.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <future>
-#include <queue>
 #include <mutex>
 #include <set>
+#include <vector>
 
 namespace djv
 {
@@ -66,6 +73,10 @@ namespace djv
         //! This namespace provides I/O functionality.
         namespace IO
         {
+            class CacheManager;
+            class ICachePolicy;
+            class ThreadPool;
+
             //! This class provides video I/O information.
             class VideoInfo
             {
@@ -130,6 +141,11 @@ namespace djv
             };
 
             //! This class provides a queue of video frames.
+            //!
+            //! The queue is a bounded lock-free ring buffer with one producer
+            //! thread and one consumer thread; frames are added and removed
+            //! without locking. For readers the producer is the reader thread
+            //! and for writers the consumer is the writer thread.
             class VideoQueue
             {
                 DJV_NON_COPYABLE(VideoQueue);
@@ -138,22 +154,68 @@ namespace djv
                 VideoQueue();
 
                 size_t getMax() const;
+
+                //! Set the maximum number of frames. This also allocates the
+                //! ring buffer so it must be called before the queue is shared
+                //! between threads.
                 void setMax(size_t);
 
-                bool isEmpty() const;
+                //! Get the number of frames, not including the frames that were
+                //! cleared.
                 size_t getCount() const;
-                VideoFrame getFrame() const;
-                void addFrame(const VideoFrame&);
+
+                //! \name Consumer
+                //! The consumer functions release the slots of the frames that
+                //! were cleared, so the producer can reuse them.
+                ///@{
+
+                bool isEmpty();
+                VideoFrame getFrame();
                 VideoFrame popFrame();
+
+                ///@}
+
+                //! \name Producer
+                ///@{
+
+                //! Add a frame. Returns false if the ring buffer is full. The
+                //! slots of the frames that were cleared are not reused until
+                //! the consumer has released them.
+                bool addFrame(const VideoFrame&);
+
+                //! Remove all of the frames. The frames are no longer counted
+                //! or returned to the consumer, and their slots are released
+                //! the next time the consumer checks the queue.
                 void clearFrames();
 
+                //! Get the frame number at the front of the queue.
+                Core::Frame::Number getFrameNumber() const;
+
+                ///@}
+
+                //! \name Control
+                //! The finished flag may be set by the producer after the last
+                //! frame has been added. Consumers should check the flag before
+                //! checking whether the queue is empty.
+                ///@{
+
                 bool isFinished() const;
                 void setFinished(bool);
 
+                ///@}
+
             private:
+                size_t _getFront() const;
+                size_t _releaseCleared();
+
                 size_t _max = 0;
-                std::queue<VideoFrame> _queue;
-                bool _finished = false;
+                size_t _mask = 0;
+                std::vector<VideoFrame> _frames;
+                std::unique_ptr<std::atomic<Core::Frame::Number>[]> _frameNumbers;
+                std::atomic<size_t> _head;
+                std::atomic<size_t> _tail;
+                std::atomic<size_t> _clear;
+                std::atomic<bool> _finished;
             };
 
             //! This class provides an audio frame.
@@ -169,6 +231,10 @@ namespace djv
             };
 
             //! This class provides a queue of audio frames.
+            //!
+            //! The queue is a bounded lock-free ring buffer with one producer
+            //! thread and one consumer thread, see VideoQueue. Popping frames
+            //! never blocks so the queue is safe to use from the audio thread.
             class AudioQueue
             {
                 DJV_NON_COPYABLE(AudioQueue);
@@ -177,23 +243,61 @@ namespace djv
                 AudioQueue();
 
                 size_t getMax() const;
+
+                //! Set the maximum number of frames. This also allocates the
+                //! ring buffer so it must be called before the queue is shared
+                //! between threads.
                 void setMax(size_t);
 
-                bool isEmpty() const;
+                //! Get the number of frames, not including the frames that were
+                //! cleared.
                 size_t getCount() const;
-                AudioFrame getFrame() const;
-                void addFrame(const AudioFrame &);
+
+                //! \name Consumer
+                //! The consumer functions release the slots of the frames that
+                //! were cleared, so the producer can reuse them.
+                ///@{
+
+                bool isEmpty();
+                AudioFrame getFrame();
                 AudioFrame popFrame();
+
+                ///@}
+
+                //! \name Producer
+                ///@{
+
+                //! Add a frame. Returns false if the ring buffer is full. The
+                //! slots of the frames that were cleared are not reused until
+                //! the consumer has released them.
+                bool addFrame(const AudioFrame&);
+
+                //! Remove all of the frames. The frames are no longer counted
+                //! or returned to the consumer, and their slots are released
+                //! the next time the consumer checks the queue.
                 void clearFrames();
 
+                ///@}
+
+                //! \name Control
+                ///@{
+
                 bool isFinished() const;
                 void setFinished(bool);
 
+                ///@}
+
             private:
-                std::mutex _mutex;
+                size_t _getFront() const;
+                size_t _releaseCleared();
+
                 size_t _max = 0;
-                std::queue<AudioFrame> _queue;
-                bool _finished = false;
+                size_t _mask = 0;
+                std::vector<AudioFrame> _frames;
+                std::atomic<size_t> _head;
+                std::atomic<size_t> _tail;
+                std::atomic<size_t> _clear;
+                std::atomic<bool> _finished;
             };
 
             //! This class provides I/O options.
@@ -219,10 +323,15 @@ namespace djv
 
                 virtual bool isRunning() const = 0;
 
+                //! Get the maximum number of jobs this object may have running
+                //! at once.
                 size_t getThreadCount() const;
+
+                //! Set the maximum number of jobs this object may have running
+                //! at once.
                 void setThreadCount(size_t);
 
-                std::mutex& getMutex();
+                //! The queues may be used without locking, see VideoQueue.
                 VideoQueue& getVideoQueue();
                 AudioQueue& getAudioQueue();
 
@@ -231,17 +340,131 @@ namespace djv
                 std::shared_ptr<Core::ResourceSystem> _resourceSystem;
                 std::shared_ptr<OCIO::System> _ocioSystem;
                 Core::FileSystem::FileInfo _fileInfo;
-                std::mutex _mutex;
+                mutable std::mutex _mutex;
                 VideoQueue _videoQueue;
                 AudioQueue _audioQueue;
                 size_t _threadCount = 4;
             };
 
+            //! This enumeration provides the proxy scales for reading.
+            enum class Proxy
+            {
+                None,
+                Half,
+                Quarter,
+                Eighth,
+
+                Count,
+                First = None
+            };
+            DJV_ENUM_HELPERS(Proxy);
+
+            //! Get the scale factor for a proxy.
+            size_t getProxyScale(Proxy);
+
             //! This class provides options for reading.
             struct ReadOptions : IOOptions
             {
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! Read images at a reduced resolution. Plugins read the
+                //! reduced images directly where the file format allows it,
+                //! otherwise the images are decimated after they are read.
+                Proxy proxy = Proxy::None;
+
+                //! Read a sub-region of the images, in pixels of the full
+                //! resolution image with the origin at the top left. An invalid
+                //! region reads the whole image. The region is clipped to the
+                //! image, and is applied before the proxy scale.
+                Core::BBox2i roi = Core::BBox2i(0, 0, 0, 0);
+
+                //! Read files with memory mapping, for the plugins that support
+                //! it. Uncompressed images then refer directly to the file
+                //! instead of being copied. Images are still copied when they
+                //! are added to the cache, so that the cache does not keep the
+                //! files open.
+                bool mmap = false;
+
+                //! The number of sequence frames that are read into memory
+                //! asynchronously ahead of being decoded, for the plugins that
+                //! support it. This keeps more reads in flight than there are
+                //! decoding threads, which helps with high-latency storage.
+                //! Zero disables reading ahead.
+                size_t readAhead = 0;
+
+                //! The maximum number of sequence frames whose files are
+                //! prefetched into the operating system cache ahead of being
+                //! decoded. The number of frames prefetched scales with the
+                //! measured time to read and decode a frame. Zero disables
+                //! prefetching.
+                size_t prefetch = 0;
+
+                //! Compress the frames that are stored in the cache, so that
+                //! more frames fit in the same amount of memory. The frames are
+                //! compressed losslessly by the decoding jobs and decompressed
+                //! when they are needed for display. This works best for images
+                //! with large flat or empty areas, like computer generated
+                //! renders.
+                bool cacheCompression = false;
+
+                //! Unpack images with 10-bit or 12-bit packed data to this type
+                //! while they are read, for the plugins that support it (DPX and
+                //! Cineon). Only the data type is used, the channels of the file
+                //! are kept and an alpha channel is added if requested. This
+                //! allows the images to be used without OpenGL. The supported data
+                //! types are U8, U16 and F16, for example Image::Type::RGB_U16,
+                //! Image::Type::RGBA_F16 or Image::Type::RGBA_U8.
+                Image::Type unpackType = Image::Type::None;
+
+                //! The number of threads used to decode each run-length encoded
+                //! image, for the plugins that support it (SGI, RLA and IFF).
+                //! The scanlines or tiles of an image are decoded in parallel
+                //! chunks. The frames of a sequence are already decoded in
+                //! parallel by the thread pool, so this is mostly useful for
+                //! reading single large images.
+                size_t rleThreadCount = 1;
+            };
+
+            //! Get the region of an image that is read, see ReadOptions::roi.
+            Core::BBox2i getReadRegion(const Image::Size&, const ReadOptions&);
+
+            //! Get the size of an image after the region of interest and proxy
+            //! scale are applied.
+            Image::Size getReadSize(const Image::Size&, const ReadOptions&);
+
+            //! Get whether the whole image is read at full resolution.
+            bool isFullRead(const Image::Size&, const ReadOptions&);
+
+            //! Split the range [0, count) into up to the given number of
+            //! chunks and call the function for each chunk in parallel. The
+            //! chunks are handled by the calling thread together with a
+            //! process wide set of worker threads, which is bounded by the
+            //! number of hardware threads. Exceptions thrown by the function
+            //! are re-thrown after all of the chunks are finished.
+            void parallelChunks(
+                size_t count,
+                size_t threadCount,
+                const std::function<void(size_t begin, size_t end)>&);
+
+            //! This struct provides statistics for compressed cache frames.
+            struct CacheCompressionStats
+            {
+                size_t   frameCount          = 0;
+                uint64_t byteCount           = 0;
+                uint64_t compressedByteCount = 0;
+                double   compressTime        = 0.0;
+                size_t   decompressCount     = 0;
+                double   decompressTime      = 0.0;
+
+                //! Get the ratio of the uncompressed to compressed sizes.
+                float getRatio() const;
+
+                //! Get the average time in seconds to compress a frame.
+                double getCompressTime() const;
+
+                //! Get the average time in seconds to decompress a frame.
+                double getDecompressTime() const;
             };
 
             //! This class provides playback in/out points.
@@ -272,27 +495,108 @@ namespace djv
                 Reverse
             };
 
+            //! This enumeration provides the playback modes for caching.
+            enum class PlaybackMode
+            {
+                Once,
+                Loop,
+                PingPong
+            };
+
+            //! This class provides a span of frames in a cache window.
+            class CacheSpan
+            {
+            public:
+                CacheSpan();
+                CacheSpan(Core::Frame::Index first, size_t count, Direction, bool readBehind = false);
+
+                //! The frames in the span.
+                Core::Frame::Range range;
+
+                //! The order the frames will be played.
+                Direction direction = Direction::Forward;
+
+                //! Whether the frames are behind the current frame rather than
+                //! ahead of it.
+                bool readBehind = false;
+
+                size_t getSize() const;
+
+                //! Get a frame by its position in playback order.
+                Core::Frame::Index getFrame(size_t) const;
+
+                bool operator == (const CacheSpan&) const;
+            };
+
+            //! This class provides the window of frames a cache should keep.
+            //! The spans are ordered from the most important to the least.
+            class CacheWindow
+            {
+            public:
+                CacheWindow();
+
+                std::vector<CacheSpan> spans;
+
+                size_t getSize() const;
+                bool contains(Core::Frame::Index) const;
+
+                //! Get the position of a frame in the window, where lower
+                //! positions are more important.
+                bool getPosition(Core::Frame::Index, size_t&) const;
+
+                //! Get the frames in the window as a sequence.
+                Core::Frame::Sequence getSequence() const;
+
+                bool operator == (const CacheWindow&) const;
+            };
+
             //! This class provides a frame cache.
+            //!
+            //! The cache uses a cache policy to compute the window of frames to
+            //! keep, and stores the images in a cache manager which may be
+            //! shared between caches to limit the total memory used. By default
+            //! each cache has its own unlimited cache manager.
             class Cache
             {
+                DJV_NON_COPYABLE(Cache);
+
             public:
                 Cache();
-                
+                ~Cache();
+
                 size_t getMax() const;
                 size_t getCount() const;
                 size_t getTotalByteCount() const;
                 Core::Frame::Sequence getFrames() const;
-                size_t getReadBehind() const;
+                const CacheWindow& getWindow() const;
                 const Core::Frame::Sequence& getSequence() const;
                 void setMax(size_t);
                 void setSequenceSize(size_t);
                 void setInOutPoints(const InOutPoints&);
                 void setDirection(Direction);
                 void setCurrentFrame(Core::Frame::Index);
+                void setPlayback(bool);
+                void setPlaybackSpeed(const Core::Time::Speed&);
+                void setPlaybackMode(PlaybackMode);
+
+                const std::shared_ptr<ICachePolicy>& getPolicy() const;
+                void setPolicy(const std::shared_ptr<ICachePolicy>&);
+
+                const std::shared_ptr<CacheManager>& getManager() const;
+
+                //! Set the cache manager. Any frames in the current cache
+                //! manager are removed.
+                void setManager(const std::shared_ptr<CacheManager>&);
+
+                //! Get the number of bytes that may be added to the cache
+                //! without evicting more important frames.
+                size_t getAvailableByteCount() const;
 
                 bool contains(Core::Frame::Index) const;
                 bool get(Core::Frame::Index, std::shared_ptr<AV::Image::Image>&) const;
-                void add(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&);
+                bool getCompressed(Core::Frame::Index, std::shared_ptr<AV::Image::CompressedData>&) const;
+                void add(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&, const DiskCacheKey& = DiskCacheKey());
+                void add(Core::Frame::Index, const std::shared_ptr<AV::Image::CompressedData>&, const DiskCacheKey& = DiskCacheKey());
                 void clear();
 
             private:
@@ -303,10 +607,14 @@ namespace djv
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
                 Core::Frame::Index _currentFrame = 0;
-                //! \todo Should this be configurable?
-                size_t _readBehind = 10;
+                bool _playback = false;
+                Core::Time::Speed _playbackSpeed;
+                PlaybackMode _playbackMode = PlaybackMode::Loop;
+                std::shared_ptr<ICachePolicy> _policy;
+                CacheWindow _window;
                 Core::Frame::Sequence _sequence;
-                std::map<Core::Frame::Index, std::shared_ptr<AV::Image::Image> > _cache;
+                std::shared_ptr<CacheManager> _manager;
+                Core::UID _client = 0;
             };
 
             //! This class provides an interface for reading.
@@ -325,12 +633,20 @@ namespace djv
                 virtual std::future<Info> getInfo() = 0;
 
                 void setPlayback(bool);
+                void setPlaybackSpeed(const Core::Time::Speed&);
+                void setPlaybackMode(PlaybackMode);
                 void setInOutPoints(const InOutPoints&);
 
                 //! \param value For video files this value represents the
                 //! frame number, for audio files it represents the audio sample.
                 virtual void seek(int64_t value, Direction) = 0;
 
+                //! Get whether the reader is still seeking, for readers whose
+                //! first frame after a seek takes noticeably longer than the
+                //! following frames (for example FFmpeg with frame threading).
+                //! The playback clock is not started until the seek is finished.
+                virtual bool isSeeking() const { return false; }
+
                 virtual bool hasCache() const { return false; }
                 bool isCacheEnabled() const;
                 size_t getCacheMaxByteCount() const;
@@ -340,16 +656,23 @@ namespace djv
                 void setCacheEnabled(bool);
                 void setCacheMaxByteCount(size_t);
 
+                //! Get the statistics for compressed cache frames, see
+                //! ReadOptions::cacheCompression.
+                CacheCompressionStats getCacheCompressionStats();
+
             protected:
                 ReadOptions _options;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
                 bool _playback = false;
+                Core::Time::Speed _playbackSpeed;
+                PlaybackMode _playbackMode = PlaybackMode::Loop;
                 bool _cacheEnabled = false;
                 size_t _cacheMaxByteCount = 0;
                 size_t _cacheByteCount = 0;
                 Core::Frame::Sequence _cacheSequence;
                 Core::Frame::Sequence _cachedFrames;
+                CacheCompressionStats _cacheCompressionStats;
                 Cache _cache;
             };
 
@@ -357,6 +680,13 @@ namespace djv
             struct WriteOptions : IOOptions
             {
                 std::string colorSpace;
+
+                //! Write large uncompressed frames bypassing the operating
+                //! system cache, for the plugins that support it (DPX and
+                //! Cineon). This keeps long conversions from evicting other
+                //! data from the cache. It uses O_DIRECT on Linux and F_NOCACHE
+                //! on macOS, and has no effect on other platforms.
+                bool directIO = false;
             };
 
             //! This class provides an interface for writing.
@@ -417,6 +747,8 @@ namespace djv
                 std::weak_ptr<Core::Context> _context;
                 std::shared_ptr<Core::LogSystem> _logSystem;
                 std::shared_ptr<Core::ResourceSystem> _resourceSystem;
+                std::shared_ptr<ThreadPool> _threadPool;
+                std::shared_ptr<CacheManager> _cacheManager;
                 std::string _pluginName;
                 std::string _pluginInfo;
                 std::set<std::string> _fileExtensions;
@@ -447,6 +779,12 @@ namespace djv
 
                 std::shared_ptr<Core::IValueSubject<bool> > observeOptionsChanged() const;
 
+                //! Get the thread pool shared by the readers.
+                const std::shared_ptr<ThreadPool>& getThreadPool() const;
+
+                //! Get the frame cache shared by the readers.
+                const std::shared_ptr<CacheManager>& getCacheManager() const;
+
                 const std::set<std::string>& getSequenceExtensions() const;
                 bool canSequence(const Core::FileSystem::FileInfo&) const;
                 bool canRead(const Core::FileSystem::FileInfo&) const;
@@ -466,6 +804,9 @@ namespace djv
 
         } // namespace IO
     } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::Proxy);
+
 } // namespace djv
 
 #include <djvAV/IOInline.h>
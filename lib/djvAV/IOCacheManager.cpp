@@ -0,0 +1,502 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/IOCacheManager.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ImageCompressedData.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                struct Entry
+                {
+                    std::shared_ptr<Image::Image> image;
+                    std::shared_ptr<Image::CompressedData> compressed;
+                    size_t byteCount = 0;
+                    size_t distance = 0;
+                    DiskCacheKey diskCacheKey;
+                };
+
+                struct Client
+                {
+                    std::map<Frame::Index, Entry> frames;
+                    size_t byteCount = 0;
+                    uint64_t lastUsed = 0;
+                    CacheWindow window;
+
+                    //! Get the distance of a frame from the start of the
+                    //! window, measured in frames in priority order.
+                    bool getDistance(Frame::Index frame, size_t& out) const
+                    {
+                        return window.getPosition(frame, out);
+                    }
+
+                    std::map<Frame::Index, Entry>::iterator getFarthest()
+                    {
+                        auto out = frames.begin();
+                        for (auto i = frames.begin(); i != frames.end(); ++i)
+                        {
+                            if (i->second.distance > out->second.distance)
+                            {
+                                out = i;
+                            }
+                        }
+                        return out;
+                    }
+
+                    void erase(std::map<Frame::Index, Entry>::iterator i)
+                    {
+                        byteCount -= i->second.byteCount;
+                        frames.erase(i);
+                    }
+                };
+
+            } // namespace
+
+            struct CacheManager::Private
+            {
+                mutable std::mutex mutex;
+                size_t maxByteCount = 0;
+                size_t byteCount = 0;
+                std::map<UID, Client> clients;
+                uint64_t tick = 0;
+                std::shared_ptr<DiskCache> diskCache;
+
+                bool add(UID, Frame::Index, Entry&);
+                void erase(Client&, std::map<Frame::Index, Entry>::iterator);
+                void spill(Client&, std::map<Frame::Index, Entry>::iterator);
+                bool makeRoom(UID, size_t byteCount, size_t distance);
+            };
+
+            void CacheManager::_init()
+            {}
+
+            CacheManager::CacheManager() :
+                _p(new Private)
+            {}
+
+            CacheManager::~CacheManager()
+            {}
+
+            std::shared_ptr<CacheManager> CacheManager::create()
+            {
+                auto out = std::shared_ptr<CacheManager>(new CacheManager);
+                out->_init();
+                return out;
+            }
+
+            size_t CacheManager::getMaxByteCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->maxByteCount;
+            }
+
+            void CacheManager::setMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxByteCount = value;
+                while (p.byteCount > p.maxByteCount)
+                {
+                    // Evict frames from the least recently used clients first.
+                    auto client = p.clients.end();
+                    for (auto i = p.clients.begin(); i != p.clients.end(); ++i)
+                    {
+                        if (i->second.frames.size() &&
+                            (client == p.clients.end() || i->second.lastUsed < client->second.lastUsed))
+                        {
+                            client = i;
+                        }
+                    }
+                    if (client == p.clients.end())
+                    {
+                        break;
+                    }
+                    p.spill(client->second, client->second.getFarthest());
+                }
+            }
+
+            size_t CacheManager::getByteCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->byteCount;
+            }
+
+            std::shared_ptr<DiskCache> CacheManager::getDiskCache() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->diskCache;
+            }
+
+            void CacheManager::setDiskCache(const std::shared_ptr<DiskCache>& value)
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                _p->diskCache = value;
+            }
+
+            UID CacheManager::addClient()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const UID out = createUID();
+                p.clients[out].lastUsed = ++p.tick;
+                return out;
+            }
+
+            void CacheManager::removeClient(UID value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(value);
+                if (i != p.clients.end())
+                {
+                    p.byteCount -= i->second.byteCount;
+                    p.clients.erase(i);
+                }
+            }
+
+            void CacheManager::touch(UID value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(value);
+                if (i != p.clients.end())
+                {
+                    i->second.lastUsed = ++p.tick;
+                }
+            }
+
+            void CacheManager::setWindow(UID uid, const CacheWindow& window)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(uid);
+                if (i != p.clients.end())
+                {
+                    auto& client = i->second;
+                    client.window = window;
+                    auto j = client.frames.begin();
+                    while (j != client.frames.end())
+                    {
+                        auto k = j;
+                        ++j;
+                        if (!client.getDistance(k->first, k->second.distance))
+                        {
+                            p.spill(client, k);
+                        }
+                    }
+                }
+            }
+
+            size_t CacheManager::getByteCount(UID uid) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(uid);
+                return i != p.clients.end() ? i->second.byteCount : 0;
+            }
+
+            size_t CacheManager::getAvailableByteCount(UID uid) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                size_t out = 0;
+                const auto i = p.clients.find(uid);
+                if (i != p.clients.end())
+                {
+                    size_t byteCount = 0;
+                    for (const auto& j : p.clients)
+                    {
+                        if (j.second.lastUsed >= i->second.lastUsed)
+                        {
+                            byteCount += j.second.byteCount;
+                        }
+                    }
+                    out = p.maxByteCount > byteCount ? (p.maxByteCount - byteCount) : 0;
+                }
+                return out;
+            }
+
+            size_t CacheManager::getCount(UID uid) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(uid);
+                return i != p.clients.end() ? i->second.frames.size() : 0;
+            }
+
+            Frame::Sequence CacheManager::getFrames(UID uid) const
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<Frame::Index> frames;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.clients.find(uid);
+                    if (i != p.clients.end())
+                    {
+                        for (const auto& j : i->second.frames)
+                        {
+                            frames.push_back(j.first);
+                        }
+                    }
+                }
+                Frame::Sequence out;
+                const size_t size = frames.size();
+                if (size)
+                {
+                    Frame::Number rangeStart = frames[0];
+                    Frame::Number prevFrame = frames[0];
+                    size_t i = 1;
+                    for (; i < size; prevFrame = frames[i], ++i)
+                    {
+                        if (frames[i] != prevFrame + 1)
+                        {
+                            out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
+                            rangeStart = frames[i];
+                        }
+                    }
+                    if (size > 1)
+                    {
+                        out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
+                    }
+                    else
+                    {
+                        out.ranges.push_back(Frame::Range(rangeStart));
+                    }
+                }
+                return out;
+            }
+
+            bool CacheManager::contains(UID uid, Frame::Index index) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(uid);
+                return i != p.clients.end() && i->second.frames.find(index) != i->second.frames.end();
+            }
+
+            bool CacheManager::get(UID uid, Frame::Index index, std::shared_ptr<AV::Image::Image>& out) const
+            {
+                DJV_PRIVATE_PTR();
+                bool found = false;
+                std::shared_ptr<Image::CompressedData> compressed;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.clients.find(uid);
+                    if (i != p.clients.end())
+                    {
+                        const auto j = i->second.frames.find(index);
+                        if (j != i->second.frames.end())
+                        {
+                            out = j->second.image;
+                            compressed = j->second.compressed;
+                            found = true;
+                        }
+                    }
+                }
+                if (compressed)
+                {
+                    // Decompress outside of the lock.
+                    out = compressed->decompress();
+                    found = out != nullptr;
+                }
+                return found;
+            }
+
+            bool CacheManager::getCompressed(UID uid, Frame::Index index, std::shared_ptr<AV::Image::CompressedData>& out) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                bool found = false;
+                const auto i = p.clients.find(uid);
+                if (i != p.clients.end())
+                {
+                    const auto j = i->second.frames.find(index);
+                    if (j != i->second.frames.end() && j->second.compressed)
+                    {
+                        out = j->second.compressed;
+                        found = true;
+                    }
+                }
+                return found;
+            }
+
+            bool CacheManager::add(
+                UID uid,
+                Frame::Index index,
+                const std::shared_ptr<AV::Image::Image>& image,
+                const DiskCacheKey& diskCacheKey)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                Entry entry;
+                entry.image = image;
+                entry.byteCount = image->getDataByteCount();
+                entry.diskCacheKey = diskCacheKey;
+                return p.add(uid, index, entry);
+            }
+
+            bool CacheManager::add(
+                UID uid,
+                Frame::Index index,
+                const std::shared_ptr<AV::Image::CompressedData>& compressed,
+                const DiskCacheKey& diskCacheKey)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                Entry entry;
+                entry.compressed = compressed;
+                entry.byteCount = compressed->getCompressedByteCount();
+                entry.diskCacheKey = diskCacheKey;
+                return p.add(uid, index, entry);
+            }
+
+            void CacheManager::clear(UID uid)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(uid);
+                if (i != p.clients.end())
+                {
+                    p.byteCount -= i->second.byteCount;
+                    i->second.byteCount = 0;
+                    i->second.frames.clear();
+                }
+            }
+
+            bool CacheManager::Private::add(UID uid, Frame::Index index, Entry& entry)
+            {
+                const auto i = clients.find(uid);
+                if (i == clients.end())
+                    return false;
+                auto& client = i->second;
+                if (entry.byteCount > maxByteCount ||
+                    !client.getDistance(index, entry.distance))
+                    return false;
+
+                // Make room for the difference in size before replacing a frame
+                // that is already cached, so a failed add does not lose it. The
+                // existing frame has the same distance so it is not evicted.
+                auto j = client.frames.find(index);
+                const size_t replaceByteCount = j != client.frames.end() ? j->second.byteCount : 0;
+                if (!makeRoom(
+                    uid,
+                    entry.byteCount > replaceByteCount ? (entry.byteCount - replaceByteCount) : 0,
+                    entry.distance))
+                    return false;
+                j = client.frames.find(index);
+                if (j != client.frames.end())
+                {
+                    erase(client, j);
+                }
+                client.byteCount += entry.byteCount;
+                byteCount += entry.byteCount;
+                client.frames[index] = entry;
+                return true;
+            }
+
+            void CacheManager::Private::erase(Client& client, std::map<Frame::Index, Entry>::iterator i)
+            {
+                byteCount -= i->second.byteCount;
+                client.erase(i);
+            }
+
+            void CacheManager::Private::spill(Client& client, std::map<Frame::Index, Entry>::iterator i)
+            {
+                // Adding the frame only queues it, the disk cache writes it
+                // on its own thread.
+                if (diskCache && !i->second.diskCacheKey.fileName.empty())
+                {
+                    if (i->second.image)
+                    {
+                        diskCache->add(i->second.diskCacheKey, i->second.image);
+                    }
+                    else
+                    {
+                        diskCache->add(i->second.diskCacheKey, i->second.compressed);
+                    }
+                }
+                erase(client, i);
+            }
+
+            bool CacheManager::Private::makeRoom(UID uid, size_t value, size_t distance)
+            {
+                if (value > maxByteCount)
+                    return false;
+                const auto& requester = clients[uid];
+                while (byteCount + value > maxByteCount)
+                {
+                    // Look for the least recently used client that was used
+                    // less recently than the requester.
+                    auto client = clients.end();
+                    for (auto i = clients.begin(); i != clients.end(); ++i)
+                    {
+                        if (i->first != uid &&
+                            i->second.frames.size() &&
+                            i->second.lastUsed < requester.lastUsed &&
+                            (client == clients.end() || i->second.lastUsed < client->second.lastUsed))
+                        {
+                            client = i;
+                        }
+                    }
+                    if (client != clients.end())
+                    {
+                        spill(client->second, client->second.getFarthest());
+                    }
+                    else
+                    {
+                        // Otherwise evict the requester's own frames if they
+                        // are less important than the new frame.
+                        auto& self = clients[uid];
+                        if (self.frames.empty())
+                            return false;
+                        const auto farthest = self.getFarthest();
+                        if (farthest->second.distance <= distance)
+                            return false;
+                        spill(self, farthest);
+                    }
+                }
+                return true;
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
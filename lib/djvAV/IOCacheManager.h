@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/IO.h>
+#include <djvAV/IODiskCache.h>
+
+#include <djvCore/UID.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides a frame cache shared by all of the readers.
+            //!
+            //! The cache is limited by the number of bytes used by the images
+            //! rather than the number of frames, so media with different
+            //! resolutions and pixel types can share the same memory budget.
+            //! Each reader registers itself as a client and provides a window
+            //! of frames ordered from most to least important. When the cache
+            //! is full the frames of the least recently used client are evicted
+            //! first, starting with the least important frames in its window.
+            //!
+            //! Frames may be stored compressed, in which case the compressed
+            //! size counts towards the memory budget.
+            //!
+            //! If a disk cache is set, frames that are evicted to make room or
+            //! that fall outside of a window are spilled to it.
+            class CacheManager : public std::enable_shared_from_this<CacheManager>
+            {
+                DJV_NON_COPYABLE(CacheManager);
+
+            protected:
+                void _init();
+                CacheManager();
+
+            public:
+                ~CacheManager();
+
+                static std::shared_ptr<CacheManager> create();
+
+                //! \name Size
+                ///@{
+
+                size_t getMaxByteCount() const;
+                void setMaxByteCount(size_t);
+
+                //! Get the number of bytes used by all of the clients.
+                size_t getByteCount() const;
+
+                ///@}
+
+                //! \name Disk Cache
+                ///@{
+
+                std::shared_ptr<DiskCache> getDiskCache() const;
+                void setDiskCache(const std::shared_ptr<DiskCache>&);
+
+                ///@}
+
+                //! \name Clients
+                ///@{
+
+                //! Add a new client. New clients are considered the most
+                //! recently used.
+                Core::UID addClient();
+
+                //! Remove a client and all of its frames.
+                void removeClient(Core::UID);
+
+                //! Mark a client as the most recently used.
+                void touch(Core::UID);
+
+                //! Set the window of frames that a client wants cached. Frames
+                //! outside of the window are removed from the cache.
+                void setWindow(Core::UID, const CacheWindow&);
+
+                //! Get the number of bytes used by a client.
+                size_t getByteCount(Core::UID) const;
+
+                //! Get the number of bytes a client may add to the cache. This
+                //! includes the free space and the space used by clients that
+                //! were used less recently.
+                size_t getAvailableByteCount(Core::UID) const;
+
+                ///@}
+
+                //! \name Frames
+                ///@{
+
+                size_t getCount(Core::UID) const;
+                Core::Frame::Sequence getFrames(Core::UID) const;
+                bool contains(Core::UID, Core::Frame::Index) const;
+
+                //! Get a frame. Compressed frames are decompressed.
+                bool get(Core::UID, Core::Frame::Index, std::shared_ptr<AV::Image::Image>&) const;
+
+                //! Get a frame if it is compressed.
+                bool getCompressed(Core::UID, Core::Frame::Index, std::shared_ptr<AV::Image::CompressedData>&) const;
+
+                //! Add a frame to the cache, evicting other frames if necessary.
+                //! Returns false if the frame is outside of the client's window
+                //! or if there are no frames less important than it to evict.
+                //! The key is used to spill the frame to the disk cache when it
+                //! is evicted; frames without a key are not spilled.
+                bool add(
+                    Core::UID,
+                    Core::Frame::Index,
+                    const std::shared_ptr<AV::Image::Image>&,
+                    const DiskCacheKey& = DiskCacheKey());
+
+                //! Add a compressed frame to the cache.
+                bool add(
+                    Core::UID,
+                    Core::Frame::Index,
+                    const std::shared_ptr<AV::Image::CompressedData>&,
+                    const DiskCacheKey& = DiskCacheKey());
+
+                void clear(Core::UID);
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
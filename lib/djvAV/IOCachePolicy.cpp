@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/IOCachePolicy.h>
+
+#include <djvCore/Math.h>
+
+#include <cmath>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            ICachePolicy::~ICachePolicy()
+            {}
+
+            CachePolicy::CachePolicy()
+            {}
+
+            std::shared_ptr<CachePolicy> CachePolicy::create()
+            {
+                return std::shared_ptr<CachePolicy>(new CachePolicy);
+            }
+
+            float CachePolicy::getReadBehind() const
+            {
+                return _readBehind;
+            }
+
+            void CachePolicy::setReadBehind(float value)
+            {
+                _readBehind = value;
+            }
+
+            CacheWindow CachePolicy::getWindow(const CacheState& state) const
+            {
+                CacheWindow out;
+                const auto range = state.inOutPoints.getRange(state.sequenceSize);
+                if (!state.sequenceSize || range.max < range.min)
+                    return out;
+                const size_t rangeSize = static_cast<size_t>(range.max - range.min + 1);
+                const size_t size = std::min(state.max, rangeSize);
+                if (!size)
+                    return out;
+                const Frame::Index currentFrame = Math::clamp(state.currentFrame, range.min, range.max);
+                const bool forward = Direction::Forward == state.direction;
+                const Direction reverse = forward ? Direction::Reverse : Direction::Forward;
+
+                // The number of frames from the current frame to the end of the
+                // range in the playback direction, including the current frame,
+                // and the number of frames behind the current frame.
+                const size_t toEnd = static_cast<size_t>(forward ?
+                    (range.max - currentFrame + 1) :
+                    (currentFrame - range.min + 1));
+                const size_t toStart = rangeSize - toEnd;
+                const Frame::Index start = forward ? range.min : range.max;
+                const Frame::Index end = forward ? range.max : range.min;
+                const Frame::Index behindFrame = forward ? (currentFrame - 1) : (currentFrame + 1);
+
+                // Split the window between the frames ahead of and behind the
+                // current frame. During playback the frames behind are only
+                // needed for scrubbing, so the amount depends on the speed.
+                size_t behind = size / 2;
+                if (state.playback)
+                {
+                    behind = std::min(
+                        behind,
+                        static_cast<size_t>(std::ceil(_readBehind * std::abs(state.playbackSpeed.toFloat()))));
+                }
+                behind = std::min(behind, size - 1);
+                if (state.playbackMode != PlaybackMode::Loop)
+                {
+                    behind = std::min(behind, toStart);
+                }
+                const size_t ahead = size - behind;
+                const size_t ahead1 = std::min(ahead, toEnd);
+                out.spans.push_back(CacheSpan(currentFrame, ahead1, state.direction));
+                switch (state.playbackMode)
+                {
+                case PlaybackMode::Loop:
+                {
+                    // Wrap around to the start of the range.
+                    const size_t ahead2 = ahead - ahead1;
+                    if (ahead2)
+                    {
+                        out.spans.push_back(CacheSpan(start, ahead2, state.direction));
+                    }
+                    const size_t behind1 = std::min(behind, toStart);
+                    if (behind1)
+                    {
+                        out.spans.push_back(CacheSpan(behindFrame, behind1, reverse, true));
+                    }
+                    const size_t behind2 = behind - behind1;
+                    if (behind2)
+                    {
+                        out.spans.push_back(CacheSpan(end, behind2, reverse, true));
+                    }
+                    break;
+                }
+                case PlaybackMode::Once:
+                case PlaybackMode::PingPong:
+                {
+                    // Frames that do not fit ahead of the current frame are used
+                    // behind it. With ping-pong these are the frames played after
+                    // turning around at the end of the range, so they are not
+                    // read behind frames.
+                    const size_t behind1 = behind + (ahead - ahead1);
+                    if (behind1)
+                    {
+                        const bool turnaround =
+                            PlaybackMode::PingPong == state.playbackMode &&
+                            state.playback &&
+                            ahead1 == toEnd;
+                        out.spans.push_back(CacheSpan(behindFrame, behind1, reverse, !turnaround));
+                    }
+                    break;
+                }
+                default: break;
+                }
+                return out;
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/IO.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This struct provides the playback state used to compute a cache
+            //! window.
+            struct CacheState
+            {
+                size_t                  max             = 0;
+                size_t                  sequenceSize    = 0;
+                InOutPoints             inOutPoints;
+                Core::Frame::Index      currentFrame    = 0;
+                Direction               direction       = Direction::Forward;
+                bool                    playback        = false;
+                Core::Time::Speed       playbackSpeed;
+                PlaybackMode            playbackMode    = PlaybackMode::Loop;
+            };
+
+            //! This class provides an interface for cache policies, which
+            //! decide which frames a cache keeps and in what order they are
+            //! read.
+            class ICachePolicy : public std::enable_shared_from_this<ICachePolicy>
+            {
+            public:
+                virtual ~ICachePolicy() = 0;
+
+                //! Get the cache window. The window must not contain more than
+                //! the maximum number of frames, and the spans must not overlap.
+                virtual CacheWindow getWindow(const CacheState&) const = 0;
+            };
+
+            //! This class provides the default cache policy.
+            //!
+            //! During playback most of the window is placed ahead of the
+            //! current frame, following the playback mode: with looping the
+            //! window wraps from the out point to the in point, and with
+            //! ping-pong it turns around at the end and continues back past the
+            //! current frame. A small amount of time is kept behind the current
+            //! frame for scrubbing. When playback is stopped the window is
+            //! centered on the current frame.
+            class CachePolicy : public ICachePolicy
+            {
+                DJV_NON_COPYABLE(CachePolicy);
+
+            protected:
+                CachePolicy();
+
+            public:
+                static std::shared_ptr<CachePolicy> create();
+
+                //! Get the amount of time kept behind the current frame during
+                //! playback, in seconds.
+                float getReadBehind() const;
+
+                //! Set the amount of time kept behind the current frame during
+                //! playback, in seconds.
+                void setReadBehind(float);
+
+                CacheWindow getWindow(const CacheState&) const override;
+
+            private:
+                float _readBehind = .5F;
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
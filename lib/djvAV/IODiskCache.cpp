@@ -0,0 +1,596 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/IODiskCache.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ImageCompressedData.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/UID.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t maxPendingByteCount = 256 * Memory::megabyte;
+
+                const char     fileMagic[]     = "DJVC";
+                const uint32_t fileVersion     = 2;
+                const size_t   dataAlignment   = 4096;
+                const char     fileExtension[] = ".djvcache";
+
+                struct Entry
+                {
+                    std::string fileName;
+                    size_t byteCount = 0;
+                    uint64_t lastUsed = 0;
+                };
+
+                struct Pending
+                {
+                    DiskCacheKey key;
+                    std::shared_ptr<Image::Image> image;
+                    std::shared_ptr<Image::CompressedData> compressed;
+                    size_t byteCount = 0;
+                };
+
+                void writeString(FileSystem::FileIO& io, const std::string& value)
+                {
+                    io.writeU32(static_cast<uint32_t>(value.size()));
+                    io.write(value.data(), value.size());
+                }
+
+                std::string readString(FileSystem::FileIO& io)
+                {
+                    uint32_t size = 0;
+                    io.readU32(&size);
+                    std::string out(size, 0);
+                    io.read(&out[0], size);
+                    return out;
+                }
+
+                void writeKey(FileSystem::FileIO& io, const DiskCacheKey& key)
+                {
+                    writeString(io, key.fileName);
+                    const int64_t time = key.time;
+                    const uint64_t layer = key.layer;
+                    const int64_t frame = key.frame;
+                    io.write(&time, 1, sizeof(int64_t));
+                    io.write(&layer, 1, sizeof(uint64_t));
+                    io.write(&frame, 1, sizeof(int64_t));
+                    writeString(io, key.variant);
+                }
+
+                DiskCacheKey readKey(FileSystem::FileIO& io)
+                {
+                    DiskCacheKey out;
+                    out.fileName = readString(io);
+                    int64_t time = 0;
+                    uint64_t layer = 0;
+                    int64_t frame = 0;
+                    io.read(&time, 1, sizeof(int64_t));
+                    io.read(&layer, 1, sizeof(uint64_t));
+                    io.read(&frame, 1, sizeof(int64_t));
+                    out.time = static_cast<time_t>(time);
+                    out.layer = static_cast<size_t>(layer);
+                    out.frame = static_cast<Frame::Index>(frame);
+                    out.variant = readString(io);
+                    return out;
+                }
+
+                size_t getDataOffset(size_t pos)
+                {
+                    return (pos + dataAlignment - 1) / dataAlignment * dataAlignment;
+                }
+
+            } // namespace
+
+            DiskCacheKey::DiskCacheKey()
+            {}
+
+            DiskCacheKey::DiskCacheKey(const std::string& fileName, time_t time, size_t layer, Frame::Index frame) :
+                fileName(fileName),
+                time(time),
+                layer(layer),
+                frame(frame)
+            {}
+
+            bool DiskCacheKey::operator == (const DiskCacheKey& other) const
+            {
+                return
+                    fileName == other.fileName &&
+                    time == other.time &&
+                    layer == other.layer &&
+                    frame == other.frame &&
+                    variant == other.variant;
+            }
+
+            bool DiskCacheKey::operator < (const DiskCacheKey& other) const
+            {
+                return std::tie(fileName, time, layer, frame, variant) <
+                    std::tie(other.fileName, other.time, other.layer, other.frame, other.variant);
+            }
+
+            struct DiskCache::Private
+            {
+                std::string path;
+
+                mutable std::mutex mutex;
+                std::map<DiskCacheKey, Entry> entries;
+                size_t maxByteCount = 0;
+                size_t byteCount = 0;
+                uint64_t tick = 0;
+
+                std::deque<Pending> pending;
+                size_t pendingByteCount = 0;
+                bool writing = false;
+                DiskCacheKey writingKey;
+                std::condition_variable pendingCV;
+                std::condition_variable flushCV;
+                std::thread thread;
+                bool running = true;
+
+                bool add(const Pending&);
+                std::string getFileName() const;
+                void write(const std::string& fileName, const DiskCacheKey&, const Image::Image&);
+                void erase(std::map<DiskCacheKey, Entry>::iterator);
+                void makeRoom();
+            };
+
+            void DiskCache::_init(const std::string& path, size_t maxByteCount)
+            {
+                DJV_PRIVATE_PTR();
+                p.path = path;
+                p.maxByteCount = maxByteCount;
+
+                // Create the directory and remove any cache files left by a
+                // previous session.
+                const FileSystem::Path fsPath(path);
+                if (!FileSystem::FileInfo(fsPath).doesExist())
+                {
+                    FileSystem::Path::mkdir(fsPath);
+                }
+                FileSystem::DirectoryListOptions options;
+                options.fileExtensions.insert(fileExtension);
+                for (const auto& i : FileSystem::FileInfo::directoryList(fsPath, options))
+                {
+                    std::remove(i.getPath().get().c_str());
+                }
+
+                p.thread = std::thread(
+                    [this]
+                    {
+                        DJV_PRIVATE_PTR();
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        while (p.running)
+                        {
+                            p.pendingCV.wait(
+                                lock,
+                                [this]
+                                {
+                                    return !_p->running || _p->pending.size();
+                                });
+                            while (p.running && p.pending.size())
+                            {
+                                const auto pending = p.pending.front();
+                                p.pending.pop_front();
+                                p.writing = true;
+                                p.writingKey = pending.key;
+                                const std::string fileName = p.getFileName();
+                                lock.unlock();
+
+                                bool ok = false;
+                                try
+                                {
+                                    const auto image = pending.image ? pending.image : pending.compressed->decompress();
+                                    if (image)
+                                    {
+                                        p.write(fileName, pending.key, *image);
+                                        ok = true;
+                                    }
+                                }
+                                catch (const std::exception&)
+                                {
+                                    // The frame is dropped, it can still be
+                                    // decoded again.
+                                }
+
+                                lock.lock();
+                                p.pendingByteCount -= pending.byteCount;
+                                p.writing = false;
+                                if (ok)
+                                {
+                                    // Replace any previous entry for the key so
+                                    // its file is removed and its size is not
+                                    // counted twice.
+                                    const auto i = p.entries.find(pending.key);
+                                    if (i != p.entries.end())
+                                    {
+                                        p.erase(i);
+                                    }
+                                    Entry entry;
+                                    entry.fileName = fileName;
+                                    entry.byteCount = pending.byteCount;
+                                    entry.lastUsed = ++p.tick;
+                                    p.byteCount += pending.byteCount;
+                                    p.entries[pending.key] = entry;
+                                    p.makeRoom();
+                                }
+                            }
+                            p.flushCV.notify_all();
+                        }
+                    });
+            }
+
+            DiskCache::DiskCache() :
+                _p(new Private)
+            {}
+
+            DiskCache::~DiskCache()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.pendingCV.notify_one();
+                if (p.thread.joinable())
+                {
+                    p.thread.join();
+                }
+                for (const auto& i : p.entries)
+                {
+                    std::remove(i.second.fileName.c_str());
+                }
+            }
+
+            std::shared_ptr<DiskCache> DiskCache::create(const std::string& path, size_t maxByteCount)
+            {
+                auto out = std::shared_ptr<DiskCache>(new DiskCache);
+                out->_init(path, maxByteCount);
+                return out;
+            }
+
+            const std::string& DiskCache::getPath() const
+            {
+                return _p->path;
+            }
+
+            size_t DiskCache::getMaxByteCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->maxByteCount;
+            }
+
+            void DiskCache::setMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxByteCount = value;
+                p.makeRoom();
+            }
+
+            size_t DiskCache::getByteCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->byteCount;
+            }
+
+            size_t DiskCache::getCount() const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->entries.size();
+            }
+
+            bool DiskCache::contains(const DiskCacheKey& key) const
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                return _p->entries.find(key) != _p->entries.end();
+            }
+
+            std::shared_ptr<Image::Image> DiskCache::get(const DiskCacheKey& key)
+            {
+                DJV_PRIVATE_PTR();
+                std::string fileName;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.entries.find(key);
+                    if (i == p.entries.end())
+                        return nullptr;
+                    i->second.lastUsed = ++p.tick;
+                    fileName = i->second.fileName;
+                }
+
+                std::shared_ptr<Image::Image> out;
+                try
+                {
+                    auto io = std::make_shared<FileSystem::FileIO>();
+                    io->setMMap(true);
+                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    char magic[4];
+                    io->read(magic, 4);
+                    uint32_t version = 0;
+                    io->readU32(&version);
+                    if (memcmp(magic, fileMagic, 4) != 0 || version != fileVersion || !(readKey(*io) == key))
+                    {
+                        throw FileSystem::Error(fileName);
+                    }
+
+                    Image::Info info;
+                    info.name = readString(*io);
+                    uint16_t size[2] = { 0, 0 };
+                    io->readU16(size, 2);
+                    info.size = Image::Size(size[0], size[1]);
+                    io->readF32(&info.pixelAspectRatio);
+                    uint8_t values[4] = { 0, 0, 0, 0 };
+                    io->readU8(values, 4);
+                    if (values[0] >= static_cast<uint8_t>(Image::Type::Count))
+                    {
+                        throw FileSystem::Error(fileName);
+                    }
+                    info.type = static_cast<Image::Type>(values[0]);
+                    info.layout.mirror.x = values[1] != 0;
+                    info.layout.mirror.y = values[2] != 0;
+                    info.layout.endian = static_cast<Memory::Endian>(values[3]);
+                    int32_t alignment = 1;
+                    io->read32(&alignment);
+                    info.layout.alignment = alignment;
+
+                    const std::string pluginName = readString(*io);
+                    uint32_t tagCount = 0;
+                    io->readU32(&tagCount);
+                    std::map<std::string, std::string> tags;
+                    for (uint32_t i = 0; i < tagCount; ++i)
+                    {
+                        const std::string tagKey = readString(*io);
+                        tags[tagKey] = readString(*io);
+                    }
+
+                    uint64_t dataByteCount = 0;
+                    io->read(&dataByteCount, 1, sizeof(uint64_t));
+                    const size_t dataOffset = getDataOffset(io->getPos());
+                    if (dataByteCount != info.getDataByteCount() ||
+                        dataOffset + dataByteCount > io->getSize())
+                    {
+                        throw FileSystem::Error(fileName);
+                    }
+                    io->setPos(dataOffset);
+                    out = Image::Image::create(info, io);
+                    out->setPluginName(pluginName);
+                    Tags imageTags;
+                    imageTags.setTags(tags);
+                    out->setTags(imageTags);
+                }
+                catch (const std::exception&)
+                {
+                    // Remove the frame so it is decoded again.
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.entries.find(key);
+                    if (i != p.entries.end())
+                    {
+                        p.erase(i);
+                    }
+                    out.reset();
+                }
+                return out;
+            }
+
+            void DiskCache::add(const DiskCacheKey& key, const std::shared_ptr<Image::Image>& image)
+            {
+                DJV_PRIVATE_PTR();
+                if (!image)
+                    return;
+                Pending pending;
+                pending.key = key;
+                pending.image = image;
+                pending.byteCount = image->getDataByteCount();
+                bool added = false;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    added = p.add(pending);
+                }
+                if (added)
+                {
+                    p.pendingCV.notify_one();
+                }
+            }
+
+            void DiskCache::add(const DiskCacheKey& key, const std::shared_ptr<Image::CompressedData>& compressed)
+            {
+                DJV_PRIVATE_PTR();
+                if (!compressed)
+                    return;
+                Pending pending;
+                pending.key = key;
+                pending.compressed = compressed;
+                pending.byteCount = compressed->getDataByteCount();
+                bool added = false;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    added = p.add(pending);
+                }
+                if (added)
+                {
+                    p.pendingCV.notify_one();
+                }
+            }
+
+            void DiskCache::flush()
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.flushCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return !_p->running || (_p->pending.empty() && !_p->writing);
+                    });
+            }
+
+            void DiskCache::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                for (const auto& i : p.pending)
+                {
+                    p.pendingByteCount -= i.byteCount;
+                }
+                p.pending.clear();
+                while (p.entries.size())
+                {
+                    p.erase(p.entries.begin());
+                }
+            }
+
+            bool DiskCache::Private::add(const Pending& value)
+            {
+                if (entries.find(value.key) != entries.end() ||
+                    (writing && writingKey == value.key) ||
+                    value.byteCount > maxByteCount ||
+                    pendingByteCount + value.byteCount > maxPendingByteCount)
+                    return false;
+                for (const auto& i : pending)
+                {
+                    if (i.key == value.key)
+                        return false;
+                }
+                pending.push_back(value);
+                pendingByteCount += value.byteCount;
+                return true;
+            }
+
+            std::string DiskCache::Private::getFileName() const
+            {
+                std::stringstream ss;
+                ss << "frame" << createUID() << fileExtension;
+                return FileSystem::Path(path, ss.str()).get();
+            }
+
+            void DiskCache::Private::write(const std::string& fileName, const DiskCacheKey& key, const Image::Image& image)
+            {
+                // Write to a temporary file first so that a partially written
+                // frame is never read.
+                const std::string tmpFileName = fileName + ".tmp";
+                try
+                {
+                    FileSystem::FileIO io;
+                    io.open(tmpFileName, FileSystem::FileIO::Mode::Write);
+                    io.write(fileMagic, 4);
+                    io.writeU32(fileVersion);
+                    writeKey(io, key);
+
+                    const auto& info = image.getInfo();
+                    writeString(io, info.name);
+                    io.writeU16(info.size.w);
+                    io.writeU16(info.size.h);
+                    io.writeF32(info.pixelAspectRatio);
+                    io.writeU8(static_cast<uint8_t>(info.type));
+                    io.writeU8(info.layout.mirror.x);
+                    io.writeU8(info.layout.mirror.y);
+                    io.writeU8(static_cast<uint8_t>(info.layout.endian));
+                    io.write32(info.layout.alignment);
+
+                    writeString(io, image.getPluginName());
+                    const auto& tags = image.getTags().getTags();
+                    io.writeU32(static_cast<uint32_t>(tags.size()));
+                    for (const auto& i : tags)
+                    {
+                        writeString(io, i.first);
+                        writeString(io, i.second);
+                    }
+
+                    // Pad the header so the image data is page aligned.
+                    const uint64_t dataByteCount = image.getDataByteCount();
+                    io.write(&dataByteCount, 1, sizeof(uint64_t));
+                    const size_t pos = io.getPos();
+                    const std::vector<uint8_t> padding(getDataOffset(pos) - pos, 0);
+                    io.write(padding.data(), padding.size());
+                    io.write(image.getData(), dataByteCount);
+                    io.close();
+
+                    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be written") << ".";
+                        throw FileSystem::Error(ss.str());
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    std::remove(tmpFileName.c_str());
+                    throw;
+                }
+            }
+
+            void DiskCache::Private::erase(std::map<DiskCacheKey, Entry>::iterator i)
+            {
+                std::remove(i->second.fileName.c_str());
+                byteCount -= i->second.byteCount;
+                entries.erase(i);
+            }
+
+            void DiskCache::Private::makeRoom()
+            {
+                while (byteCount > maxByteCount && entries.size())
+                {
+                    auto lru = entries.begin();
+                    for (auto i = entries.begin(); i != entries.end(); ++i)
+                    {
+                        if (i->second.lastUsed < lru->second.lastUsed)
+                        {
+                            lru = i;
+                        }
+                    }
+                    erase(lru);
+                }
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
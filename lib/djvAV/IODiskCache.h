@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Frame.h>
+
+#include <ctime>
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            class CompressedData;
+            class Image;
+
+        } // namespace Image
+
+        namespace IO
+        {
+            //! This struct provides the key of a frame in the disk cache.
+            struct DiskCacheKey
+            {
+                DiskCacheKey();
+                DiskCacheKey(const std::string& fileName, time_t, size_t layer, Core::Frame::Index);
+
+                std::string        fileName;
+                time_t             time      = 0;
+                size_t             layer     = 0;
+                Core::Frame::Index frame     = 0;
+
+                //! Distinguishes frames that were read with different options,
+                //! like a region of interest or proxy scale.
+                std::string        variant;
+
+                bool operator == (const DiskCacheKey&) const;
+                bool operator < (const DiskCacheKey&) const;
+            };
+
+            //! This class provides a second tier frame cache on disk.
+            //!
+            //! Frames that are evicted from the memory cache are written to a
+            //! scratch directory by a background thread instead of being
+            //! discarded, so they can be read back without decoding them again.
+            //! Each frame is stored in its own file with the image data page
+            //! aligned after a small header, so it can be memory mapped when it
+            //! is read. The frames are indexed by the file name, modification
+            //! time, layer and frame, and the least recently used frames are
+            //! removed when the cache is full.
+            //!
+            //! \todo Should the index be saved so the frames can be used by
+            //! later sessions?
+            class DiskCache : public std::enable_shared_from_this<DiskCache>
+            {
+                DJV_NON_COPYABLE(DiskCache);
+
+            protected:
+                void _init(const std::string& path, size_t maxByteCount);
+                DiskCache();
+
+            public:
+                ~DiskCache();
+
+                //! Create a new disk cache. The directory is created if it
+                //! does not exist, and cache files left in it are removed.
+                //! Throws:
+                //! - Core::FileSystem::Error
+                static std::shared_ptr<DiskCache> create(const std::string& path, size_t maxByteCount);
+
+                //! Get the scratch directory.
+                const std::string& getPath() const;
+
+                //! \name Size
+                ///@{
+
+                size_t getMaxByteCount() const;
+                void setMaxByteCount(size_t);
+
+                //! Get the number of bytes used by the frames on disk.
+                size_t getByteCount() const;
+
+                //! Get the number of frames on disk.
+                size_t getCount() const;
+
+                ///@}
+
+                //! \name Frames
+                ///@{
+
+                bool contains(const DiskCacheKey&) const;
+
+                //! Get a frame. The image data refers to the memory-mapped cache
+                //! file. Returns null if the frame is not in the cache or cannot
+                //! be read.
+                std::shared_ptr<Image::Image> get(const DiskCacheKey&);
+
+                //! Queue a frame to be written to the cache. Frames are not
+                //! queued if they are already in the cache, or if too many bytes
+                //! are waiting to be written.
+                void add(const DiskCacheKey&, const std::shared_ptr<Image::Image>&);
+
+                //! Queue a compressed frame to be written to the cache. The
+                //! frame is decompressed by the writer thread.
+                void add(const DiskCacheKey&, const std::shared_ptr<Image::CompressedData>&);
+
+                //! Wait for the queued frames to be written.
+                void flush();
+
+                //! Remove all of the frames.
+                void clear();
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -110,7 +110,11 @@ namespace djv
                 return frame == other.frame && image == other.image;
             }
 
-            inline VideoQueue::VideoQueue()
+            inline VideoQueue::VideoQueue() :
+                _head(0),
+                _tail(0),
+                _clear(0),
+                _finished(false)
             {}
 
             inline size_t VideoQueue::getMax() const
@@ -118,24 +122,36 @@ namespace djv
                 return _max;
             }
 
-            inline bool VideoQueue::isEmpty() const
+            inline size_t VideoQueue::getCount() const
             {
-                return 0 == _queue.size();
+                const size_t front = _getFront();
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                return tail > front ? (tail - front) : 0;
             }
 
-            inline size_t VideoQueue::getCount() const
+            inline Core::Frame::Number VideoQueue::getFrameNumber() const
             {
-                return _queue.size();
+                const size_t front = _getFront();
+                return front != _tail.load(std::memory_order_acquire) ?
+                    _frameNumbers[front & _mask].load(std::memory_order_relaxed) :
+                    Core::Frame::invalid;
             }
 
-            inline VideoFrame VideoQueue::getFrame() const
+            inline bool VideoQueue::isFinished() const
             {
-                return _queue.size() ? _queue.front() : VideoFrame();
+                return _finished.load(std::memory_order_acquire);
             }
 
-            inline bool VideoQueue::isFinished() const
+            inline void VideoQueue::setFinished(bool value)
+            {
+                _finished.store(value, std::memory_order_release);
+            }
+
+            inline size_t VideoQueue::_getFront() const
             {
-                return _finished;
+                return std::max(
+                    _head.load(std::memory_order_acquire),
+                    _clear.load(std::memory_order_acquire));
             }
 
             inline AudioFrame::AudioFrame()
@@ -150,7 +166,11 @@ namespace djv
                 return audio == other.audio;
             }
 
-            inline AudioQueue::AudioQueue()
+            inline AudioQueue::AudioQueue() :
+                _head(0),
+                _tail(0),
+                _clear(0),
+                _finished(false)
             {}
 
             inline size_t AudioQueue::getMax() const
@@ -158,34 +178,33 @@ namespace djv
                 return _max;
             }
 
-            inline bool AudioQueue::isEmpty() const
-            {
-                return 0 == _queue.size();
-            }
-
             inline size_t AudioQueue::getCount() const
             {
-                return _queue.size();
+                const size_t front = _getFront();
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                return tail > front ? (tail - front) : 0;
             }
 
             inline bool AudioQueue::isFinished() const
             {
-                return _finished;
+                return _finished.load(std::memory_order_acquire);
             }
 
-            inline AudioFrame AudioQueue::getFrame() const
+            inline void AudioQueue::setFinished(bool value)
             {
-                return _queue.size() ? _queue.front() : AudioFrame();
+                _finished.store(value, std::memory_order_release);
             }
 
-            inline size_t IIO::getThreadCount() const
+            inline size_t AudioQueue::_getFront() const
             {
-                return _threadCount;
+                return std::max(
+                    _head.load(std::memory_order_acquire),
+                    _clear.load(std::memory_order_acquire));
             }
 
-            inline std::mutex& IIO::getMutex()
+            inline size_t IIO::getThreadCount() const
             {
-                return _mutex;
+                return _threadCount;
             }
 
             inline VideoQueue& IIO::getVideoQueue()
@@ -198,6 +217,21 @@ namespace djv
                 return  _audioQueue;
             }
 
+            inline float CacheCompressionStats::getRatio() const
+            {
+                return compressedByteCount ? (byteCount / static_cast<float>(compressedByteCount)) : 1.F;
+            }
+
+            inline double CacheCompressionStats::getCompressTime() const
+            {
+                return frameCount ? (compressTime / frameCount) : 0.0;
+            }
+
+            inline double CacheCompressionStats::getDecompressTime() const
+            {
+                return decompressCount ? (decompressTime / decompressCount) : 0.0;
+            }
+
             inline InOutPoints::InOutPoints()
             {}
 
@@ -248,27 +282,53 @@ namespace djv
                     _out == other._out;
             }
 
-            inline Cache::Cache()
+            inline CacheSpan::CacheSpan()
             {}
-            
-            inline size_t Cache::getMax() const
+
+            inline CacheSpan::CacheSpan(Core::Frame::Index first, size_t count, Direction direction, bool readBehind) :
+                range(
+                    Direction::Forward == direction ? first : (first - static_cast<Core::Frame::Index>(count) + 1),
+                    Direction::Forward == direction ? (first + static_cast<Core::Frame::Index>(count) - 1) : first),
+                direction(direction),
+                readBehind(readBehind)
+            {}
+
+            inline size_t CacheSpan::getSize() const
             {
-                return _max;
+                return static_cast<size_t>(range.max - range.min + 1);
             }
-            
-            inline size_t Cache::getCount() const
+
+            inline Core::Frame::Index CacheSpan::getFrame(size_t value) const
             {
-                return _cache.size();
+                return Direction::Forward == direction ?
+                    (range.min + static_cast<Core::Frame::Index>(value)) :
+                    (range.max - static_cast<Core::Frame::Index>(value));
             }
 
-            inline size_t Cache::getTotalByteCount() const
+            inline bool CacheSpan::operator == (const CacheSpan& other) const
             {
-                size_t out = 0;
-                for (const auto& i : _cache)
-                {
-                    out += i.second->getDataByteCount();
-                }
-                return out;
+                return range == other.range &&
+                    direction == other.direction &&
+                    readBehind == other.readBehind;
+            }
+
+            inline CacheWindow::CacheWindow()
+            {}
+
+            inline bool CacheWindow::contains(Core::Frame::Index value) const
+            {
+                size_t position = 0;
+                return getPosition(value, position);
+            }
+
+            inline bool CacheWindow::operator == (const CacheWindow& other) const
+            {
+                return spans == other.spans;
+            }
+
+            inline size_t Cache::getMax() const
+            {
+                return _max;
             }
 
             inline const std::string & IPlugin::getPluginName() const
@@ -286,9 +346,9 @@ namespace djv
                 return _fileExtensions;
             }
 
-            inline size_t Cache::getReadBehind() const
+            inline const CacheWindow& Cache::getWindow() const
             {
-                return _readBehind;
+                return _window;
             }
 
             inline const Core::Frame::Sequence& Cache::getSequence() const
@@ -296,6 +356,16 @@ namespace djv
                 return _sequence;
             }
 
+            inline const std::shared_ptr<ICachePolicy>& Cache::getPolicy() const
+            {
+                return _policy;
+            }
+
+            inline const std::shared_ptr<CacheManager>& Cache::getManager() const
+            {
+                return _manager;
+            }
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
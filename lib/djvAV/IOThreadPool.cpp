@@ -0,0 +1,275 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/IOThreadPool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                struct Job
+                {
+                    std::function<void()> function;
+                    std::shared_ptr<CancelToken> cancelToken;
+                };
+
+                struct Client
+                {
+                    std::deque<Job> jobs[static_cast<size_t>(JobPriority::Count)];
+                    size_t running = 0;
+
+                    size_t getPendingCount() const
+                    {
+                        size_t out = 0;
+                        for (const auto& i : jobs)
+                        {
+                            out += i.size();
+                        }
+                        return out;
+                    }
+                };
+
+            } // namespace
+
+            struct ThreadPool::Private
+            {
+                std::vector<std::thread> threads;
+                mutable std::mutex mutex;
+                std::condition_variable jobCV;
+                std::condition_variable finishedCV;
+                std::map<UID, Client> clients;
+                UID currentClient = 0;
+                size_t jobCount = 0;
+                bool running = true;
+            };
+
+            void ThreadPool::_init(size_t threadCount)
+            {
+                DJV_PRIVATE_PTR();
+                if (!threadCount)
+                {
+                    threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+                }
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.threads.push_back(std::thread(
+                        [this]
+                        {
+                            _run();
+                        }));
+                }
+            }
+
+            ThreadPool::ThreadPool() :
+                _p(new Private)
+            {}
+
+            ThreadPool::~ThreadPool()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.jobCV.notify_all();
+                for (auto& i : p.threads)
+                {
+                    if (i.joinable())
+                    {
+                        i.join();
+                    }
+                }
+            }
+
+            std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+            {
+                auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+                out->_init(threadCount);
+                return out;
+            }
+
+            size_t ThreadPool::getThreadCount() const
+            {
+                return _p->threads.size();
+            }
+
+            UID ThreadPool::addClient()
+            {
+                DJV_PRIVATE_PTR();
+                const UID out = createUID();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.clients[out] = Client();
+                return out;
+            }
+
+            void ThreadPool::removeClient(UID value)
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(value);
+                if (i != p.clients.end())
+                {
+                    p.jobCount -= i->second.getPendingCount();
+                    for (auto& j : i->second.jobs)
+                    {
+                        j.clear();
+                    }
+                    p.finishedCV.wait(
+                        lock,
+                        [i]
+                        {
+                            return 0 == i->second.running;
+                        });
+                    p.clients.erase(i);
+                }
+            }
+
+            size_t ThreadPool::getJobCount(UID value) const
+            {
+                DJV_PRIVATE_PTR();
+                size_t out = 0;
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.clients.find(value);
+                if (i != p.clients.end())
+                {
+                    out = i->second.getPendingCount() + i->second.running;
+                }
+                return out;
+            }
+
+            void ThreadPool::_submit(
+                UID client,
+                JobPriority priority,
+                const std::shared_ptr<CancelToken>& cancelToken,
+                const std::function<void()>& value)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.clients.find(client);
+                    if (i == p.clients.end())
+                    {
+                        return;
+                    }
+                    Job job;
+                    job.function = value;
+                    job.cancelToken = cancelToken;
+                    i->second.jobs[static_cast<size_t>(priority)].push_back(std::move(job));
+                    ++p.jobCount;
+                }
+                p.jobCV.notify_one();
+            }
+
+            void ThreadPool::_run()
+            {
+                DJV_PRIVATE_PTR();
+                while (true)
+                {
+                    // Wait for a job.
+                    std::function<void()> job;
+                    UID client = 0;
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        p.jobCV.wait(
+                            lock,
+                            [&p]
+                            {
+                                return !p.running || p.jobCount > 0;
+                            });
+                        if (!p.running)
+                        {
+                            break;
+                        }
+
+                        // Take the highest priority job, starting with the client
+                        // after the one that was served last. Cancelled jobs are
+                        // discarded along the way.
+                        const size_t priorityCount = static_cast<size_t>(JobPriority::Count);
+                        for (size_t priority = 0; priority < priorityCount && !job; ++priority)
+                        {
+                            auto i = p.clients.upper_bound(p.currentClient);
+                            for (size_t j = 0; j < p.clients.size() && !job; ++j, ++i)
+                            {
+                                if (i == p.clients.end())
+                                {
+                                    i = p.clients.begin();
+                                }
+                                auto& jobs = i->second.jobs[priority];
+                                while (jobs.size() && !job)
+                                {
+                                    Job tmp = std::move(jobs.front());
+                                    jobs.pop_front();
+                                    --p.jobCount;
+                                    if (!tmp.cancelToken || !tmp.cancelToken->isCancelled())
+                                    {
+                                        client = i->first;
+                                        job = std::move(tmp.function);
+                                        ++i->second.running;
+                                        p.currentClient = client;
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    // Run the job.
+                    if (job)
+                    {
+                        job();
+                        job = nullptr;
+                        {
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            const auto i = p.clients.find(client);
+                            if (i != p.clients.end())
+                            {
+                                --i->second.running;
+                            }
+                        }
+                        p.finishedCV.notify_all();
+                    }
+                }
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+#include <djvCore/UID.h>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This enumeration provides the job priorities, from highest to lowest.
+            enum class JobPriority
+            {
+                Display,    //!< The frame that will be displayed next
+                Queue,      //!< Frames that fill the playback queue
+                Cache,      //!< Frames that fill the cache ahead of the current frame
+                ReadBehind, //!< Frames that fill the cache behind the current frame
+
+                Count,
+                First = Display
+            };
+
+            //! This class provides a token for cancelling jobs. Jobs that have
+            //! been cancelled are discarded by the thread pool instead of being
+            //! run, jobs that are already running are not interrupted.
+            class CancelToken
+            {
+                DJV_NON_COPYABLE(CancelToken);
+
+            protected:
+                CancelToken();
+
+            public:
+                static std::shared_ptr<CancelToken> create();
+
+                bool isCancelled() const;
+                void cancel();
+
+            private:
+                std::atomic<bool> _cancelled;
+            };
+
+            //! This class provides a pool of persistent worker threads that
+            //! readers submit decoding jobs to.
+            //!
+            //! Each reader registers itself as a client with its own job queues.
+            //! Idle workers take the highest priority job available, choosing
+            //! between clients with jobs of the same priority in round-robin
+            //! order, so one busy reader cannot starve the others and the total
+            //! number of decoding threads is bounded for the whole process.
+            class ThreadPool : public std::enable_shared_from_this<ThreadPool>
+            {
+                DJV_NON_COPYABLE(ThreadPool);
+
+            protected:
+                void _init(size_t threadCount);
+                ThreadPool();
+
+            public:
+                ~ThreadPool();
+
+                //! Create a new thread pool. If the thread count is zero the
+                //! number of hardware threads is used.
+                static std::shared_ptr<ThreadPool> create(size_t threadCount = 0);
+
+                //! Get the number of worker threads.
+                size_t getThreadCount() const;
+
+                //! \name Clients
+                ///@{
+
+                //! Add a new client.
+                Core::UID addClient();
+
+                //! Remove a client. Any pending jobs are discarded and this
+                //! function blocks until the client's running jobs are finished.
+                void removeClient(Core::UID);
+
+                //! Get the number of jobs that are pending or running for a client.
+                size_t getJobCount(Core::UID) const;
+
+                ///@}
+
+                //! Submit a job. The future of a job that is cancelled before it
+                //! runs is abandoned and must not be waited on.
+                template<typename T>
+                std::future<T> submit(
+                    Core::UID client,
+                    JobPriority,
+                    const std::shared_ptr<CancelToken>&,
+                    const std::function<T()>&);
+
+            private:
+                void _submit(
+                    Core::UID client,
+                    JobPriority,
+                    const std::shared_ptr<CancelToken>&,
+                    const std::function<void()>&);
+                void _run();
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/IOThreadPoolInline.h>
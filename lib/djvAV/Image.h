@@ -50,11 +50,10 @@ namespace djv
             public:
                 ~Image();
 
-#if defined(DJV_MMAP)
+                //! Create a new image. If a memory-mapped file is given the image
+                //! data refers to the file starting at the current position
+                //! instead of being copied.
                 static std::shared_ptr<Image> create(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>& = nullptr);
-#else // DJV_MMAP
-                static std::shared_ptr<Image> create(const Info&);
-#endif // DJV_MMAP
 
                 const std::string& getPluginName() const;
                 void setPluginName(const std::string&);
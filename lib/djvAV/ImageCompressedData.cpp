@@ -0,0 +1,437 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ImageCompressedData.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t blockByteCount = 256 * 1024;
+
+                const size_t hashBits     = 14;
+                const size_t minMatch     = 4;
+                const size_t maxOffset    = 65535;
+
+                // The LZ4 block format requires the last five bytes of a block
+                // to be literals, and the last match to start at least twelve
+                // bytes before the end of the block.
+                const size_t lastLiterals = 5;
+                const size_t matchLimit   = 12;
+
+                struct Block
+                {
+                    size_t offset        = 0;
+                    size_t byteCount     = 0;
+                    size_t dataByteCount = 0;
+                    bool   compressed    = false;
+                };
+
+                inline uint32_t read32(const uint8_t* p)
+                {
+                    uint32_t out = 0;
+                    memcpy(&out, p, sizeof(uint32_t));
+                    return out;
+                }
+
+                inline uint64_t read64(const uint8_t* p)
+                {
+                    uint64_t out = 0;
+                    memcpy(&out, p, sizeof(uint64_t));
+                    return out;
+                }
+
+                inline size_t hash(uint32_t value)
+                {
+                    return (value * 2654435761U) >> (32 - hashBits);
+                }
+
+                size_t getCompressBound(size_t value)
+                {
+                    return value + value / 255 + 16;
+                }
+
+                template<size_t STRIDE>
+                void shuffle(const uint8_t* in, size_t count, uint8_t* out)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        for (size_t j = 0; j < STRIDE; ++j)
+                        {
+                            out[j * count + i] = in[i * STRIDE + j];
+                        }
+                    }
+                }
+
+                template<size_t STRIDE>
+                void unshuffle(const uint8_t* in, size_t count, uint8_t* out)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        for (size_t j = 0; j < STRIDE; ++j)
+                        {
+                            out[i * STRIDE + j] = in[j * count + i];
+                        }
+                    }
+                }
+
+                //! Shuffle the bytes into planes. The stride is the pixel byte
+                //! count, the common sizes use templates so the compiler can
+                //! unroll and vectorize the loops.
+                void shuffle(const uint8_t* in, size_t size, size_t stride, uint8_t* out)
+                {
+                    const size_t count = size / stride;
+                    switch (stride)
+                    {
+                    case  1: memcpy(out, in, size); return;
+                    case  2: shuffle<2>(in, count, out); break;
+                    case  3: shuffle<3>(in, count, out); break;
+                    case  4: shuffle<4>(in, count, out); break;
+                    case  6: shuffle<6>(in, count, out); break;
+                    case  8: shuffle<8>(in, count, out); break;
+                    case 12: shuffle<12>(in, count, out); break;
+                    case 16: shuffle<16>(in, count, out); break;
+                    default:
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            for (size_t j = 0; j < stride; ++j)
+                            {
+                                out[j * count + i] = in[i * stride + j];
+                            }
+                        }
+                        break;
+                    }
+                    const size_t remainder = count * stride;
+                    memcpy(out + remainder, in + remainder, size - remainder);
+                }
+
+                void unshuffle(const uint8_t* in, size_t size, size_t stride, uint8_t* out)
+                {
+                    const size_t count = size / stride;
+                    switch (stride)
+                    {
+                    case  1: memcpy(out, in, size); return;
+                    case  2: unshuffle<2>(in, count, out); break;
+                    case  3: unshuffle<3>(in, count, out); break;
+                    case  4: unshuffle<4>(in, count, out); break;
+                    case  6: unshuffle<6>(in, count, out); break;
+                    case  8: unshuffle<8>(in, count, out); break;
+                    case 12: unshuffle<12>(in, count, out); break;
+                    case 16: unshuffle<16>(in, count, out); break;
+                    default:
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            for (size_t j = 0; j < stride; ++j)
+                            {
+                                out[i * stride + j] = in[j * count + i];
+                            }
+                        }
+                        break;
+                    }
+                    const size_t remainder = count * stride;
+                    memcpy(out + remainder, in + remainder, size - remainder);
+                }
+
+                void writeLength(uint8_t*& out, size_t value)
+                {
+                    while (value >= 255)
+                    {
+                        *out++ = 255;
+                        value -= 255;
+                    }
+                    *out++ = static_cast<uint8_t>(value);
+                }
+
+                bool readLength(const uint8_t*& in, const uint8_t* end, size_t& value)
+                {
+                    uint8_t byte = 255;
+                    while (255 == byte)
+                    {
+                        if (in >= end)
+                            return false;
+                        byte = *in++;
+                        value += byte;
+                    }
+                    return true;
+                }
+
+                void writeSequence(
+                    uint8_t*& out,
+                    const uint8_t* literals,
+                    size_t literalCount,
+                    size_t offset,
+                    size_t matchLength)
+                {
+                    uint8_t* token = out++;
+                    *token = static_cast<uint8_t>(std::min(literalCount, size_t(15)) << 4);
+                    if (literalCount >= 15)
+                    {
+                        writeLength(out, literalCount - 15);
+                    }
+                    memcpy(out, literals, literalCount);
+                    out += literalCount;
+                    if (matchLength)
+                    {
+                        *out++ = static_cast<uint8_t>(offset & 0xff);
+                        *out++ = static_cast<uint8_t>(offset >> 8);
+                        const size_t length = matchLength - minMatch;
+                        *token |= static_cast<uint8_t>(std::min(length, size_t(15)));
+                        if (length >= 15)
+                        {
+                            writeLength(out, length - 15);
+                        }
+                    }
+                }
+
+                //! Compress the data, the output must be at least
+                //! getCompressBound() bytes.
+                size_t lzCompress(const uint8_t* in, size_t size, uint8_t* out)
+                {
+                    std::array<uint32_t, 1 << hashBits> table;
+                    table.fill(0);
+                    const uint8_t* const end = in + size;
+                    const uint8_t* p = in;
+                    const uint8_t* anchor = in;
+                    uint8_t* const outStart = out;
+                    const uint8_t* const matchEndLimit = size > lastLiterals ? end - lastLiterals : in;
+                    size_t misses = 0;
+                    while (size >= matchLimit && p <= end - matchLimit)
+                    {
+                        const uint32_t value = read32(p);
+                        const size_t h = hash(value);
+                        const uint8_t* ref = in + table[h];
+                        table[h] = static_cast<uint32_t>(p - in);
+                        if (ref < p && static_cast<size_t>(p - ref) <= maxOffset && read32(ref) == value)
+                        {
+                            const uint8_t* matchEnd = p + minMatch;
+                            const uint8_t* refEnd = ref + minMatch;
+                            while (matchEnd + sizeof(uint64_t) <= matchEndLimit && read64(matchEnd) == read64(refEnd))
+                            {
+                                matchEnd += sizeof(uint64_t);
+                                refEnd += sizeof(uint64_t);
+                            }
+                            while (matchEnd < matchEndLimit && *matchEnd == *refEnd)
+                            {
+                                ++matchEnd;
+                                ++refEnd;
+                            }
+                            writeSequence(out, anchor, p - anchor, p - ref, matchEnd - p);
+                            p = matchEnd;
+                            anchor = p;
+                            misses = 0;
+                        }
+                        else
+                        {
+                            // Skip ahead faster through data that does not
+                            // compress.
+                            p += 1 + (misses++ >> 6);
+                        }
+                    }
+                    writeSequence(out, anchor, end - anchor, 0, 0);
+                    return out - outStart;
+                }
+
+                bool lzDecompress(const uint8_t* in, size_t size, uint8_t* out, size_t outSize)
+                {
+                    const uint8_t* const end = in + size;
+                    uint8_t* const outStart = out;
+                    uint8_t* const outEnd = out + outSize;
+                    while (in < end)
+                    {
+                        const uint8_t token = *in++;
+                        size_t literalCount = token >> 4;
+                        if (15 == literalCount && !readLength(in, end, literalCount))
+                            return false;
+                        if (literalCount > static_cast<size_t>(end - in) ||
+                            literalCount > static_cast<size_t>(outEnd - out))
+                            return false;
+                        memcpy(out, in, literalCount);
+                        in += literalCount;
+                        out += literalCount;
+                        if (in == end)
+                            break;
+
+                        if (end - in < 2)
+                            return false;
+                        const size_t offset = in[0] | (in[1] << 8);
+                        in += 2;
+                        size_t matchLength = token & 15;
+                        if (15 == matchLength && !readLength(in, end, matchLength))
+                            return false;
+                        matchLength += minMatch;
+                        if (0 == offset ||
+                            offset > static_cast<size_t>(out - outStart) ||
+                            matchLength > static_cast<size_t>(outEnd - out))
+                            return false;
+                        const uint8_t* ref = out - offset;
+                        if (offset >= matchLength)
+                        {
+                            memcpy(out, ref, matchLength);
+                        }
+                        else if (1 == offset)
+                        {
+                            memset(out, *ref, matchLength);
+                        }
+                        else
+                        {
+                            for (size_t i = 0; i < matchLength; ++i)
+                            {
+                                out[i] = ref[i];
+                            }
+                        }
+                        out += matchLength;
+                    }
+                    return out == outEnd;
+                }
+
+            } // namespace
+
+            struct CompressedData::Private
+            {
+                Info info;
+                std::string pluginName;
+                Tags tags;
+                size_t stride = 1;
+                size_t dataByteCount = 0;
+                std::vector<Block> blocks;
+                std::vector<uint8_t> data;
+            };
+
+            void CompressedData::_init(const Image& image)
+            {
+                DJV_PRIVATE_PTR();
+                p.info = image.getInfo();
+                p.pluginName = image.getPluginName();
+                p.tags = image.getTags();
+                p.stride = std::max(p.info.getPixelByteCount(), size_t(1));
+                p.dataByteCount = image.getDataByteCount();
+
+                // Keep the blocks a multiple of the pixel size so the byte
+                // planes line up.
+                const size_t blockSize = std::max(blockByteCount / p.stride, size_t(1)) * p.stride;
+                std::vector<uint8_t> shuffled(std::min(blockSize, p.dataByteCount));
+                std::vector<uint8_t> data(getCompressBound(p.dataByteCount));
+                const uint8_t* in = image.getData();
+                size_t offset = 0;
+                for (size_t i = 0; i < p.dataByteCount; i += blockSize)
+                {
+                    Block block;
+                    block.offset = offset;
+                    block.dataByteCount = std::min(blockSize, p.dataByteCount - i);
+                    shuffle(in + i, block.dataByteCount, p.stride, shuffled.data());
+                    block.byteCount = lzCompress(shuffled.data(), block.dataByteCount, data.data() + offset);
+                    block.compressed = block.byteCount < block.dataByteCount;
+                    if (!block.compressed)
+                    {
+                        block.byteCount = block.dataByteCount;
+                        memcpy(data.data() + offset, in + i, block.dataByteCount);
+                    }
+                    offset += block.byteCount;
+                    p.blocks.push_back(block);
+                }
+                p.data = std::vector<uint8_t>(data.begin(), data.begin() + offset);
+            }
+
+            CompressedData::CompressedData() :
+                _p(new Private)
+            {}
+
+            CompressedData::~CompressedData()
+            {}
+
+            std::shared_ptr<CompressedData> CompressedData::create(const Image& image)
+            {
+                auto out = std::shared_ptr<CompressedData>(new CompressedData);
+                out->_init(image);
+                return out;
+            }
+
+            const Info& CompressedData::getInfo() const
+            {
+                return _p->info;
+            }
+
+            size_t CompressedData::getDataByteCount() const
+            {
+                return _p->dataByteCount;
+            }
+
+            size_t CompressedData::getCompressedByteCount() const
+            {
+                return _p->data.size();
+            }
+
+            float CompressedData::getRatio() const
+            {
+                return _p->data.size() ?
+                    (_p->dataByteCount / static_cast<float>(_p->data.size())) :
+                    1.F;
+            }
+
+            std::shared_ptr<Image> CompressedData::decompress() const
+            {
+                DJV_PRIVATE_PTR();
+                auto out = Image::create(p.info);
+                out->setPluginName(p.pluginName);
+                out->setTags(p.tags);
+                uint8_t* outP = out->getData();
+                std::vector<uint8_t> shuffled;
+                size_t outOffset = 0;
+                for (const auto& block : p.blocks)
+                {
+                    const uint8_t* in = p.data.data() + block.offset;
+                    if (block.compressed)
+                    {
+                        shuffled.resize(block.dataByteCount);
+                        if (!lzDecompress(in, block.byteCount, shuffled.data(), block.dataByteCount))
+                            return nullptr;
+                        unshuffle(shuffled.data(), block.dataByteCount, p.stride, outP + outOffset);
+                    }
+                    else
+                    {
+                        memcpy(outP + outOffset, in, block.dataByteCount);
+                    }
+                    outOffset += block.dataByteCount;
+                }
+                return out;
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/Image.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This class provides losslessly compressed image data.
+            //!
+            //! The data is split into blocks which are compressed separately.
+            //! The bytes of each block are first shuffled into planes, so that
+            //! the same byte of every pixel is stored together, and then
+            //! compressed with a fast LZ77 codec using the LZ4 block format.
+            //! This works well for images with large flat or empty areas, and
+            //! is fast enough to decompress frames during playback. Blocks
+            //! that do not compress are stored as they are.
+            class CompressedData
+            {
+                DJV_NON_COPYABLE(CompressedData);
+
+            protected:
+                void _init(const Image&);
+                CompressedData();
+
+            public:
+                ~CompressedData();
+
+                //! Compress an image.
+                static std::shared_ptr<CompressedData> create(const Image&);
+
+                const Info& getInfo() const;
+
+                //! Get the number of bytes in the uncompressed image data.
+                size_t getDataByteCount() const;
+
+                //! Get the number of bytes in the compressed image data.
+                size_t getCompressedByteCount() const;
+
+                //! Get the ratio of the uncompressed to compressed sizes.
+                float getRatio() const;
+
+                //! Decompress the image. Returns null if the compressed data is
+                //! not valid.
+                std::shared_ptr<Image> decompress() const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -29,8 +29,12 @@
 
 #include <djvAV/ImageData.h>
 
+#include <djvAV/ImageDataPool.h>
+
 #include <djvCore/FileIO.h>
 
+#include <algorithm>
+
 namespace djv
 {
     namespace AV
@@ -44,76 +48,55 @@ namespace djv
                 _pixelByteCount = info.getPixelByteCount();
                 _scanlineByteCount = info.getScanlineByteCount();
                 _dataByteCount = info.getDataByteCount();
-#if defined(DJV_MMAP)
-                _fileIO = fileIO;
-                if (_fileIO)
+                _pool = DataPool::getGlobal();
+                if (fileIO && fileIO->isMMap())
                 {
+                    _fileIO = fileIO;
                     _p = _fileIO->mmapP();
+
+                    // Copy the data if the file is too small to hold it.
+                    if (static_cast<size_t>(_fileIO->mmapEnd() - _p) < _dataByteCount)
+                    {
+                        detach();
+                    }
                 }
                 else if (_dataByteCount)
                 {
-                    _data = new uint8_t[_dataByteCount];
-                    _p = _data;
-                }
-#else // DJV_MMAP
-                if (_dataByteCount)
-                {
-                    _data = new uint8_t[_dataByteCount];
+                    _data = _pool->allocate(_dataByteCount);
                     _p = _data;
                 }
-#endif // DJV_MMAP
             }
 
             Data::~Data()
             {
-                delete[] _data;
+                _pool->release(_data, _dataByteCount);
             }
 
-#if defined(DJV_MMAP)
             std::shared_ptr<Data> Data::create(const Info& info, const std::shared_ptr<Core::FileSystem::FileIO>& fileIO)
             {
                 auto out = std::shared_ptr<Data>(new Data);
                 out->_init(info, fileIO);
                 return out;
             }
-#else // DJV_MMAP
-            std::shared_ptr<Data> Data::create(const Info& info)
-            {
-                auto out = std::shared_ptr<Data>(new Data);
-                out->_init(info, nullptr);
-                return out;
-            }
-#endif // DJV_MMAP
-
-            size_t Data::getDataByteCount() const
-            {
-#if defined(DJV_MMAP)
-                return _fileIO ? (_fileIO->getSize() - _fileIO->getPos()) : _dataByteCount;
-#else
-                return _dataByteCount;
-#endif // DJV_MMAP
-            }
 
             void Data::zero()
             {
-#if defined(DJV_MMAP)
                 detach();
-#endif // DJV_MMAP
                 memset(_data, 0, _dataByteCount);
             }
 
-#if defined(DJV_MMAP)
             void Data::detach()
             {
                 if (_fileIO)
                 {
-                    _data = new uint8_t[_dataByteCount];
-                    memcpy(_data, _fileIO->mmapP(), std::min(_fileIO->getSize() - _fileIO->getPos(), _dataByteCount));
+                    _data = _pool->allocate(_dataByteCount);
+                    const size_t size = std::min(static_cast<size_t>(_fileIO->mmapEnd() - _p), _dataByteCount);
+                    memcpy(_data, _p, size);
+                    memset(_data + size, 0, _dataByteCount - size);
                     _p = _data;
                     _fileIO.reset();
                 }
             }
-#endif // DJV_MMAP
 
             bool Data::operator == (const Data& other) const
             {
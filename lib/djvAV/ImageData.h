@@ -52,6 +52,8 @@ namespace djv
     {
         namespace Image
         {
+            class DataPool;
+
             //! This struct provides information about mirroring the image.
             class Mirror
             {
@@ -126,6 +128,11 @@ namespace djv
             };
 
             //! This struct provides image data.
+            //!
+            //! The pixel data is allocated from the global data pool, and
+            //! returned to the pool when the image data is destroyed. The data
+            //! may also refer to a memory-mapped file, in which case it is
+            //! copied the first time it is modified.
             class Data
             {
                 DJV_NON_COPYABLE(Data);
@@ -137,11 +144,10 @@ namespace djv
             public:
                 ~Data();
 
-#if defined(DJV_MMAP)
+                //! Create new image data. If a memory-mapped file is given the
+                //! data refers to the file starting at the current position
+                //! instead of being copied.
                 static std::shared_ptr<Data> create(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>& = nullptr);
-#else // DJV_MMAP
-                static std::shared_ptr<Data> create(const Info&);
-#endif // DJV_MMAP
 
                 Core::UID getUID() const;
 
@@ -170,9 +176,12 @@ namespace djv
 
                 void zero();
 
-#if defined(DJV_MMAP)
+                //! Get whether the data refers to a memory-mapped file.
+                bool isMMap() const;
+
+                //! Copy the data from the memory-mapped file so that the file
+                //! can be closed.
                 void detach();
-#endif // DJV_MMAP
 
                 bool operator == (const Data&) const;
                 bool operator != (const Data&) const;
@@ -183,11 +192,10 @@ namespace djv
                 uint8_t _pixelByteCount = 0;
                 size_t _scanlineByteCount = 0;
                 size_t _dataByteCount = 0;
+                std::shared_ptr<DataPool> _pool;
                 uint8_t* _data = nullptr;
                 const uint8_t* _p = nullptr;
-#if defined(DJV_MMAP)
                 std::shared_ptr<Core::FileSystem::FileIO> _fileIO;
-#endif // DJV_MMAP
             };
 
         } // namespace Image
@@ -228,6 +228,11 @@ namespace djv
                 return _scanlineByteCount;
             }
 
+            inline size_t Data::getDataByteCount() const
+            {
+                return _dataByteCount;
+            }
+
             inline const uint8_t* Data::getData() const
             {
                 return _p;
@@ -243,27 +248,26 @@ namespace djv
                 return _p + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
 
+            inline bool Data::isMMap() const
+            {
+                return _fileIO.get() != nullptr;
+            }
+
             inline uint8_t* Data::getData()
             {
-#if defined(DJV_MMAP)
                 detach();
-#endif // DJV_MMAP
                 return _data;
             }
 
             inline uint8_t* Data::getData(uint16_t y)
             {
-#if defined(DJV_MMAP)
                 detach();
-#endif // DJV_MMAP
                 return _data + y * _scanlineByteCount;
             }
 
             inline uint8_t* Data::getData(uint16_t x, uint16_t y)
             {
-#if defined(DJV_MMAP)
                 detach();
-#endif // DJV_MMAP
                 return _data + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
 
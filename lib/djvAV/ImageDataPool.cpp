@@ -0,0 +1,309 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ImageDataPool.h>
+
+#if defined(DJV_PLATFORM_WINDOWS)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <malloc.h>
+#include <windows.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <unistd.h>
+#endif // DJV_PLATFORM_WINDOWS
+
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <new>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t highWaterMarkDefault = 1024 * 1024 * 1024;
+
+                size_t getPageSize()
+                {
+                    static const size_t out = []
+                    {
+#if defined(DJV_PLATFORM_WINDOWS)
+                        SYSTEM_INFO info;
+                        GetSystemInfo(&info);
+                        return static_cast<size_t>(info.dwPageSize);
+#else // DJV_PLATFORM_WINDOWS
+                        const long pageSize = sysconf(_SC_PAGESIZE);
+                        return pageSize > 0 ? static_cast<size_t>(pageSize) : static_cast<size_t>(4096);
+#endif // DJV_PLATFORM_WINDOWS
+                    }();
+                    return out;
+                }
+
+                uint8_t* alignedAlloc(size_t byteCount)
+                {
+                    void* out = nullptr;
+#if defined(DJV_PLATFORM_WINDOWS)
+                    out = _aligned_malloc(byteCount, getPageSize());
+#else // DJV_PLATFORM_WINDOWS
+                    if (posix_memalign(&out, getPageSize(), byteCount) != 0)
+                    {
+                        out = nullptr;
+                    }
+#endif // DJV_PLATFORM_WINDOWS
+                    if (!out)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    return reinterpret_cast<uint8_t*>(out);
+                }
+
+                void alignedFree(uint8_t* value)
+                {
+#if defined(DJV_PLATFORM_WINDOWS)
+                    _aligned_free(value);
+#else // DJV_PLATFORM_WINDOWS
+                    free(value);
+#endif // DJV_PLATFORM_WINDOWS
+                }
+
+                struct Buffer
+                {
+                    size_t sizeClass = 0;
+                    uint8_t* data = nullptr;
+                };
+
+            } // namespace
+
+            struct DataPool::Private
+            {
+                mutable std::mutex mutex;
+                size_t highWaterMark = highWaterMarkDefault;
+                bool prefault = false;
+                size_t usedByteCount = 0;
+                size_t freeByteCount = 0;
+
+                //! The released buffers, from least to most recently released.
+                std::list<Buffer> buffers;
+
+                void trim(size_t);
+            };
+
+            DataPool::DataPool() :
+                _p(new Private)
+            {}
+
+            DataPool::~DataPool()
+            {
+                DJV_PRIVATE_PTR();
+                for (const auto& i : p.buffers)
+                {
+                    alignedFree(i.data);
+                }
+            }
+
+            std::shared_ptr<DataPool> DataPool::create()
+            {
+                return std::shared_ptr<DataPool>(new DataPool);
+            }
+
+            const std::shared_ptr<DataPool>& DataPool::getGlobal()
+            {
+                static const std::shared_ptr<DataPool> global = DataPool::create();
+                return global;
+            }
+
+            uint8_t* DataPool::allocate(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                const size_t sizeClass = getSizeClass(value);
+                if (!sizeClass)
+                    return nullptr;
+                bool prefault = false;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.usedByteCount += sizeClass;
+                    for (auto i = p.buffers.rbegin(); i != p.buffers.rend(); ++i)
+                    {
+                        if (sizeClass == i->sizeClass)
+                        {
+                            uint8_t* out = i->data;
+                            p.freeByteCount -= sizeClass;
+                            p.buffers.erase(std::next(i).base());
+                            return out;
+                        }
+                    }
+                    prefault = p.prefault;
+                }
+                uint8_t* out = nullptr;
+                try
+                {
+                    out = alignedAlloc(sizeClass);
+                }
+                catch (const std::bad_alloc&)
+                {
+                    // Free the released buffers and try again.
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        p.trim(0);
+                    }
+                    try
+                    {
+                        out = alignedAlloc(sizeClass);
+                    }
+                    catch (const std::bad_alloc&)
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        p.usedByteCount -= sizeClass;
+                        throw;
+                    }
+                }
+                if (prefault)
+                {
+                    // Write one byte per page so the operating system maps
+                    // the pages now instead of when the decoder first writes
+                    // to them.
+                    const size_t pageSize = getPageSize();
+                    for (size_t i = 0; i < sizeClass; i += pageSize)
+                    {
+                        out[i] = 0;
+                    }
+                }
+                return out;
+            }
+
+            void DataPool::release(uint8_t* data, size_t value)
+            {
+                if (!data)
+                    return;
+                DJV_PRIVATE_PTR();
+                const size_t sizeClass = getSizeClass(value);
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.usedByteCount -= sizeClass;
+                if (sizeClass <= p.highWaterMark)
+                {
+                    p.trim(p.highWaterMark - sizeClass);
+                    Buffer buffer;
+                    buffer.sizeClass = sizeClass;
+                    buffer.data = data;
+                    p.buffers.push_back(buffer);
+                    p.freeByteCount += sizeClass;
+                }
+                else
+                {
+                    alignedFree(data);
+                }
+            }
+
+            void DataPool::trim()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.trim(0);
+            }
+
+            size_t DataPool::getHighWaterMark() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.highWaterMark;
+            }
+
+            void DataPool::setHighWaterMark(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.highWaterMark = value;
+                p.trim(value);
+            }
+
+            bool DataPool::hasPrefault() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.prefault;
+            }
+
+            void DataPool::setPrefault(bool value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.prefault = value;
+            }
+
+            size_t DataPool::getSizeClass(size_t value)
+            {
+                const size_t pageSize = getPageSize();
+                return (value + pageSize - 1) / pageSize * pageSize;
+            }
+
+            size_t DataPool::getUsedByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.usedByteCount;
+            }
+
+            size_t DataPool::getFreeByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.freeByteCount;
+            }
+
+            size_t DataPool::getFreeCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.buffers.size();
+            }
+
+            void DataPool::Private::trim(size_t value)
+            {
+                while (freeByteCount > value && buffers.size())
+                {
+                    const auto& buffer = buffers.front();
+                    alignedFree(buffer.data);
+                    freeByteCount -= buffer.sizeClass;
+                    buffers.pop_front();
+                }
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This class provides a pool of recycled image data buffers.
+            //!
+            //! Buffers are page aligned and grouped into size classes by their
+            //! byte count rounded up to the page size. Released buffers are
+            //! kept for reuse instead of being returned to the operating
+            //! system, which avoids the allocation and page fault cost of
+            //! large images. When the released buffers exceed the high-water
+            //! mark the least recently released buffers are freed.
+            class DataPool : public std::enable_shared_from_this<DataPool>
+            {
+                DJV_NON_COPYABLE(DataPool);
+
+            protected:
+                DataPool();
+
+            public:
+                ~DataPool();
+
+                static std::shared_ptr<DataPool> create();
+
+                //! Get the pool shared by all of the image data.
+                static const std::shared_ptr<DataPool>& getGlobal();
+
+                //! \name Allocation
+                ///@{
+
+                //! Get a buffer with at least the given number of bytes. The
+                //! contents of the buffer are undefined.
+                uint8_t* allocate(size_t);
+
+                //! Return a buffer to the pool. The byte count must be the
+                //! same as the value given to allocate().
+                void release(uint8_t*, size_t);
+
+                //! Free all of the released buffers.
+                void trim();
+
+                ///@}
+
+                //! \name Options
+                ///@{
+
+                //! Get the maximum number of bytes kept in released buffers.
+                size_t getHighWaterMark() const;
+
+                //! Set the maximum number of bytes kept in released buffers.
+                void setHighWaterMark(size_t);
+
+                //! Get whether new buffers are touched when they are
+                //! allocated, so that the page faults happen before the buffer
+                //! is used.
+                bool hasPrefault() const;
+
+                void setPrefault(bool);
+
+                ///@}
+
+                //! \name Information
+                ///@{
+
+                //! Get the size class of a byte count.
+                static size_t getSizeClass(size_t);
+
+                //! Get the number of bytes in buffers that are in use.
+                size_t getUsedByteCount() const;
+
+                //! Get the number of bytes in buffers that have been released.
+                size_t getFreeByteCount() const;
+
+                //! Get the number of buffers that have been released.
+                size_t getFreeCount() const;
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -30,7 +30,10 @@
 #include <djvAV/ImageUtil.h>
 
 #include <djvAV/Color.h>
-#include <djvAV/ImageData.h>
+#include <djvAV/Image.h>
+
+#include <algorithm>
+#include <cstring>
 
 using namespace djv::Core;
 
@@ -84,6 +87,36 @@ namespace djv
                     outP->b = average[2] / static_cast<float>(width * height);
                 }
 
+                template<size_t N>
+                void decimateScanline(const uint8_t* in, uint8_t* out, size_t count, ptrdiff_t inStride, ptrdiff_t outStride)
+                {
+                    for (size_t i = 0; i < count; ++i, in += inStride, out += outStride)
+                    {
+                        memcpy(out, in, N);
+                    }
+                }
+
+                void decimateScanline(const uint8_t* in, uint8_t* out, size_t count, ptrdiff_t inStride, ptrdiff_t outStride, size_t pixelByteCount)
+                {
+                    switch (pixelByteCount)
+                    {
+                    case  1: decimateScanline<1>(in, out, count, inStride, outStride); break;
+                    case  2: decimateScanline<2>(in, out, count, inStride, outStride); break;
+                    case  3: decimateScanline<3>(in, out, count, inStride, outStride); break;
+                    case  4: decimateScanline<4>(in, out, count, inStride, outStride); break;
+                    case  6: decimateScanline<6>(in, out, count, inStride, outStride); break;
+                    case  8: decimateScanline<8>(in, out, count, inStride, outStride); break;
+                    case 12: decimateScanline<12>(in, out, count, inStride, outStride); break;
+                    case 16: decimateScanline<16>(in, out, count, inStride, outStride); break;
+                    default:
+                        for (size_t i = 0; i < count; ++i, in += inStride, out += outStride)
+                        {
+                            memcpy(out, in, pixelByteCount);
+                        }
+                        break;
+                    }
+                }
+
             } // namespace
 
             Color getAverageColor(const std::shared_ptr<Data>& data)
@@ -111,6 +144,62 @@ namespace djv
                 return out;
             }
 
+            std::shared_ptr<Image> decimate(const std::shared_ptr<Image>& image, const BBox2i& value, size_t scale)
+            {
+                std::shared_ptr<Image> out;
+                if (image)
+                {
+                    const Image& in = *image;
+                    const auto& info = in.getInfo();
+                    const BBox2i bbox(0, 0, info.size.w, info.size.h);
+                    const BBox2i region = value.intersect(bbox);
+                    const int s = static_cast<int>(std::max(scale, static_cast<size_t>(1)));
+                    auto outInfo = info;
+                    if (region.min.x <= region.max.x && region.min.y <= region.max.y)
+                    {
+                        outInfo.size.w = static_cast<uint16_t>((region.w() + s - 1) / s);
+                        outInfo.size.h = static_cast<uint16_t>((region.h() + s - 1) / s);
+                    }
+                    else
+                    {
+                        outInfo.size = Size();
+                    }
+                    out = Image::create(outInfo);
+                    out->setPluginName(image->getPluginName());
+                    out->setTags(image->getTags());
+                    const size_t pixelByteCount = info.getPixelByteCount();
+                    const bool mirrorX = info.layout.mirror.x;
+                    const bool mirrorY = info.layout.mirror.y;
+                    for (uint16_t y = 0; y < outInfo.size.h; ++y)
+                    {
+                        // Convert the display coordinates to the data coordinates.
+                        const int inY = region.min.y + y * s;
+                        const uint8_t* inP = in.getData(
+                            mirrorX ? (info.size.w - 1 - region.min.x) : region.min.x,
+                            mirrorY ? (info.size.h - 1 - inY) : inY);
+                        uint8_t* outP = out->getData(
+                            mirrorX ? (outInfo.size.w - 1) : 0,
+                            mirrorY ? (outInfo.size.h - 1 - y) : y);
+                        const ptrdiff_t inStride = static_cast<ptrdiff_t>(pixelByteCount) * s;
+                        if (1 == s && !mirrorX)
+                        {
+                            memcpy(outP, inP, outInfo.size.w * pixelByteCount);
+                        }
+                        else
+                        {
+                            decimateScanline(
+                                inP,
+                                outP,
+                                outInfo.size.w,
+                                mirrorX ? -inStride : inStride,
+                                mirrorX ? -static_cast<ptrdiff_t>(pixelByteCount) : static_cast<ptrdiff_t>(pixelByteCount),
+                                pixelByteCount);
+                        }
+                    }
+                }
+                return out;
+            }
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
@@ -31,6 +31,8 @@
 
 #include <djvAV/AV.h>
 
+#include <djvCore/BBox.h>
+
 #include <memory>
 
 namespace djv
@@ -41,9 +43,17 @@ namespace djv
         {
             class Color;
             class Data;
+            class Image;
 
             Color getAverageColor(const std::shared_ptr<Data>&);
 
+            //! Copy a region of an image, keeping every Nth pixel. The region
+            //! is given in pixels with the origin at the top left, and is
+            //! clipped to the image. The pixels are point sampled so this works
+            //! with any pixel type. The image layout, plugin name, and tags are
+            //! preserved.
+            std::shared_ptr<Image> decimate(const std::shared_ptr<Image>&, const Core::BBox2i&, size_t scale = 1);
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
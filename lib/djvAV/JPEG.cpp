@@ -77,7 +77,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _cacheManager, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
@@ -120,6 +120,7 @@ namespace djv
             ss << value.quality;
             out.get<picojson::object>()["Quality"] = picojson::value(ss.str());
         }
+        out.get<picojson::object>()["FastDecode"] = toJSON(value.fastDecode);
         return out;
     }
 
@@ -134,6 +135,10 @@ namespace djv
                     std::stringstream ss(i.second.get<std::string>());
                     ss >> out.quality;
                 }
+                else if ("FastDecode" == i.first)
+                {
+                    fromJSON(i.second, out.fastDecode);
+                }
             }
         }
         else
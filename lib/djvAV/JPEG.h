@@ -61,6 +61,10 @@ namespace djv
                 struct Options
                 {
                     int quality = 90;
+
+                    //! Decode with the fast integer IDCT and without fancy
+                    //! upsampling, for preview quality images.
+                    bool fastDecode = false;
                 };
 
                 //! This struct provides libjpeg error handling.
@@ -85,16 +89,22 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const Options&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    bool _hasProxy() const override;
 
                 private:
                     struct File;
-                    Info _open(const std::string &, File &);
+                    Info _open(const std::string &, File &, Proxy);
+
+                    DJV_PRIVATE();
                 };
                 
                 //! This class provides the JPEG file writer.
@@ -33,6 +33,8 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
+#include <algorithm>
+
 using namespace djv::Core;
 
 namespace djv
@@ -70,7 +72,13 @@ namespace djv
                     JPEGErrorStruct        jpegError;
                 };
 
-                Read::Read()
+                struct Read::Private
+                {
+                    Options options;
+                };
+
+                Read::Read() :
+                    _p(new Private)
                 {}
 
                 Read::~Read()
@@ -81,33 +89,39 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_p->options = options;
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     File f;
-                    return _open(fileName, f);
+                    return _open(fileName, f, Proxy::None);
                 }
 
                 namespace
                 {
-                    bool jpegScanline(
+                    bool jpegScanlines(
                         jpeg_decompress_struct * jpeg,
-                        uint8_t *                out,
+                        JSAMPARRAY               rows,
+                        JDIMENSION               count,
+                        JDIMENSION &             read,
                         JPEGErrorStruct *        error)
                     {
                         if (::setjmp(error->jump))
                         {
                             return false;
                         }
-                        JSAMPROW p[] = { (JSAMPLE *)(out) };
-                        if (!jpeg_read_scanlines(jpeg, p, 1))
+                        read = jpeg_read_scanlines(jpeg, rows, count);
+                        if (!read)
                         {
                             return false;
                         }
@@ -122,7 +136,16 @@ namespace djv
                         {
                             return false;
                         }
-                        jpeg_finish_decompress(jpeg);
+                        if (jpeg->output_scanline < jpeg->output_height)
+                        {
+                            // Stop early when the remaining scanlines are not
+                            // needed.
+                            jpeg_abort_decompress(jpeg);
+                        }
+                        else
+                        {
+                            jpeg_finish_decompress(jpeg);
+                        }
                         return true;
                     }
 
@@ -132,17 +155,63 @@ namespace djv
                 {
                     std::shared_ptr<Image::Image> out;
                     File f;
-                    const auto info = _open(fileName, f);
+                    const auto info = _open(fileName, f, _options.proxy);
                     if (info.video.size())
                     {
-                        out = Image::Image::create(info.video[0].info);
+                        // The proxy scale is applied by libjpeg when the DCT
+                        // coefficients are decoded, so only the region of
+                        // interest needs to be copied here.
+                        const auto& fileInfo = info.video[0].info;
+                        const int scale = static_cast<int>(getProxyScale(_options.proxy));
+                        const BBox2i region = getReadRegion(fileInfo.size, _options);
+                        auto imageInfo = fileInfo;
+                        imageInfo.size = getReadSize(fileInfo.size, _options);
+                        out = Image::Image::create(imageInfo);
                         out->setPluginName(pluginName);
-                        for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
+                        const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                        const size_t x = std::min(
+                            static_cast<size_t>(region.min.x / scale),
+                            static_cast<size_t>(f.jpeg.output_width - imageInfo.size.w));
+                        const size_t y = static_cast<size_t>(region.min.y / scale);
+                        const bool crop = x != 0 || imageInfo.size.w != f.jpeg.output_width;
+
+                        // Read as many scanlines per call as libjpeg produces at
+                        // once, directly into the image unless they are cropped or
+                        // above the region of interest.
+                        const size_t rowCount = static_cast<size_t>(std::max(f.jpeg.rec_outbuf_height, 1));
+                        const size_t scanlineByteCount = f.jpeg.output_width * pixelByteCount;
+                        std::vector<uint8_t> scanlines(rowCount * scanlineByteCount);
+                        std::vector<JSAMPROW> rows(rowCount);
+                        const size_t end = y + imageInfo.size.h;
+                        size_t i = 0;
+                        while (i < end)
                         {
-                            if (!jpegScanline(&f.jpeg, out->getData(y), &f.jpegError))
+                            const size_t count = std::min(rowCount, end - i);
+                            for (size_t j = 0; j < count; ++j)
+                            {
+                                rows[j] = i + j >= y && !crop ?
+                                    out->getData(static_cast<uint16_t>(i + j - y)) :
+                                    scanlines.data() + j * scanlineByteCount;
+                            }
+                            JDIMENSION read = 0;
+                            if (!jpegScanlines(&f.jpeg, rows.data(), static_cast<JDIMENSION>(count), read, &f.jpegError))
                             {
                                 throw FileSystem::Error(f.jpegError.msg);
                             }
+                            if (crop)
+                            {
+                                for (size_t j = 0; j < read; ++j)
+                                {
+                                    if (i + j >= y)
+                                    {
+                                        memcpy(
+                                            out->getData(static_cast<uint16_t>(i + j - y)),
+                                            scanlines.data() + j * scanlineByteCount + x * pixelByteCount,
+                                            imageInfo.size.w * pixelByteCount);
+                                    }
+                                }
+                            }
+                            i += read;
                         }
                         if (!jpegEnd(&f.jpeg, &f.jpegError))
                         {
@@ -152,6 +221,11 @@ namespace djv
                     return out;
                 }
 
+                bool Read::_hasProxy() const
+                {
+                    return true;
+                }
+
                 namespace
                 {
                     bool jpegInit(
@@ -169,6 +243,8 @@ namespace djv
                     bool jpegOpen(
                         FILE *                   f,
                         jpeg_decompress_struct * jpeg,
+                        unsigned int             scale,
+                        bool                     fast,
                         JPEGErrorStruct *        error)
                     {
                         if (::setjmp(error->jump))
@@ -181,6 +257,14 @@ namespace djv
                         {
                             return false;
                         }
+                        jpeg->scale_num = 1;
+                        jpeg->scale_denom = scale;
+                        if (fast)
+                        {
+                            jpeg->dct_method = JDCT_IFAST;
+                            jpeg->do_fancy_upsampling = static_cast<boolean>(0);
+                            jpeg->do_block_smoothing = static_cast<boolean>(0);
+                        }
                         if (!jpeg_start_decompress(jpeg))
                         {
                             return false;
@@ -190,8 +274,9 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, File & f)
+                Info Read::_open(const std::string & fileName, File & f, Proxy proxy)
                 {
+                    DJV_PRIVATE_PTR();
                     f.jpeg.err = jpeg_std_error(&f.jpegError.pub);
                     f.jpegError.pub.error_exit = djvJPEGError;
                     f.jpegError.pub.emit_message = djvJPEGWarning;
@@ -207,7 +292,7 @@ namespace djv
                     {
                         throw FileSystem::Error(DJV_TEXT("Cannot open file."));
                     }
-                    if (!jpegOpen(f.f, &f.jpeg, &f.jpegError))
+                    if (!jpegOpen(f.f, &f.jpeg, static_cast<unsigned int>(getProxyScale(proxy)), p.options.fastDecode, &f.jpegError))
                     {
                         throw FileSystem::Error(f.jpegError.msg);
                     }
@@ -217,7 +302,7 @@ namespace djv
                     {
                         throw FileSystem::Error(DJV_TEXT("Unsupported color components."));
                     }
-                    auto info = Info(fileName, VideoInfo(Image::Info(f.jpeg.output_width, f.jpeg.output_height, imageType), _speed, _sequence));
+                    auto info = Info(fileName, VideoInfo(Image::Info(f.jpeg.image_width, f.jpeg.image_height, imageType), _speed, _sequence));
 
                     const jpeg_saved_marker_ptr marker = f.jpeg.marker_list;
                     if (marker)
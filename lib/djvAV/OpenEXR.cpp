@@ -581,6 +581,48 @@ namespace djv
                         glm::ivec2(channel.xSampling, channel.ySampling));
                 }
 
+                Imf::Compression toImf(Compression value)
+                {
+                    const std::vector<Imf::Compression> data =
+                    {
+                        Imf::NO_COMPRESSION,
+                        Imf::RLE_COMPRESSION,
+                        Imf::ZIPS_COMPRESSION,
+                        Imf::ZIP_COMPRESSION,
+                        Imf::PIZ_COMPRESSION,
+                        Imf::PXR24_COMPRESSION,
+                        Imf::B44_COMPRESSION,
+                        Imf::B44A_COMPRESSION,
+                        Imf::DWAA_COMPRESSION,
+                        Imf::DWAB_COMPRESSION
+                    };
+                    DJV_ASSERT(data.size() == static_cast<size_t>(Compression::Count));
+                    return data[static_cast<size_t>(value)];
+                }
+
+                int getScanlineBlockSize(Imf::Compression value)
+                {
+                    int out = 1;
+                    switch (value)
+                    {
+                    case Imf::ZIP_COMPRESSION:
+                    case Imf::PXR24_COMPRESSION:
+                        out = 16;
+                        break;
+                    case Imf::PIZ_COMPRESSION:
+                    case Imf::B44_COMPRESSION:
+                    case Imf::B44A_COMPRESSION:
+                    case Imf::DWAA_COMPRESSION:
+                        out = 32;
+                        break;
+                    case Imf::DWAB_COMPRESSION:
+                        out = 256;
+                        break;
+                    default: break;
+                    }
+                    return out;
+                }
+
                 struct Plugin::Private
                 {
                     Options options;
@@ -616,7 +658,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _p->options, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _cacheManager, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
@@ -665,6 +707,7 @@ namespace djv
                 out.get<picojson::object>()["Compression"] = picojson::value(ss.str());
             }
             out.get<picojson::object>()["DWACompressionLevel"] = toJSON(value.dwaCompressionLevel);
+            out.get<picojson::object>()["ZIPCompressionLevel"] = toJSON(value.zipCompressionLevel);
         }
         return out;
     }
@@ -693,6 +736,10 @@ namespace djv
                 {
                     fromJSON(i.second, out.dwaCompressionLevel);
                 }
+                else if ("ZIPCompressionLevel" == i.first)
+                {
+                    fromJSON(i.second, out.zipCompressionLevel);
+                }
             }
         }
         else
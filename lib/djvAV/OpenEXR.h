@@ -50,8 +50,12 @@ namespace djv
             //! References:
             //! - http://www.openexr.com
             //!
+            //! Tiled files are read with only the tiles that intersect the
+            //! region of interest, and mipmapped files are read from the level
+            //! closest to the proxy scale. Each layer of each part of a
+            //! multi-part file is a separate video layer.
+            //!
             //! \todo Add support for writing luminance/chroma images.
-            //! \todo Add better support for tiled images.
             namespace OpenEXR
             {
                 static const std::string pluginName = "OpenEXR";
@@ -144,6 +148,12 @@ namespace djv
                 //! Convert from an Imf channel.
                 Channel fromImf(const std::string& name, const Imf::Channel&);
 
+                //! Convert to an Imf compression type.
+                Imf::Compression toImf(Compression);
+
+                //! Get the number of scanlines that are compressed together.
+                int getScanlineBlockSize(Imf::Compression);
+
                 //! This struct provides the OpenEXR file I/O optioms.
                 struct Options
                 {
@@ -151,6 +161,11 @@ namespace djv
                     Channels    channels            = Channels::Known;
                     Compression compression         = Compression::None;
                     float       dwaCompressionLevel = 45.F;
+
+                    //! The zlib compression level for the ZIP and ZIPS compression
+                    //! types. This requires OpenEXR 3.1 or later, earlier versions
+                    //! always use the zlib default.
+                    int         zipCompressionLevel = 4;
                 };
 
                 //! This class provides a memory-mapped input stream.
@@ -160,6 +175,10 @@ namespace djv
 
                 public:
                     MemoryMappedIStream(const char fileName[]);
+
+                    //! Create a stream from a file that is already open in
+                    //! memory, for example a file that has been read ahead.
+                    explicit MemoryMappedIStream(Core::FileSystem::FileIO&&);
                     ~MemoryMappedIStream() override;
 
                     bool isMemoryMapped() const override;
@@ -187,16 +206,37 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    bool _hasReadAhead() const override;
+                    bool _hasProxy() const override;
 
                 private:
                     struct File;
+                    struct LayerImage;
                     Info _open(const std::string &, File &);
+                    std::shared_ptr<Image::Image> _readLayer(
+                        File&,
+                        const Info&,
+                        size_t layer);
+                    void _readScanlineLayer(
+                        File&,
+                        const Info&,
+                        size_t layer,
+                        const Core::BBox2i& region,
+                        LayerImage&);
+                    void _readTiledLayer(
+                        File&,
+                        const Info&,
+                        size_t layer,
+                        const Core::BBox2i& region,
+                        LayerImage&);
 
                     DJV_PRIVATE();
                 };
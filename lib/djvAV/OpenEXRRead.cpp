@@ -29,13 +29,21 @@
 
 #include <djvAV/OpenEXR.h>
 
+#include <djvAV/ImageUtil.h>
+
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
 #include <ImfChannelList.h>
 #include <ImfHeader.h>
-#include <ImfInputFile.h>
+#include <ImfInputPart.h>
+#include <ImfMultiPartInputFile.h>
+#include <ImfPartType.h>
 #include <ImfRgbaYca.h>
+#include <ImfTiledInputPart.h>
+
+#include <algorithm>
+#include <sstream>
 
 using namespace djv::Core;
 
@@ -47,7 +55,31 @@ namespace djv
         {
             namespace OpenEXR
             {
-#if defined(DJV_MMAP)
+                namespace
+                {
+                    int floorDiv(int value, int d)
+                    {
+                        return value >= 0 ? (value / d) : -((-value + d - 1) / d);
+                    }
+
+                    int getLevelCount(Imf::TiledInputPart& f)
+                    {
+                        int out = 1;
+                        switch (f.header().tileDescription().mode)
+                        {
+                        case Imf::MIPMAP_LEVELS:
+                            out = f.numLevels();
+                            break;
+                        case Imf::RIPMAP_LEVELS:
+                            out = std::min(f.numXLevels(), f.numYLevels());
+                            break;
+                        default: break;
+                        }
+                        return out;
+                    }
+
+                } // namespace
+
                 struct MemoryMappedIStream::Private
                 {
                     FileSystem::FileIO  f;
@@ -61,11 +93,22 @@ namespace djv
                     _p(new Private)
                 {
                     DJV_PRIVATE_PTR();
+                    p.f.setMMap(true);
                     p.f.open(fileName, FileSystem::FileIO::Mode::Read);
                     p.size = p.f.getSize();
                     p.p = (char*)(p.f.mmapP());
                 }
 
+                MemoryMappedIStream::MemoryMappedIStream(FileSystem::FileIO&& f) :
+                    IStream(f.getFileName().c_str()),
+                    _p(new Private)
+                {
+                    DJV_PRIVATE_PTR();
+                    p.f = std::move(f);
+                    p.size = p.f.getSize();
+                    p.p = (char*)(p.f.mmapP());
+                }
+
                 MemoryMappedIStream::~MemoryMappedIStream()
                 {}
 
@@ -107,23 +150,57 @@ namespace djv
                 {
                     _p->pos = pos;
                 }
-#endif // DJV_MMAP
 
                 struct Read::File
                 {
-                    ~File()
+                    //! This struct provides information about a file part.
+                    struct Part
                     {
-                    }
+                        int    index             = 0;
+                        bool   tiled             = false;
+                        BBox2i displayWindow;
+                        BBox2i dataWindow;
+                        BBox2i intersectedWindow;
+                    };
+
+                    std::unique_ptr<MemoryMappedIStream>     s;
+                    std::unique_ptr<Imf::MultiPartInputFile> f;
+                    std::vector<Part>                        parts;
+                    std::vector<OpenEXR::Layer>              layers;
+                    std::vector<size_t>                      layerParts;
+                };
+
+                struct Read::LayerImage
+                {
+                    void insertSlices(Imf::FrameBuffer&, char*, size_t xStride, size_t yStride) const;
 
-                    std::unique_ptr<MemoryMappedIStream> s;
-                    std::unique_ptr<Imf::InputFile>      f;
-                    BBox2i                               displayWindow;
-                    BBox2i                               dataWindow;
-                    BBox2i                               intersectedWindow;
-                    std::vector<OpenEXR::Layer>          layers;
-                    bool                                 fast              = false;
+                    const Layer*                  layer            = nullptr;
+                    Image::DataType               dataType         = Image::DataType::None;
+                    size_t                        channelByteCount = 0;
+                    size_t                        cb               = 0;
+                    size_t                        scb              = 0;
+                    std::shared_ptr<Image::Image> image;
+                    std::vector<char>             buf;
                 };
 
+                void Read::LayerImage::insertSlices(Imf::FrameBuffer& frameBuffer, char* p, size_t xStride, size_t yStride) const
+                {
+                    for (size_t c = 0; c < layer->channels.size(); ++c)
+                    {
+                        const auto& channel = layer->channels[c];
+                        frameBuffer.insert(
+                            channel.name.c_str(),
+                            Imf::Slice(
+                                toImf(dataType),
+                                p + (c * channelByteCount),
+                                xStride,
+                                yStride,
+                                channel.sampling.x,
+                                channel.sampling.y,
+                                0.F));
+                    }
+                }
+
                 struct Read::Private
                 {
                     Options options;
@@ -142,12 +219,14 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -160,77 +239,242 @@ namespace djv
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     File f;
-                    Info info = _open(fileName, f);
-                    Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)].info;
-                    std::shared_ptr<Image::Image> out = Image::Image::create(imageInfo);
-                    out->setPluginName(pluginName);
-                    out->setTags(info.tags);
-                    const size_t channels = Image::getChannelCount(imageInfo.type);
-                    const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
-                    const size_t cb = channels * channelByteCount;
-                    const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                    if (f.fast)
+                    const Info info = _open(fileName, f);
+                    const size_t layer = std::min(_options.layer, f.layers.size() - 1);
+                    return _readLayer(f, info, layer);
+                }
+
+                std::shared_ptr<Image::Image> Read::_readLayer(
+                    File& f,
+                    const Info& info,
+                    size_t layer)
+                {
+                    // Only the region of interest is read, the proxy scale is applied
+                    // afterwards or by reading a smaller mipmap level.
+                    const Image::Size& size = info.video[layer].info.size;
+                    const BBox2i region = getReadRegion(size, _options);
+                    LayerImage layerImage;
+                    layerImage.layer = &f.layers[layer];
+                    const Image::Type type = info.video[layer].info.type;
+                    layerImage.dataType = Image::getDataType(type);
+                    layerImage.channelByteCount = Image::getByteCount(layerImage.dataType);
+                    layerImage.cb = Image::getChannelCount(type) * layerImage.channelByteCount;
+                    if (f.parts[f.layerParts[layer]].tiled)
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        for (size_t c = 0; c < channels; ++c)
-                        {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    (char*)out->getData() + (c * channelByteCount),
-                                    cb,
-                                    scb,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
-                        }
-                        f.f->setFrameBuffer(frameBuffer);
-                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
+                        _readTiledLayer(f, info, layer, region, layerImage);
                     }
                     else
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        std::vector<char> buf(f.dataWindow.w() * cb);
-                        for (int c = 0; c < channels; ++c)
+                        _readScanlineLayer(f, info, layer, region, layerImage);
+                    }
+                    return layerImage.image;
+                }
+
+                void Read::_readScanlineLayer(
+                    File& f,
+                    const Info& info,
+                    size_t layer,
+                    const BBox2i& region,
+                    LayerImage& layerImage)
+                {
+                    const File::Part& filePart = f.parts[f.layerParts[layer]];
+                    Imf::InputPart in(*f.f, filePart.index);
+                    const Image::Size& size = info.video[layer].info.size;
+                    const bool fullRead = isFullRead(size, _options);
+                    const BBox2i& displayWindow = filePart.displayWindow;
+                    const BBox2i& dataWindow = filePart.dataWindow;
+                    const BBox2i& intersectedWindow = filePart.intersectedWindow;
+                    const int minY = displayWindow.min.y + region.min.y;
+                    const int maxY = displayWindow.min.y + region.max.y;
+                    const int readMinY = std::max(minY, intersectedWindow.min.y);
+                    const int readMaxY = std::min(maxY, intersectedWindow.max.y);
+                    const bool intersects =
+                        intersectedWindow.min.x <= intersectedWindow.max.x &&
+                        readMinY <= readMaxY;
+                    Image::Info imageInfo = info.video[layer].info;
+                    imageInfo.size.h = static_cast<uint16_t>(region.h());
+                    layerImage.scb = imageInfo.size.w * layerImage.cb;
+                    layerImage.image = Image::Image::create(imageInfo);
+                    layerImage.image->setPluginName(pluginName);
+                    layerImage.image->setTags(info.tags);
+
+                    // Pixels outside of the data window are filled once up front.
+                    if (!intersects ||
+                        intersectedWindow.min.x != displayWindow.min.x ||
+                        intersectedWindow.max.x != displayWindow.max.x ||
+                        readMinY != minY ||
+                        readMaxY != maxY)
+                    {
+                        layerImage.image->zero();
+                    }
+
+                    bool subsampled = false;
+                    for (const auto& channel : layerImage.layer->channels)
+                    {
+                        if (channel.sampling.x != 1 || channel.sampling.y != 1)
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    buf.data() - (f.dataWindow.min.x * cb) + (c * channelByteCount),
-                                    cb,
-                                    0,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
+                            subsampled = true;
                         }
-                        f.f->setFrameBuffer(frameBuffer);
-                        for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
+                    }
+                    if (intersects &&
+                        !subsampled &&
+                        dataWindow.min.x >= displayWindow.min.x &&
+                        dataWindow.max.x <= displayWindow.max.x)
+                    {
+                        // The data window fits horizontally inside the display
+                        // window so it can be read directly into the image.
+                        Imf::FrameBuffer frameBuffer;
+                        layerImage.insertSlices(
+                            frameBuffer,
+                            (char*)layerImage.image->getData() - (displayWindow.min.x * layerImage.cb) - (minY * layerImage.scb),
+                            layerImage.cb,
+                            layerImage.scb);
+                        in.setFrameBuffer(frameBuffer);
+                        in.readPixels(readMinY, readMaxY);
+                    }
+                    else if (intersects)
+                    {
+                        // Read blocks of scanlines that are aligned with the file's
+                        // compression into a temporary buffer and copy the intersected
+                        // pixels. Subsampled channels fall back to reading a single
+                        // scanline at a time.
+                        const int blockSize = getScanlineBlockSize(in.header().compression());
+                        const int chunkSize = subsampled ? 1 : ((64 + blockSize - 1) / blockSize) * blockSize;
+                        const size_t rowByteCount = dataWindow.w() * layerImage.cb;
+                        layerImage.buf.resize(rowByteCount * chunkSize);
+                        const size_t outOffset = (intersectedWindow.min.x - displayWindow.min.x) * layerImage.cb;
+                        const size_t bufOffset = (intersectedWindow.min.x - dataWindow.min.x) * layerImage.cb;
+                        const size_t byteCount = intersectedWindow.w() * layerImage.cb;
+                        int y = readMinY;
+                        while (y <= readMaxY)
                         {
-                            uint8_t* p = out->getData() + ((y - f.displayWindow.min.y) * scb);
-                            uint8_t* end = p + scb;
-                            if (y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
+                            const int chunkMinY = dataWindow.min.y + ((y - dataWindow.min.y) / chunkSize) * chunkSize;
+                            const int chunkMaxY = std::min(chunkMinY + chunkSize - 1, readMaxY);
+                            Imf::FrameBuffer frameBuffer;
+                            layerImage.insertSlices(
+                                frameBuffer,
+                                layerImage.buf.data() - (dataWindow.min.x * layerImage.cb) - (subsampled ? 0 : (y * rowByteCount)),
+                                layerImage.cb,
+                                subsampled ? 0 : rowByteCount);
+                            in.setFrameBuffer(frameBuffer);
+                            in.readPixels(y, chunkMaxY);
+                            for (int i = y; i <= chunkMaxY; ++i)
                             {
-                                size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * cb;
-                                memset(p, 0, size);
-                                p += size;
-                                size = f.intersectedWindow.w() * cb;
-                                f.f->readPixels(y, y);
                                 memcpy(
-                                    p,
-                                    buf.data() + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * cb,
-                                    size);
-                                p += size;
+                                    layerImage.image->getData() + ((i - minY) * layerImage.scb) + outOffset,
+                                    layerImage.buf.data() + ((i - y) * rowByteCount) + bufOffset,
+                                    byteCount);
                             }
-                            memset(p, 0, end - p);
+                            y = chunkMaxY + 1;
                         }
                     }
-                    return out;
+                    if (!fullRead)
+                    {
+                        layerImage.image = Image::decimate(
+                            layerImage.image,
+                            BBox2i(region.min.x, 0, region.w(), region.h()),
+                            getProxyScale(_options.proxy));
+                    }
+                }
+
+                void Read::_readTiledLayer(
+                    File& f,
+                    const Info& info,
+                    size_t layer,
+                    const BBox2i& region,
+                    LayerImage& layerImage)
+                {
+                    const File::Part& filePart = f.parts[f.layerParts[layer]];
+                    Imf::TiledInputPart in(*f.f, filePart.index);
+                    const int scale = static_cast<int>(getProxyScale(_options.proxy));
+
+                    // Find the level closest to the proxy scale. Mipmap levels are
+                    // relative to the data window so the region of interest is
+                    // mapped into the level's coordinates.
+                    const int levelCount = getLevelCount(in);
+                    int level = 0;
+                    while (level + 1 < levelCount && (1 << (level + 1)) <= scale)
+                    {
+                        ++level;
+                    }
+                    const int levelScale = 1 << level;
+                    const BBox2i levelDataWindow = fromImath(in.dataWindowForLevel(level, level));
+                    const BBox2i levelRegion(
+                        filePart.dataWindow.min.x + floorDiv(filePart.displayWindow.min.x + region.min.x - filePart.dataWindow.min.x, levelScale),
+                        filePart.dataWindow.min.y + floorDiv(filePart.displayWindow.min.y + region.min.y - filePart.dataWindow.min.y, levelScale),
+                        (region.w() + levelScale - 1) / levelScale,
+                        (region.h() + levelScale - 1) / levelScale);
+                    const BBox2i intersectedWindow = levelRegion.intersect(levelDataWindow);
+                    const bool intersects =
+                        intersectedWindow.min.x <= intersectedWindow.max.x &&
+                        intersectedWindow.min.y <= intersectedWindow.max.y;
+                    Image::Info imageInfo = info.video[layer].info;
+                    imageInfo.size.w = static_cast<uint16_t>(levelRegion.w());
+                    imageInfo.size.h = static_cast<uint16_t>(levelRegion.h());
+                    layerImage.scb = imageInfo.size.w * layerImage.cb;
+                    layerImage.image = Image::Image::create(imageInfo);
+                    layerImage.image->setPluginName(pluginName);
+                    layerImage.image->setTags(info.tags);
+                    if (!intersects || !(intersectedWindow == levelRegion))
+                    {
+                        layerImage.image->zero();
+                    }
+                    if (intersects)
+                    {
+                        // Decode the tiles that intersect the region into a buffer
+                        // that covers them completely, the tiles are decoded in
+                        // parallel by the OpenEXR thread pool.
+                        const Imf::TileDescription& tileDescription = in.header().tileDescription();
+                        const int tileWidth = static_cast<int>(tileDescription.xSize);
+                        const int tileHeight = static_cast<int>(tileDescription.ySize);
+                        const int tileMinX = (intersectedWindow.min.x - levelDataWindow.min.x) / tileWidth;
+                        const int tileMaxX = (intersectedWindow.max.x - levelDataWindow.min.x) / tileWidth;
+                        const int tileMinY = (intersectedWindow.min.y - levelDataWindow.min.y) / tileHeight;
+                        const int tileMaxY = (intersectedWindow.max.y - levelDataWindow.min.y) / tileHeight;
+                        const BBox2i tilesWindow(
+                            levelDataWindow.min.x + tileMinX * tileWidth,
+                            levelDataWindow.min.y + tileMinY * tileHeight,
+                            (tileMaxX - tileMinX + 1) * tileWidth,
+                            (tileMaxY - tileMinY + 1) * tileHeight);
+                        const size_t rowByteCount = tilesWindow.w() * layerImage.cb;
+                        layerImage.buf.resize(rowByteCount * tilesWindow.h());
+                        Imf::FrameBuffer frameBuffer;
+                        layerImage.insertSlices(
+                            frameBuffer,
+                            layerImage.buf.data() - (tilesWindow.min.x * layerImage.cb) - (tilesWindow.min.y * rowByteCount),
+                            layerImage.cb,
+                            rowByteCount);
+                        in.setFrameBuffer(frameBuffer);
+                        in.readTiles(tileMinX, tileMaxX, tileMinY, tileMaxY, level, level);
+                        const size_t size = intersectedWindow.w() * layerImage.cb;
+                        for (int y = intersectedWindow.min.y; y <= intersectedWindow.max.y; ++y)
+                        {
+                            memcpy(
+                                layerImage.image->getData() + ((y - levelRegion.min.y) * layerImage.scb) + ((intersectedWindow.min.x - levelRegion.min.x) * layerImage.cb),
+                                layerImage.buf.data() + ((y - tilesWindow.min.y) * rowByteCount) + ((intersectedWindow.min.x - tilesWindow.min.x) * layerImage.cb),
+                                size);
+                        }
+                    }
+
+                    // Apply the remainder of the proxy scale.
+                    const int levelProxyScale = scale / levelScale;
+                    if (levelProxyScale > 1)
+                    {
+                        layerImage.image = Image::decimate(
+                            layerImage.image,
+                            BBox2i(0, 0, levelRegion.w(), levelRegion.h()),
+                            levelProxyScale);
+                    }
+                }
+
+                bool Read::_hasProxy() const
+                {
+                    return true;
+                }
+
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
                 }
 
                 Info Read::_open(const std::string & fileName, File & f)
@@ -239,55 +483,108 @@ namespace djv
 
                     Info out;
 
-                    // Open the file.
-#if defined(DJV_MMAP)
-                    f.s.reset(new MemoryMappedIStream(fileName.c_str()));
-                    f.f.reset(new Imf::InputFile(*f.s.get()));
-#else // DJV_MMAP
-                    f.f.reset(new Imf::InputFile(fileName.c_str()));
-#endif // DJV_MMAP
-
-                    // Get the display and data windows.
-                    f.displayWindow = fromImath(f.f->header().displayWindow());
-                    f.dataWindow = fromImath(f.f->header().dataWindow());
-                    f.intersectedWindow = f.displayWindow.intersect(f.dataWindow);
-                    f.fast = f.displayWindow == f.dataWindow;
+                    // Open the file. All files are opened as multi-part files, single
+                    // part files then have one part.
+                    FileSystem::FileIO io;
+                    if (_openReadAhead(fileName, io))
+                    {
+                        f.s.reset(new MemoryMappedIStream(std::move(io)));
+                        f.f.reset(new Imf::MultiPartInputFile(*f.s.get()));
+                    }
+                    else if (_options.mmap)
+                    {
+                        f.s.reset(new MemoryMappedIStream(fileName.c_str()));
+                        f.f.reset(new Imf::MultiPartInputFile(*f.s.get()));
+                    }
+                    else
+                    {
+                        f.f.reset(new Imf::MultiPartInputFile(fileName.c_str()));
+                    }
 
                     // Get the tags.
-                    readTags(f.f->header(), out.tags, _speed);
+                    readTags(f.f->header(0), out.tags, _speed);
 
-                    // Get the layers.
-                    f.layers = getLayers(f.f->header().channels(), p.options.channels);
-                    out.fileName = fileName;
-                    out.video.resize(f.layers.size());
-                    for (size_t i = 0; i < f.layers.size(); ++i)
+                    // Get the parts and their layers. Deep data parts are not
+                    // supported and are skipped.
+                    const int partCount = f.f->parts();
+                    for (int i = 0; i < partCount; ++i)
                     {
-                        const auto& layer = f.layers[i];
-                        const glm::ivec2 sampling(layer.channels[0].sampling.x, layer.channels[0].sampling.y);
-                        if (sampling.x != 1 || sampling.y != 1)
-                            f.fast = false;
-                        auto& info = out.video[i].info;
-                        info.name = layer.name;
-                        info.size.w = f.displayWindow.w();
-                        info.size.h = f.displayWindow.h();
-                        info.pixelAspectRatio = f.f->header().pixelAspectRatio();
-                        switch (layer.channels[0].type)
+                        const Imf::Header& header = f.f->header(i);
+                        if (header.hasType() && Imf::isDeepData(header.type()))
                         {
-                        case Image::DataType::F16:
-                        case Image::DataType::F32:
-                            info.type = Image::getFloatType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
-                            break;
-                        case Image::DataType::U32:
-                            info.type = Image::getIntType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
-                            break;
-                        default: break;
+                            continue;
+                        }
+                        File::Part part;
+                        part.index = i;
+                        part.tiled = header.hasTileDescription();
+                        part.displayWindow = fromImath(header.displayWindow());
+                        part.dataWindow = fromImath(header.dataWindow());
+                        part.intersectedWindow = part.displayWindow.intersect(part.dataWindow);
+                        if (part.tiled && !out.tags.hasTag("Tile Size"))
+                        {
+                            const Imf::TileDescription& tileDescription = header.tileDescription();
+                            {
+                                std::stringstream ss;
+                                ss << tileDescription.xSize << "x" << tileDescription.ySize;
+                                out.tags.setTag("Tile Size", ss.str());
+                            }
+                            Imf::TiledInputPart in(*f.f, i);
+                            const int levelCount = getLevelCount(in);
+                            if (levelCount > 1)
+                            {
+                                std::stringstream ss;
+                                for (int j = 0; j < levelCount; ++j)
+                                {
+                                    if (j > 0)
+                                    {
+                                        ss << " ";
+                                    }
+                                    ss << in.levelWidth(j) << "x" << in.levelHeight(j);
+                                }
+                                out.tags.setTag("Levels", ss.str());
+                            }
                         }
-                        if (Image::Type::None == info.type)
+                        for (const auto& layer : getLayers(header.channels(), p.options.channels))
                         {
-                            throw FileSystem::Error(DJV_TEXT("Unsupported image type."));
+                            VideoInfo videoInfo;
+                            auto& info = videoInfo.info;
+                            info.name = layer.name;
+                            if (partCount > 1 && header.hasName())
+                            {
+                                info.name = header.name() + ": " + layer.name;
+                            }
+                            info.size.w = part.displayWindow.w();
+                            info.size.h = part.displayWindow.h();
+                            info.pixelAspectRatio = header.pixelAspectRatio();
+                            switch (layer.channels[0].type)
+                            {
+                            case Image::DataType::F16:
+                            case Image::DataType::F32:
+                                info.type = Image::getFloatType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
+                                break;
+                            case Image::DataType::U32:
+                                info.type = Image::getIntType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
+                                break;
+                            default: break;
+                            }
+                            if (Image::Type::None == info.type)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("Unsupported image type."));
+                            }
+                            videoInfo.sequence = _sequence;
+                            videoInfo.speed = _speed;
+                            out.video.push_back(videoInfo);
+                            f.layers.push_back(layer);
+                            f.layerParts.push_back(f.parts.size());
                         }
-                        out.video[i].sequence = _sequence;
-                        out.video[i].speed = _speed;
+                        f.parts.push_back(part);
+                    }
+                    out.fileName = fileName;
+                    if (out.video.empty())
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("does not have any image layers") << ".";
+                        throw FileSystem::Error(ss.str());
                     }
 
                     return out;
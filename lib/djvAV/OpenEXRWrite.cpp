@@ -29,6 +29,15 @@
 
 #include <djvAV/OpenEXR.h>
 
+#include <djvCore/FileSystem.h>
+
+#include <ImfChannelList.h>
+#include <ImfOutputFile.h>
+#include <ImfStandardAttributes.h>
+#include <OpenEXRConfig.h>
+
+#include <sstream>
+
 using namespace djv::Core;
 
 namespace djv
@@ -87,8 +96,9 @@ namespace djv
                     case Image::Type::L_F16:
                     case Image::Type::L_U32:
                     case Image::Type::L_F32:    out = value; break;
-                    case Image::Type::LA_U8:    out = Image::Type::LA_F16; break;
-                    case Image::Type::LA_U16:
+                    case Image::Type::LA_U8:
+                    case Image::Type::LA_U16:   out = Image::Type::LA_F16; break;
+                    case Image::Type::LA_F16:
                     case Image::Type::LA_U32:
                     case Image::Type::LA_F32:   out = value; break;
                     case Image::Type::RGB_U8:
@@ -113,6 +123,78 @@ namespace djv
 
                 void Write::_write(const std::string & fileName, const std::shared_ptr<Image::Image> & image)
                 {
+                    DJV_PRIVATE_PTR();
+
+                    // Set the header.
+                    const Image::Info& info = image->getInfo();
+                    Imf::Header header(info.size.w, info.size.h, info.pixelAspectRatio);
+                    header.compression() = toImf(p.options.compression);
+                    switch (p.options.compression)
+                    {
+                    case Compression::DWAA:
+                    case Compression::DWAB:
+                        addDwaCompressionLevel(header, p.options.dwaCompressionLevel);
+                        break;
+                    default: break;
+                    }
+#if OPENEXR_VERSION_MAJOR > 3 || (OPENEXR_VERSION_MAJOR == 3 && OPENEXR_VERSION_MINOR >= 1)
+                    header.zipCompressionLevel() = p.options.zipCompressionLevel;
+#endif // OPENEXR_VERSION_MAJOR
+                    writeTags(image->getTags(), _info.video.size() ? _info.video[0].speed : Time::Speed(), header);
+                    std::vector<std::string> channels;
+                    switch (Image::getChannelCount(info.type))
+                    {
+                    case 1: channels = { "Y" }; break;
+                    case 2: channels = { "Y", "A" }; break;
+                    case 3: channels = { "R", "G", "B" }; break;
+                    case 4: channels = { "R", "G", "B", "A" }; break;
+                    default: break;
+                    }
+                    const Image::DataType dataType = Image::getDataType(info.type);
+                    switch (dataType)
+                    {
+                    case Image::DataType::F16:
+                    case Image::DataType::F32:
+                    case Image::DataType::U32: break;
+                    default:
+                    {
+                        // Other data types would be written with the wrong pixel
+                        // type, see toImf().
+                        std::stringstream ss;
+                        ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be written") << ". " <<
+                            DJV_TEXT("Unsupported bit depth.");
+                        throw FileSystem::Error(ss.str());
+                    }
+                    }
+                    for (const auto& i : channels)
+                    {
+                        header.channels().insert(i, Imf::Channel(toImf(dataType)));
+                    }
+
+                    // Write the file. The scanlines are compressed in parallel by
+                    // the OpenEXR thread pool, and ISequenceWrite writes several
+                    // frames at once.
+                    Imf::OutputFile f(fileName.c_str(), header);
+                    const Image::Image& in = *image;
+                    const size_t channelByteCount = Image::getByteCount(dataType);
+                    const size_t cb = channels.size() * channelByteCount;
+                    const size_t scb = info.getScanlineByteCount();
+                    Imf::FrameBuffer frameBuffer;
+                    for (size_t c = 0; c < channels.size(); ++c)
+                    {
+                        frameBuffer.insert(
+                            channels[c],
+                            Imf::Slice(
+                                toImf(dataType),
+                                (char*)in.getData() + (c * channelByteCount),
+                                cb,
+                                scb,
+                                1,
+                                1,
+                                0.F));
+                    }
+                    f.setFrameBuffer(frameBuffer);
+                    f.writePixels(info.size.h);
                 }
 
             } // namespace TIFF
@@ -30,8 +30,12 @@
 #include <djvAV/PPM.h>
 
 #include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
 #include <djvCore/String.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace djv::Core;
 
 namespace djv
@@ -85,6 +89,163 @@ namespace djv
                     }
                 }
 
+                namespace
+                {
+                    inline bool isDigit(uint8_t value)
+                    {
+                        return static_cast<uint8_t>(value - '0') < 10;
+                    }
+
+                    //! Skip white space and comments up to the next value.
+                    inline const uint8_t * skipASCII(const uint8_t * in, const uint8_t * end)
+                    {
+                        while (in < end && !isDigit(*in))
+                        {
+                            if ('#' == *in)
+                            {
+                                while (in < end && *in != '\n' && *in != '\r')
+                                {
+                                    ++in;
+                                }
+                            }
+                            else
+                            {
+                                ++in;
+                            }
+                        }
+                        return in;
+                    }
+
+                    template<typename T>
+                    size_t _readASCII(const uint8_t * in, const uint8_t * end, uint8_t * out, size_t size)
+                    {
+                        T* outP = reinterpret_cast<T*>(out);
+                        size_t i = 0;
+                        for (; i < size; ++i)
+                        {
+                            in = skipASCII(in, end);
+                            if (in == end)
+                            {
+                                break;
+                            }
+                            unsigned int value = 0;
+                            do
+                            {
+                                value = value * 10 + (*in - '0');
+                                ++in;
+                            } while (in < end && isDigit(*in));
+                            outP[i] = static_cast<T>(value);
+                        }
+                        return i;
+                    }
+
+                } // namespace
+
+                size_t countASCII(const uint8_t * in, const uint8_t * end)
+                {
+                    size_t out = 0;
+                    while ((in = skipASCII(in, end)) < end)
+                    {
+                        while (in < end && isDigit(*in))
+                        {
+                            ++in;
+                        }
+                        ++out;
+                    }
+                    return out;
+                }
+
+                size_t readASCII(const uint8_t * in, const uint8_t * end, uint8_t * out, size_t size, size_t bitDepth)
+                {
+                    switch (bitDepth)
+                    {
+                    case  8: return _readASCII<uint8_t> (in, end, out, size);
+                    case 16: return _readASCII<uint16_t>(in, end, out, size);
+                    default: break;
+                    }
+                    return 0;
+                }
+
+                void readASCIIChunks(
+                    const uint8_t * in,
+                    const uint8_t * end,
+                    uint8_t *       out,
+                    size_t          size,
+                    size_t          bitDepth,
+                    size_t          threadCount,
+                    size_t          minChunkByteCount)
+                {
+                    // The data is split into chunks at line breaks, which are
+                    // never inside of a value or a comment. The values in each
+                    // chunk are counted first to find where they go in the
+                    // output.
+                    const size_t byteCount = end - in;
+                    const size_t chunkCount = std::max(
+                        std::min(threadCount, byteCount / std::max(minChunkByteCount, static_cast<size_t>(1))),
+                        static_cast<size_t>(1));
+                    std::vector<const uint8_t*> chunks(chunkCount + 1, end);
+                    chunks[0] = in;
+                    for (size_t i = 1; i < chunkCount; ++i)
+                    {
+                        const uint8_t* chunk = std::max(in + i * byteCount / chunkCount, chunks[i - 1]);
+                        while (chunk < end && *chunk != '\n')
+                        {
+                            ++chunk;
+                        }
+                        chunks[i] = chunk < end ? (chunk + 1) : end;
+                    }
+                    std::vector<size_t> offsets(chunkCount + 1, 0);
+                    if (chunkCount > 1)
+                    {
+                        parallelChunks(
+                            chunkCount,
+                            chunkCount,
+                            [&chunks, &offsets](size_t begin, size_t end)
+                            {
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    offsets[i + 1] = countASCII(chunks[i], chunks[i + 1]);
+                                }
+                            });
+                        for (size_t i = 1; i <= chunkCount; ++i)
+                        {
+                            offsets[i] += offsets[i - 1];
+                        }
+                        if (offsets[chunkCount] < size)
+                        {
+                            throw FileSystem::Error(DJV_TEXT("Incomplete file."));
+                        }
+                    }
+                    else
+                    {
+                        offsets[1] = size;
+                    }
+                    const size_t componentByteCount = bitDepth / 8;
+                    std::atomic<size_t> count(0);
+                    parallelChunks(
+                        chunkCount,
+                        chunkCount,
+                        [&chunks, &offsets, &count, out, size, componentByteCount, bitDepth](size_t begin, size_t end)
+                        {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                if (offsets[i] < size)
+                                {
+                                    count += readASCII(
+                                        chunks[i],
+                                        chunks[i + 1],
+                                        out + offsets[i] * componentByteCount,
+                                        std::min(offsets[i + 1], size) - offsets[i],
+                                        bitDepth);
+                                }
+                            }
+                        });
+                    if (count < size)
+                    {
+                        throw FileSystem::Error(DJV_TEXT("Incomplete file."));
+                    }
+                }
+
                 namespace
                 {
                     template<typename T>
@@ -151,7 +312,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _cacheManager, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
@@ -171,6 +332,7 @@ namespace djv
             ss << value.data;
             out.get<picojson::object>()["Data"] = picojson::value(ss.str());
         }
+        out.get<picojson::object>()["ThreadCount"] = toJSON(value.threadCount);
         return out;
     }
 
@@ -185,6 +347,10 @@ namespace djv
                     std::stringstream ss(i.second.get<std::string>());
                     ss >> out.data;
                 }
+                else if ("ThreadCount" == i.first)
+                {
+                    fromJSON(i.second, out.threadCount);
+                }
             }
         }
         else
@@ -62,6 +62,11 @@ namespace djv
                 struct Options
                 {
                     Data data = Data::Binary;
+
+                    //! The number of threads used to parse the values of a
+                    //! single ASCII image. The frames of a sequence are
+                    //! already read in parallel, so this defaults to one.
+                    size_t threadCount = 1;
                 };
 
                 //! Get the number of bytes in a scanline.
@@ -77,6 +82,35 @@ namespace djv
                     size_t                     size,
                     size_t                     componentSize);
 
+                //! Count the values in PPM file ASCII data in memory.
+                size_t countASCII(
+                    const uint8_t * in,
+                    const uint8_t * end);
+
+                //! Read PPM file ASCII data from memory. Values are separated by
+                //! white space and comments run to the end of the line. Returns
+                //! the number of values read, which is less than the given size
+                //! if the data ends early.
+                size_t readASCII(
+                    const uint8_t * in,
+                    const uint8_t * end,
+                    uint8_t *       out,
+                    size_t          size,
+                    size_t          componentSize);
+
+                //! Read PPM file ASCII data from memory, split into up to the
+                //! given number of chunks that are parsed in parallel. Each
+                //! chunk is at least the given number of bytes. Throws
+                //! Core::FileSystem::Error if the data ends early.
+                void readASCIIChunks(
+                    const uint8_t * in,
+                    const uint8_t * end,
+                    uint8_t *       out,
+                    size_t          size,
+                    size_t          componentSize,
+                    size_t          threadCount,
+                    size_t          minChunkByteCount);
+
                 //! Save PPM file ASCII data.
                 size_t writeASCII(
                     const uint8_t * in,
@@ -98,15 +132,22 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const Options&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string &) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
+                    bool _hasReadAhead() const override;
+                    bool _hasProxy() const override;
 
                 private:
                     Info _open(const std::string &, Core::FileSystem::FileIO &, Data &);
+
+                    DJV_PRIVATE();
                 };
                 
                 //! This class provides the PPM file writer.
@@ -29,8 +29,13 @@
 
 #include <djvAV/PPM.h>
 
+#include <djvAV/ImageUtil.h>
+
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
+
+#include <algorithm>
 
 using namespace djv::Core;
 
@@ -42,7 +47,21 @@ namespace djv
         {
             namespace PPM
             {
-                Read::Read()
+                namespace
+                {
+                    //! The minimum size of the ASCII data that is parsed by each
+                    //! thread.
+                    const size_t asciiChunkByteCount = 256 * Memory::kilobyte;
+
+                } // namespace
+
+                struct Read::Private
+                {
+                    Options options;
+                };
+
+                Read::Read() :
+                    _p(new Private)
                 {}
 
                 Read::~Read()
@@ -53,11 +72,15 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_p->options = options;
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -70,10 +93,13 @@ namespace djv
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
+                    DJV_PRIVATE_PTR();
                     auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                    io->setMMap(_options.mmap);
                     Data data = Data::First;
                     const auto info = _open(fileName, *io, data);
                     auto imageInfo = info.video[0].info;
+                    const bool fullRead = isFullRead(imageInfo.size, _options);
                     std::shared_ptr<Image::Image> out;
                     switch (data)
                     {
@@ -83,41 +109,95 @@ namespace djv
                         out->setPluginName(pluginName);
                         const size_t channelCount = Image::getChannelCount(imageInfo.type);
                         const size_t bitDepth = Image::getBitDepth(imageInfo.type);
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        const size_t size = imageInfo.size.w * imageInfo.size.h * channelCount;
+
+                        // The file is read once and parsed in parallel chunks.
+                        const size_t byteCount = io->getSize() - io->getPos();
+                        std::vector<uint8_t> buf;
+                        const uint8_t* inP = nullptr;
+                        if (io->isMMap())
                         {
-                            readASCII(*io, out->getData(y), imageInfo.size.w * channelCount, bitDepth);
+                            io->mmapWillNeed(byteCount);
+                            inP = io->mmapP();
+                        }
+                        else
+                        {
+                            buf.resize(byteCount);
+                            io->read(buf.data(), byteCount);
+                            inP = buf.data();
+                        }
+                        readASCIIChunks(
+                            inP,
+                            inP + byteCount,
+                            out->getData(),
+                            size,
+                            bitDepth,
+                            p.options.threadCount,
+                            asciiChunkByteCount);
+                        if (!fullRead)
+                        {
+                            // ASCII files have to be parsed, so the whole image
+                            // is read and then decimated.
+                            out = Image::decimate(
+                                out,
+                                getReadRegion(imageInfo.size, _options),
+                                getProxyScale(_options.proxy));
                         }
                         break;
                     }
                     case Data::Binary:
                     {
-#if defined(DJV_MMAP)
-                        out = Image::Image::create(imageInfo, io);
-#else // DJV_MMAP
-                        bool convertEndian = false;
-                        if (imageInfo.layout.endian != Memory::getEndian())
+                        if (io->isMMap())
                         {
-                            convertEndian = true;
-                            imageInfo.layout.endian = Memory::getEndian();
+                            // Use the file data directly, the endian conversion
+                            // is done when the image is uploaded to OpenGL.
+                            if (fullRead)
+                            {
+                                io->mmapWillNeed(imageInfo.getDataByteCount());
+                                out = Image::Image::create(imageInfo, io);
+                            }
+                            else
+                            {
+                                out = Image::decimate(
+                                    Image::Image::create(imageInfo, io),
+                                    getReadRegion(imageInfo.size, _options),
+                                    getProxyScale(_options.proxy));
+                            }
+                            out->setPluginName(pluginName);
                         }
-                        out = Image::Image::create(imageInfo);
-                        out->setPluginName(pluginName);
-                        io->read(out->getData(), io->getSize() - io->getPos());
-                        if (convertEndian)
+                        else
                         {
-                            const size_t dataByteCount = out->getDataByteCount();
-                            switch (Image::getDataType(imageInfo.type))
+                            bool convertEndian = false;
+                            if (imageInfo.layout.endian != Memory::getEndian())
+                            {
+                                convertEndian = true;
+                                imageInfo.layout.endian = Memory::getEndian();
+                            }
+                            if (fullRead)
+                            {
+                                out = Image::Image::create(imageInfo);
+                                io->read(out->getData(), io->getSize() - io->getPos());
+                            }
+                            else
+                            {
+                                out = _readScanlines(*io, imageInfo, _options);
+                            }
+                            out->setPluginName(pluginName);
+                            if (convertEndian)
                             {
-                                case Image::DataType::U10:
-                                    Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                    break;
-                                case Image::DataType::U16:
-                                    Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                    break;
-                                default: break;                            
+                                const size_t dataByteCount = out->getDataByteCount();
+                                switch (Image::getDataType(imageInfo.type))
+                                {
+                                    case Image::DataType::U10:
+                                        Memory::endian(out->getData(), dataByteCount / 4, 4);
+                                        break;
+                                    case Image::DataType::U16:
+                                        Memory::endian(out->getData(), dataByteCount / 2, 2);
+                                        break;
+                                    default: break;                            
+                                }
                             }
                         }
-#endif // DJV_MMAP
                         break;
                     }
                     default: break;
@@ -125,9 +205,22 @@ namespace djv
                     return out;
                 }
 
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
+                }
+
+                bool Read::_hasProxy() const
+                {
+                    return true;
+                }
+
                 Info Read::_open(const std::string & fileName, FileSystem::FileIO & io, Data & data)
                 {
-                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    if (!_openReadAhead(fileName, io))
+                    {
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    }
 
                     char magic[] = { 0, 0, 0 };
                     io.read(magic, 2);
@@ -47,6 +47,17 @@ namespace djv
                 static const std::string pluginName = "RLA";
                 static const std::set<std::string> fileExtensions = { ".rla", ".rpf" };
 
+                //! Decode the run-length encoded data of one channel in a
+                //! scanline, advancing the pointer past the channel. Returns
+                //! false if the data is truncated or overflows the scanline.
+                bool readRle(
+                    const uint8_t*& p,
+                    const uint8_t*  end,
+                    uint8_t*        out,
+                    size_t          size,
+                    size_t          channels,
+                    size_t          bytes);
+
                 //! This class provides the RLA file reader.
                 class Read : public ISequenceRead
                 {
@@ -61,17 +72,18 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    bool _hasReadAhead() const override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO&);
-
-                    std::vector<int32_t> _rleOffset;
+                    Info _open(const std::string &, Core::FileSystem::FileIO&, std::vector<int32_t>& rleOffset);
                 };
 
                 //! This class provides the RLA file I/O plugin.
@@ -53,130 +53,207 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    std::vector<int32_t> rleOffset;
+                    return _open(fileName, io, rleOffset);
                 }
 
                 namespace
                 {
-                    void readRle(
-                        FileSystem::FileIO& io,
-                        uint8_t*            out,
-                        size_t              size,
-                        size_t              channels,
-                        size_t              bytes)
+                    //! Get the data of one channel in a scanline, which starts
+                    //! with its size.
+                    bool readChannel(const uint8_t*& p, const uint8_t* end, const uint8_t*& channelEnd)
                     {
-                        int16_t _size = 0;
-                        io.read16(&_size);
-                        std::vector<uint8_t> buf;
-                        buf.resize(_size);
-                        io.read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
-                        for (size_t b = 0; b < bytes; ++b)
+                        if (end - p < 2)
                         {
-                            uint8_t* outP = out + (Memory::Endian::LSB == Memory::getEndian() ? (bytes - 1 - b) : b);
-                            const size_t outInc = channels * bytes;
-                            for (size_t i = 0; i < size;)
+                            return false;
+                        }
+                        const int16_t size = static_cast<int16_t>((p[0] << 8) | p[1]);
+                        p += 2;
+                        if (size < 0 || end - p < size)
+                        {
+                            return false;
+                        }
+                        channelEnd = p + size;
+                        return true;
+                    }
+
+                } // namespace
+
+                bool readRle(
+                    const uint8_t*& p,
+                    const uint8_t*  end,
+                    uint8_t*        out,
+                    size_t          size,
+                    size_t          channels,
+                    size_t          bytes)
+                {
+                    const uint8_t* channelEnd = nullptr;
+                    if (!readChannel(p, end, channelEnd))
+                    {
+                        return false;
+                    }
+                    const size_t outInc = channels * bytes;
+                    for (size_t b = 0; b < bytes; ++b)
+                    {
+                        uint8_t* outP = out + (Memory::Endian::LSB == Memory::getEndian() ? (bytes - 1 - b) : b);
+                        for (size_t i = 0; i < size;)
+                        {
+                            if (p >= channelEnd)
+                            {
+                                return false;
+                            }
+                            int count = *reinterpret_cast<const int8_t*>(p);
+                            ++p;
+                            if (count >= 0)
                             {
-                                int count = *((const int8_t*)p);
+                                ++count;
+                                if (i + count > size || p >= channelEnd)
+                                {
+                                    return false;
+                                }
+                                const uint8_t value = *p;
+                                for (int j = 0; j < count; ++j, outP += outInc)
+                                {
+                                    *outP = value;
+                                }
                                 ++p;
-                                if (count >= 0)
+                            }
+                            else
+                            {
+                                count = -count;
+                                if (i + count > size || channelEnd - p < count)
                                 {
-                                    ++count;
-                                    for (int j = 0; j < count; ++j, outP += outInc)
-                                    {
-                                        *outP = *p;
-                                    }
-                                    ++p;
+                                    return false;
                                 }
-                                else
+                                for (int j = 0; j < count; ++j, ++p, outP += outInc)
                                 {
-                                    count = -count;
-                                    for (int j = 0; j < count; ++j, ++p, outP += outInc)
-                                    {
-                                        *outP = *p;
-                                    }
+                                    *outP = *p;
                                 }
-                                i += count;
                             }
+                            i += count;
                         }
                     }
+                    p = channelEnd;
+                    return true;
+                }
 
-                    void readFloat(
-                        FileSystem::FileIO& io,
-                        uint8_t*            out,
-                        size_t              size,
-                        size_t              channels)
+                namespace
+                {
+                    bool readFloat(
+                        const uint8_t*& p,
+                        const uint8_t*  end,
+                        uint8_t*        out,
+                        size_t          size,
+                        size_t          channels)
                     {
-                        int16_t _size = 0;
-                        io.read16(&_size);
-                        std::vector<uint8_t> buf(_size);
-                        io.read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
+                        const uint8_t* channelEnd = nullptr;
+                        if (!readChannel(p, end, channelEnd) ||
+                            static_cast<size_t>(channelEnd - p) < size * 4)
+                        {
+                            return false;
+                        }
+                        const uint8_t* inP = p;
                         const size_t outInc = channels * 4;
                         if (Memory::Endian::LSB == Memory::getEndian())
                         {
-                            for (size_t i = 0; i < size; ++i, p += 4, out += outInc)
+                            for (size_t i = 0; i < size; ++i, inP += 4, out += outInc)
                             {
-                                out[0] = p[3];
-                                out[1] = p[2];
-                                out[2] = p[1];
-                                out[3] = p[0];
+                                out[0] = inP[3];
+                                out[1] = inP[2];
+                                out[2] = inP[1];
+                                out[3] = inP[0];
                             }
                         }
                         else
                         {
-                            for (size_t i = 0; i < size; ++i, p += 4, out += outInc)
+                            for (size_t i = 0; i < size; ++i, inP += 4, out += outInc)
                             {
-                                out[0] = p[0];
-                                out[1] = p[1];
-                                out[2] = p[2];
-                                out[3] = p[3];
+                                out[0] = inP[0];
+                                out[1] = inP[1];
+                                out[2] = inP[2];
+                                out[3] = inP[3];
                             }
                         }
+                        p = channelEnd;
+                        return true;
                     }
 
                 } // namespace
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
-                    std::shared_ptr<Image::Image> out;
                     FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
-                    out = Image::Image::create(info.video[0].info);
+                    io.setMMap(_options.mmap);
+                    std::vector<int32_t> rleOffset;
+                    const auto info = _open(fileName, io, rleOffset);
+                    auto out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
+                    // The whole file is read once and the scanlines are decoded
+                    // in parallel chunks, using the offset table to find the
+                    // start of each scanline.
+                    const size_t pos = io.getPos();
+                    const size_t size = io.getSize() - pos;
+                    std::vector<uint8_t> buf;
+                    const uint8_t* inP = nullptr;
+                    if (io.isMMap())
+                    {
+                        io.mmapWillNeed(size);
+                        inP = io.mmapP();
+                    }
+                    else
+                    {
+                        buf.resize(size);
+                        io.read(buf.data(), size);
+                        inP = buf.data();
+                    }
+                    const uint8_t* end = inP + size;
+
                     const size_t w = info.video[0].info.size.w;
                     const size_t h = info.video[0].info.size.h;
                     const size_t channels = Image::getChannelCount(info.video[0].info.type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(info.video[0].info.type));
                     const Image::DataType dataType = Image::getDataType(info.video[0].info.type);
-                    uint8_t* dataP = out->getData();
-                    for (uint16_t y = 0; y < h; ++y, dataP += w * channels * bytes)
-                    {
-                        io.setPos(_rleOffset[y]);
-                        for (int c = 0; c < channels; ++c)
+                    parallelChunks(
+                        h,
+                        _options.rleThreadCount,
+                        [&out, &rleOffset, inP, end, pos, size, w, channels, bytes, dataType](size_t begin, size_t endY)
                         {
-                            if (Image::DataType::F32 == dataType)
-                            {
-                                readFloat(io, dataP + c * bytes, w, channels);
-                            }
-                            else
+                            for (size_t y = begin; y < endY; ++y)
                             {
-                                readRle(io, dataP + c * bytes, w, channels, bytes);
+                                if (rleOffset[y] < 0 ||
+                                    static_cast<size_t>(rleOffset[y]) < pos ||
+                                    static_cast<size_t>(rleOffset[y]) - pos > size)
+                                {
+                                    throw FileSystem::Error(DJV_TEXT("Read error."));
+                                }
+                                const uint8_t* p = inP + rleOffset[y] - pos;
+                                uint8_t* dataP = out->getData(static_cast<uint16_t>(y));
+                                for (size_t c = 0; c < channels; ++c)
+                                {
+                                    const bool r = Image::DataType::F32 == dataType ?
+                                        readFloat(p, end, dataP + c * bytes, w, channels) :
+                                        readRle(p, end, dataP + c * bytes, w, channels, bytes);
+                                    if (!r)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Read error."));
+                                    }
+                                }
                             }
-                        }
-                    }
+                        });
 
                     return out;
                 }
@@ -241,11 +318,19 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io)
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
+                }
+
+                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io, std::vector<int32_t>& rleOffset)
                 {
                     // Open the file.
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
-                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    if (!_openReadAhead(fileName, io))
+                    {
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    }
 
                     // Read the header.
                     Header header;
@@ -258,8 +343,8 @@ namespace djv
                     const int h = header.active[3] - header.active[2] + 1;
 
                     // Read the scanline table.
-                    _rleOffset.resize(h);
-                    io.read32(_rleOffset.data(), h);
+                    rleOffset.resize(h);
+                    io.read32(rleOffset.data(), h);
 
                     // Get file information.
                     if (header.matteChannels > 1)
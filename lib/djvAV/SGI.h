@@ -46,6 +46,18 @@ namespace djv
                 static const std::string pluginName = "SGI";
                 static const std::set<std::string> fileExtensions = { ".sgi", ".rgba", ".rgb", ".bw" };
 
+                //! Decode a run-length encoded scanline of one channel with one
+                //! or two byte words to every stride bytes of the output.
+                //! Returns false if the data is truncated or overflows the
+                //! scanline.
+                bool readRle(
+                    const uint8_t* in,
+                    const uint8_t* end,
+                    uint8_t*       out,
+                    size_t         size,
+                    size_t         bytes,
+                    size_t         stride);
+
                 //! This class provides the SGI file reader.
                 class Read : public ISequenceRead
                 {
@@ -60,19 +72,25 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    bool _hasReadAhead() const override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO&);
-
-                    bool _compression = false;
-                    std::vector<uint32_t> _rleOffset;
-                    std::vector<uint32_t> _rleSize;
+                    //! The run-length encoding offset and size tables are only
+                    //! read if the file is compressed.
+                    Info _open(
+                        const std::string &,
+                        Core::FileSystem::FileIO&,
+                        bool& compression,
+                        std::vector<uint32_t>& rleOffset,
+                        std::vector<uint32_t>& rleSize);
                 };
                 
                 //! This class provides the SGI file I/O plugin.
@@ -53,114 +53,91 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    bool compression = false;
+                    std::vector<uint32_t> rleOffset;
+                    std::vector<uint32_t> rleSize;
+                    return _open(fileName, io, compression, rleOffset, rleSize);
                 }
 
                 namespace
                 {
-                    template<typename T>
-                    bool read(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        bool        endian)
+                    //! Decode a run-length encoded scanline of one channel. The
+                    //! run information is stored in the low byte of each word,
+                    //! and the words are copied without endian conversion to
+                    //! every stride bytes of the output.
+                    template<size_t N>
+                    bool readRleWords(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         stride)
                     {
-                        const size_t bytes = sizeof(T);
-                        const T* inP = reinterpret_cast<const T*>(in);
-                        T* outP = reinterpret_cast<T*>(out);
-                        const T* const outEnd = outP + size;
-                        while (outP < outEnd)
+                        for (size_t i = 0; i < size;)
                         {
                             // Information.
-                            if (inP > end)
+                            if (in + N > end)
                             {
                                 return false;
                             }
-                            const size_t count = *inP & 0x7f;
-                            const bool   run = !(*inP & 0x80);
-                            const size_t length = run ? 1 : count;
-                            ++inP;
-
-                            // Unpack.
-                            if (inP + length > end)
+                            const uint8_t info = in[N - 1];
+                            const size_t count = info & 0x7f;
+                            in += N;
+                            if (!count || i + count > size)
                             {
                                 return false;
                             }
-                            if (run)
+
+                            // Unpack.
+                            if (info & 0x80)
                             {
-                                if (!endian)
+                                if (in + count * N > end)
                                 {
-                                    for (size_t j = 0; j < count; ++j, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
+                                    return false;
                                 }
-                                else
+                                for (size_t j = 0; j < count; ++j, in += N, out += stride)
                                 {
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    if (count > 1)
+                                    for (size_t k = 0; k < N; ++k)
                                     {
-                                        for (size_t j = 0; j < count - 1; ++j)
-                                        {
-                                            outP[1 + j] = outP[0];
-                                        }
+                                        out[k] = in[k];
                                     }
-                                    outP += count;
                                 }
-                                ++inP;
                             }
                             else
                             {
-                                if (!endian)
+                                if (in + N > end)
                                 {
-                                    for (size_t j = 0; j < length; ++j, ++inP, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
+                                    return false;
                                 }
-                                else
+                                for (size_t j = 0; j < count; ++j, out += stride)
                                 {
-                                    Memory::endian(inP, outP, length, bytes);
-                                    inP += length;
-                                    outP += length;
+                                    for (size_t k = 0; k < N; ++k)
+                                    {
+                                        out[k] = in[k];
+                                    }
                                 }
+                                in += N;
                             }
+                            i += count;
                         }
                         return true;
                     }
 
-                    bool readRle(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        size_t      bytes,
-                        bool        endian)
-                    {
-                        switch (bytes)
-                        {
-                        case 1: return read<uint8_t>(in, end, out, size, false);
-                        case 2: return read<uint16_t>(in, end, out, size, endian);
-                        default: break;
-                        }
-                        return false;
-                    }
-
                     void planarInterleave(
-                        const std::shared_ptr<Image::Data>& in,
+                        const uint8_t* in,
                         std::shared_ptr<Image::Image>& out)
                     {
                         const size_t w = out->getWidth();
@@ -172,7 +149,7 @@ namespace djv
                         {
                             for (size_t y = 0; y < h; ++y)
                             {
-                                const uint8_t* inP = in->getData() + (c * in->getHeight() + y) * in->getWidth() * channelByteCount;
+                                const uint8_t* inP = in + (c * h + y) * w * channelByteCount;
                                 uint8_t* outP = out->getData(0, y) + c * channelByteCount;
                                 for (
                                     size_t x = 0;
@@ -209,59 +186,127 @@ namespace djv
 
                 } // namespace
 
+                bool readRle(
+                    const uint8_t* in,
+                    const uint8_t* end,
+                    uint8_t*       out,
+                    size_t         size,
+                    size_t         bytes,
+                    size_t         stride)
+                {
+                    return 1 == bytes ?
+                        readRleWords<1>(in, end, out, size, stride) :
+                        readRleWords<2>(in, end, out, size, stride);
+                }
+
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
-                    std::shared_ptr<Image::Image> out;
-                    FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
-                    out = Image::Image::create(info.video[0].info);
-                    out->setPluginName(pluginName);
+                    auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                    io->setMMap(_options.mmap);
+                    bool compression = false;
+                    std::vector<uint32_t> rleOffset;
+                    std::vector<uint32_t> rleSize;
+                    const auto info = _open(fileName, *io, compression, rleOffset, rleSize);
 
-                    const size_t pos = io.getPos();
-                    const size_t size = io.getSize() - pos;
+                    const size_t pos = io->getPos();
+                    const size_t size = io->getSize() - pos;
                     const Image::Info& imageInfo = info.video[0].info;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(imageInfo.type));
-                    const size_t dataByteCount = out->getDataByteCount();
-                    std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
-                    if (!_compression)
+                    const size_t dataByteCount = imageInfo.getDataByteCount();
+
+                    // With memory mapping 8-bit data and run-length encoded data
+                    // are used directly from the file instead of being copied to
+                    // a temporary buffer.
+                    const uint8_t* fileP = nullptr;
+                    if (io->isMMap() && (1 == bytes || compression))
                     {
-                        if (1 == bytes)
+                        io->mmapWillNeed(size);
+                        fileP = io->mmapP();
+                    }
+
+                    std::shared_ptr<Image::Image> out;
+                    if (fileP && !compression && 1 == channels && size >= dataByteCount)
+                    {
+                        // A single channel does not need to be interleaved, so
+                        // the image can refer to the file.
+                        out = Image::Image::create(imageInfo, io);
+                        out->setPluginName(pluginName);
+                        return out;
+                    }
+                    out = Image::Image::create(imageInfo);
+                    out->setPluginName(pluginName);
+
+                    if (compression)
+                    {
+                        // The whole file is read once and the scanlines are
+                        // decoded in parallel chunks, using the offset table to
+                        // find the start of each scanline. The channels are
+                        // decoded directly to their interleaved positions.
+                        std::vector<uint8_t> rleData;
+                        const uint8_t* inP = fileP;
+                        if (!inP)
                         {
-                            io.readU8(tmp->getData(), dataByteCount);
+                            rleData.resize(size);
+                            io->read(rleData.data(), size);
+                            inP = rleData.data();
                         }
-                        else
+                        const size_t w = imageInfo.size.w;
+                        const size_t h = imageInfo.size.h;
+                        const size_t pixelByteCount = out->getPixelByteCount();
+                        parallelChunks(
+                            h,
+                            _options.rleThreadCount,
+                            [&out, &rleOffset, &rleSize, inP, pos, size, w, h, channels, bytes, pixelByteCount](size_t begin, size_t end)
+                            {
+                                for (size_t y = begin; y < end; ++y)
+                                {
+                                    for (size_t c = 0; c < channels; ++c)
+                                    {
+                                        const size_t offset = rleOffset[y + h * c];
+                                        const size_t rleByteCount = rleSize[y + h * c];
+                                        if (offset < pos || offset - pos > size || rleByteCount > size - (offset - pos))
+                                        {
+                                            throw FileSystem::Error(DJV_TEXT("Read error."));
+                                        }
+                                        const uint8_t* rleP = inP + offset - pos;
+                                        uint8_t* outP = out->getData(0, static_cast<uint16_t>(y)) + c * bytes;
+                                        if (!readRle(rleP, rleP + rleByteCount, outP, w, bytes, pixelByteCount))
+                                        {
+                                            throw FileSystem::Error(DJV_TEXT("Read error."));
+                                        }
+                                    }
+                                }
+                            });
+                        return out;
+                    }
+
+                    std::shared_ptr<Image::Data> tmp;
+                    const uint8_t* planarP = nullptr;
+                    if (fileP)
+                    {
+                        if (size < dataByteCount)
                         {
-                            io.read(tmp->getData(), size / bytes, bytes);
+                            throw FileSystem::Error(DJV_TEXT("Read error."));
                         }
+                        planarP = fileP;
                     }
                     else
                     {
-                        std::vector<uint8_t> rleData(size);
-                        io.read(rleData.data(), size / bytes, bytes);
-                        const uint8_t* inP = rleData.data();
-                        const uint8_t* end = inP + size;
-                        uint8_t* outP = tmp->getData();
-                        for (size_t c = 0; c < channels; ++c)
+                        tmp = Image::Data::create(imageInfo);
+                        if (1 == bytes)
                         {
-                            for (size_t y = 0; y < imageInfo.size.h; ++y, outP += imageInfo.size.w * bytes)
-                            {
-                                if (!readRle(
-                                    inP + _rleOffset[y + imageInfo.size.h * c] - pos,
-                                    end,
-                                    outP,
-                                    imageInfo.size.w,
-                                    bytes,
-                                    io.hasEndianConversion()))
-                                {
-                                    throw FileSystem::Error(DJV_TEXT("Read error."));
-                                }
-                            }
+                            io->readU8(tmp->getData(), dataByteCount);
+                        }
+                        else
+                        {
+                            io->read(tmp->getData(), size / bytes, bytes);
                         }
+                        planarP = tmp->getData();
                     }
 
                     // Interleave the image channels.
-                    planarInterleave(tmp, out);
+                    planarInterleave(planarP, out);
 
                     return out;
                 }
@@ -338,12 +383,34 @@ namespace djv
                 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO& io)
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
+                }
+
+                Info Read::_open(
+                    const std::string & fileName,
+                    FileSystem::FileIO& io,
+                    bool& compression,
+                    std::vector<uint32_t>& rleOffset,
+                    std::vector<uint32_t>& rleSize)
                 {
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
-                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    if (!_openReadAhead(fileName, io))
+                    {
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    }
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _compression);
+                    Header().read(io, imageInfo, compression);
+                    if (compression)
+                    {
+                        // Read the scanline offset and size tables.
+                        const size_t size = imageInfo.size.h * Image::getChannelCount(imageInfo.type);
+                        rleOffset.resize(size);
+                        rleSize.resize(size);
+                        io.readU32(rleOffset.data(), size);
+                        io.readU32(rleSize.data(), size);
+                    }
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -29,9 +29,14 @@
 
 #include <djvAV/SequenceIO.h>
 
+#include <djvAV/IOCacheManager.h>
+#include <djvAV/ImageCompressedData.h>
 #include <djvAV/ImageConvert.h>
+#include <djvAV/ImageUtil.h>
 
+#include <djvCore/AsyncFileIO.h>
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/LogSystem.h>
@@ -43,7 +48,11 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <cmath>
+#include <cstring>
+#include <deque>
 #include <future>
+#include <sstream>
 
 using namespace djv::Core;
 
@@ -58,19 +67,56 @@ namespace djv
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
 
+                //! \todo Should this be configurable?
+                const size_t headerTemplateMax = 16;
+
             } // namespace
 
             struct ISequenceRead::Future
             {
                 Frame::Number frame = Frame::invalid;
                 std::shared_ptr<Image::Image> image;
+                std::shared_ptr<Image::CompressedData> compressed;
+                bool cached = false;
+                DiskCacheKey diskCacheKey;
             };
 
+            namespace
+            {
+                struct ReadAhead
+                {
+                    std::string fileName;
+                    std::future<FileSystem::AsyncReadResult> future;
+                    bool requested = false;
+                };
+
+            } // namespace
+
             struct ISequenceRead::Private
             {
                 Frame::Number frame = Frame::invalid;
                 std::promise<Info> infoPromise;
-                std::vector<std::future<Future> > cacheFutures;
+                std::shared_ptr<ThreadPool> threadPool;
+                UID threadPoolClient = 0;
+                std::shared_ptr<CancelToken> cancelToken;
+                std::string diskCacheVariant;
+                std::map<std::vector<uint8_t>, Info> headerTemplates;
+                std::vector<Image::Info> headerTemplateInfo;
+                mutable std::mutex headerTemplateMutex;
+                std::deque<std::future<Future> > queueFutures;
+                std::deque<VideoFrame> queuePending;
+                bool queueDisplay = true;
+                bool queueRequestsFinished = false;
+                std::map<Frame::Index, std::future<Future> > cacheFutures;
+                std::shared_ptr<FileSystem::AsyncFileIO> asyncIO;
+                std::map<Frame::Index, ReadAhead> readAhead;
+                std::mutex readAheadMutex;
+                std::vector<Frame::Index> prefetchFrames;
+                std::deque<std::string> prefetchQueue;
+                double frameTime = 0.0;
+                std::mutex prefetchMutex;
+                std::condition_variable prefetchCV;
+                std::thread prefetchThread;
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
                 Frame::Number seek = Frame::invalid;
@@ -82,12 +128,59 @@ namespace djv
             void ISequenceRead::_init(
                 const FileSystem::FileInfo & fileInfo,
                 const ReadOptions& options,
+                const std::shared_ptr<ThreadPool>& threadPool,
+                const std::shared_ptr<CacheManager>& cacheManager,
                 const std::shared_ptr<ResourceSystem>& resourceSystem,
                 const std::shared_ptr<LogSystem>& logSystem)
             {
                 IRead::_init(fileInfo, options, resourceSystem, logSystem);
                 _speed = Time::Speed();
+                if (cacheManager)
+                {
+                    _cache.setManager(cacheManager);
+                }
+                _p->threadPool = threadPool;
+                _p->threadPoolClient = threadPool->addClient();
+                if (options.readAhead && _hasReadAhead())
+                {
+                    _p->asyncIO = FileSystem::AsyncFileIO::getGlobal();
+                }
+                _p->cancelToken = CancelToken::create();
+                if (options.proxy != Proxy::None || options.roi.isValid())
+                {
+                    std::stringstream ss;
+                    ss << options.proxy << " " <<
+                        options.roi.min.x << " " << options.roi.min.y << " " <<
+                        options.roi.max.x << " " << options.roi.max.y;
+                    _p->diskCacheVariant = ss.str();
+                }
                 _p->running = true;
+                if (options.prefetch)
+                {
+                    _p->prefetchThread = std::thread(
+                        [this]
+                    {
+                        DJV_PRIVATE_PTR();
+                        while (p.running)
+                        {
+                            std::string fileName;
+                            {
+                                std::unique_lock<std::mutex> lock(p.prefetchMutex);
+                                p.prefetchCV.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return _p->prefetchQueue.size() || !_p->running;
+                                    });
+                                if (!p.running)
+                                    break;
+                                fileName = p.prefetchQueue.front();
+                                p.prefetchQueue.pop_front();
+                            }
+                            FileSystem::FileIO::prefetch(fileName);
+                        }
+                    });
+                }
                 _p->thread = std::thread(
                     [this]
                 {
@@ -118,6 +211,10 @@ namespace djv
                     {
                         info = _readInfo(fileName);
                         info.fileName = _fileInfo.getFileName();
+                        for (auto& i : info.video)
+                        {
+                            i.info.size = getReadSize(i.info.size, _options);
+                        }
                         p.infoPromise.set_value(info);
                     }
                     catch (const std::exception&)
@@ -146,27 +243,45 @@ namespace djv
                         // Update the options.
                         size_t threadCount = 4;
                         bool playback = false;
+                        Time::Speed playbackSpeed;
+                        PlaybackMode playbackMode = PlaybackMode::Loop;
                         InOutPoints inOutPoints;
                         bool cacheEnabled = false;
                         size_t cacheMaxByteCount = 0;
+                        CacheCompressionStats cacheCompressionStats;
                         {
                             std::lock_guard<std::mutex> lock(_mutex);
                             threadCount = _threadCount;
                             playback = _playback;
+                            playbackSpeed = _playbackSpeed;
+                            playbackMode = _playbackMode;
                             inOutPoints = _inOutPoints;
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
+                            cacheCompressionStats = _cacheCompressionStats;
                         }
                         if (!cacheEnabled)
                         {
                             _cache.clear();
                         }
+                        size_t dataByteCount = 0;
                         if (info.video.size() && _options.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
+                            dataByteCount = info.video[_options.layer].info.getDataByteCount();
+                            if (_options.cacheCompression && cacheCompressionStats.compressedByteCount)
+                            {
+                                // Use the measured compression ratio to estimate
+                                // how many frames fit in the cache.
+                                dataByteCount = std::max(
+                                    static_cast<size_t>(dataByteCount / cacheCompressionStats.getRatio()),
+                                    static_cast<size_t>(1));
+                            }
                             _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
                             _cache.setSequenceSize(info.video[_options.layer].sequence.getSize());
                             _cache.setInOutPoints(inOutPoints);
+                            _cache.setPlayback(playback);
+                            _cache.setPlaybackSpeed(playbackSpeed);
+                            _cache.setPlaybackMode(playbackMode);
                         }
                         else
                         {
@@ -186,12 +301,12 @@ namespace djv
                                     return _hasWork();
                                 }))
                             {
-                                queueCount = _getQueueCount(playback ? (threadCount / 2) : 1);
                                 if (p.direction != _direction)
                                 {
                                     p.direction = _direction;
                                     _videoQueue.setFinished(false);
                                     _videoQueue.clearFrames();
+                                    _cancelRequests();
                                 }
                                 if (p.seek != Frame::invalid)
                                 {
@@ -199,7 +314,9 @@ namespace djv
                                     p.seek = Frame::invalid;
                                     _videoQueue.setFinished(false);
                                     _videoQueue.clearFrames();
+                                    _cancelRequests();
                                 }
+                                queueCount = _getQueueCount(playback ? (threadCount / 2) : 1);
                             }
                         }
                         if (seek != Frame::invalid)
@@ -213,18 +330,21 @@ namespace djv
                         }
 
                         // Fill the queue.
-                        size_t read = 0;
-                        if (queueCount > 0)
-                        {
-                            read = _readQueue(queueCount, cacheEnabled);
-                        }
+                        _readQueue(queueCount, cacheEnabled);
 
                         // Fill the cache.
                         if (cacheEnabled)
                         {
-                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints);
+                            _readCache(playback ? (threadCount / 2) : threadCount, dataByteCount);
                         }
 
+                        // Read the files for the next frames ahead of decoding
+                        // them.
+                        _readAhead(cacheEnabled);
+
+                        // Prefetch the files for the frames after those.
+                        _prefetch(_getPrefetchCount(threadCount, playback, playbackSpeed), cacheEnabled);
+
                         // Update information.
                         const auto now = std::chrono::system_clock::now();
                         std::chrono::duration<double> delta = now - p.infoTimer;
@@ -284,33 +404,129 @@ namespace djv
                     //! \todo How do we safely detach the thread here so we don't block?
                     p.thread.join();
                 }
+                if (p.prefetchThread.joinable())
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(p.prefetchMutex);
+                    }
+                    p.prefetchCV.notify_one();
+                    p.prefetchThread.join();
+                }
+                if (p.threadPool)
+                {
+                    p.threadPool->removeClient(p.threadPoolClient);
+                }
             }
 
             bool ISequenceRead::_hasWork() const
             {
-                const bool queue = (_videoQueue.getCount() < _videoQueue.getMax()) && !_videoQueue.isFinished();
-                const bool seek = _p->seek != Frame::invalid;
-                const bool direction = _p->direction != _direction;
-                return queue || seek || direction;
+                DJV_PRIVATE_PTR();
+                const bool queue =
+                    (_videoQueue.getCount() + p.queueFutures.size() + p.queuePending.size() < _videoQueue.getMax()) &&
+                    !_videoQueue.isFinished() &&
+                    !p.queueRequestsFinished;
+                const bool results =
+                    p.queueFutures.size() &&
+                    p.queueFutures.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                const bool pending =
+                    p.queuePending.size() &&
+                    _videoQueue.getCount() < _videoQueue.getMax();
+                const bool seek = p.seek != Frame::invalid;
+                const bool direction = p.direction != _direction;
+                return queue || results || pending || seek || direction;
             }
 
             size_t ISequenceRead::_getQueueCount(size_t threadCount) const
             {
-                const size_t queueMax = _videoQueue.getMax() - _videoQueue.getCount();
-                return std::min(queueMax, threadCount);
+                DJV_PRIVATE_PTR();
+                size_t out = 0;
+                const size_t count = _videoQueue.getCount() + p.queueFutures.size() + p.queuePending.size();
+                if (!p.queueRequestsFinished && count < _videoQueue.getMax() && p.queueFutures.size() < threadCount)
+                {
+                    out = std::min(_videoQueue.getMax() - count, threadCount - p.queueFutures.size());
+                }
+                return out;
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Frame::Number i,
+                const std::string& fileName,
+                JobPriority priority,
+                bool compress)
             {
-                return std::async(
-                    std::launch::async,
-                    [this, i, fileName]
+                DJV_PRIVATE_PTR();
+                auto promise = std::make_shared<std::promise<Future> >();
+                auto out = promise->get_future();
+                if (p.asyncIO)
+                {
+                    std::lock_guard<std::mutex> lock(p.readAheadMutex);
+                    const auto j = p.readAhead.find(i);
+                    if (j != p.readAhead.end())
                     {
-                        Future out;
-                        out.frame = i;
+                        j->second.requested = true;
+                    }
+                }
+                p.threadPool->submit<void>(
+                    p.threadPoolClient,
+                    priority,
+                    p.cancelToken,
+                    [this, i, fileName, priority, compress, promise]
+                    {
+                        Future future;
+                        future.frame = i;
                         try
                         {
-                            out.image = _readImage(fileName);
+                            // Check the disk cache before decoding the frame.
+                            if (auto diskCache = _cache.getManager()->getDiskCache())
+                            {
+                                const FileSystem::FileInfo fileInfo(fileName);
+                                future.diskCacheKey = DiskCacheKey(fileName, fileInfo.getTime(), _options.layer, i);
+                                future.diskCacheKey.variant = _p->diskCacheVariant;
+                                future.image = diskCache->get(future.diskCacheKey);
+                            }
+                            if (!future.image)
+                            {
+                                const auto start = std::chrono::steady_clock::now();
+                                future.image = _readImage(fileName);
+                                if (future.image && !_hasProxy() && !isFullRead(future.image->getSize(), _options))
+                                {
+                                    future.image = Image::decimate(
+                                        future.image,
+                                        getReadRegion(future.image->getSize(), _options),
+                                        getProxyScale(_options.proxy));
+                                }
+                                if (_options.prefetch)
+                                {
+                                    // Keep a running average of the time to read
+                                    // and decode a frame.
+                                    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+                                    std::lock_guard<std::mutex> lock(_p->prefetchMutex);
+                                    _p->frameTime = _p->frameTime > 0.0 ?
+                                        (_p->frameTime * .9 + delta.count() * .1) :
+                                        delta.count();
+                                }
+                            }
+                            if (compress && future.image)
+                            {
+                                const auto start = std::chrono::steady_clock::now();
+                                future.compressed = Image::CompressedData::create(*future.image);
+                                const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+                                {
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    auto& stats = _cacheCompressionStats;
+                                    ++stats.frameCount;
+                                    stats.byteCount += future.compressed->getDataByteCount();
+                                    stats.compressedByteCount += future.compressed->getCompressedByteCount();
+                                    stats.compressTime += delta.count();
+                                }
+
+                                // Frames that are only being added to the cache
+                                // do not need to keep the image.
+                                if (JobPriority::Cache == priority || JobPriority::ReadBehind == priority)
+                                {
+                                    future.image.reset();
+                                }
+                            }
                         }
                         catch (const std::exception& e)
                         {
@@ -318,42 +534,133 @@ namespace djv
                             ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
                             _logSystem->log("djv::AV::ISequenceRead", ss.str(), LogLevel::Error);
                         }
-                        return out;
+                        if (_p->asyncIO)
+                        {
+                            // Release the file contents if they were not used.
+                            std::lock_guard<std::mutex> lock(_p->readAheadMutex);
+                            const auto j = _p->readAhead.find(i);
+                            if (j != _p->readAhead.end() && fileName == j->second.fileName)
+                            {
+                                _p->readAhead.erase(j);
+                            }
+                        }
+                        promise->set_value(future);
+
+                        // Wake up the reader thread. The mutex is locked so the
+                        // notification cannot be missed between the thread
+                        // checking for work and starting to wait.
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                        }
+                        _p->queueCV.notify_one();
+                    });
+                return out;
+            }
+
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Frame::Number i,
+                const std::shared_ptr<Image::CompressedData>& compressed,
+                JobPriority priority)
+            {
+                DJV_PRIVATE_PTR();
+                auto promise = std::make_shared<std::promise<Future> >();
+                auto out = promise->get_future();
+                p.threadPool->submit<void>(
+                    p.threadPoolClient,
+                    priority,
+                    p.cancelToken,
+                    [this, i, compressed, promise]
+                    {
+                        Future future;
+                        future.frame = i;
+                        future.cached = true;
+                        const auto start = std::chrono::steady_clock::now();
+                        future.image = compressed->decompress();
+                        const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+                        promise->set_value(future);
+
+                        // Wake up the reader thread, see above.
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            ++_cacheCompressionStats.decompressCount;
+                            _cacheCompressionStats.decompressTime += delta.count();
+                        }
+                        _p->queueCV.notify_one();
                     });
+                return out;
+            }
+
+            void ISequenceRead::_cancelRequests()
+            {
+                DJV_PRIVATE_PTR();
+                p.cancelToken->cancel();
+                p.cancelToken = CancelToken::create();
+                p.queueFutures.clear();
+                p.queuePending.clear();
+                p.queueDisplay = true;
+                p.queueRequestsFinished = false;
+                p.cacheFutures.clear();
+                {
+                    std::lock_guard<std::mutex> lock(p.readAheadMutex);
+                    p.readAhead.clear();
+                }
+                p.prefetchFrames.clear();
+                std::lock_guard<std::mutex> lock(p.prefetchMutex);
+                p.prefetchQueue.clear();
             }
 
-            size_t ISequenceRead::_readQueue(size_t count, bool cacheEnabled)
+            void ISequenceRead::_readQueue(size_t count, bool cacheEnabled)
             {
                 DJV_PRIVATE_PTR();
 
-                // Get frames to be added to the queue.
+                // Request frames to be added to the queue. The first frame after
+                // a seek is the one that will be displayed so it gets the highest
+                // priority.
                 const size_t sequenceSize = _sequence.getSize();
-                std::vector<std::pair<Frame::Number, std::shared_ptr<Image::Image> > > images;
-                std::vector<std::future<Future> > futures;
-                for (size_t i = 0; i < count; ++i)
+                for (size_t i = 0; i < count && !p.queueRequestsFinished; ++i)
                 {
+                    const JobPriority priority = p.queueDisplay ? JobPriority::Display : JobPriority::Queue;
+                    std::shared_ptr<Image::CompressedData> compressedImage;
                     std::shared_ptr<Image::Image> cachedImage;
-                    if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    if (cacheEnabled && _cache.getCompressed(p.frame, compressedImage))
                     {
-                        images.push_back(std::make_pair(p.frame, cachedImage));
+                        // Decompress the frame with the thread pool.
+                        p.queueFutures.push_back(_getFuture(p.frame, compressedImage, priority));
+                    }
+                    else if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    {
+                        Future future;
+                        future.frame = p.frame;
+                        future.image = cachedImage;
+                        future.cached = true;
+                        std::promise<Future> promise;
+                        promise.set_value(future);
+                        p.queueFutures.push_back(promise.get_future());
                     }
                     else
                     {
+                        // Don't delay the frame to be displayed by compressing
+                        // it.
+                        const bool compress =
+                            cacheEnabled &&
+                            _options.cacheCompression &&
+                            priority != JobPriority::Display;
                         if (sequenceSize)
                         {
                             if (p.frame >= 0 && p.frame < sequenceSize)
                             {
                                 const Frame::Number frameNumber = _sequence.getFrame(p.frame);
                                 const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                p.queueFutures.push_back(_getFuture(p.frame, fileName, priority, compress));
                             }
                         }
                         else
                         {
                             const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            p.queueFutures.push_back(_getFuture(p.frame, fileName, priority, compress));
                         }
                     }
+                    p.queueDisplay = false;
 
                     if (sequenceSize)
                     {
@@ -376,147 +683,440 @@ namespace djv
                         default: break;
                         }
                     }
-                }
 
-                // Get the results.
-                for (auto& future : futures)
-                {
-                    const auto result = future.get();
-                    if (result.image)
+                    if (Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceSize))
                     {
-                        images.push_back(std::make_pair(result.frame, result.image));
-                        if (cacheEnabled)
-                        {
-#if defined(DJV_MMAP)
-                            result.image->detach();
-#endif // DJV_MMAP
-                            _cache.add(result.frame, result.image);
-                        }
+                        p.queueRequestsFinished = true;
                     }
                 }
 
-                // Add the frames to the queue.
+                // Get the results that are ready, in the order they were requested.
+                while (p.queueFutures.size() &&
+                    p.queueFutures.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
-                    std::lock_guard<std::mutex> lock(_mutex);
-                    for (const auto& i : images)
+                    const auto result = p.queueFutures.front().get();
+                    p.queueFutures.pop_front();
+                    if (result.image)
                     {
-                        if (_videoQueue.getCount() >= _videoQueue.getMax())
+                        p.queuePending.push_back(VideoFrame(result.frame, result.image));
+                        if (cacheEnabled && !result.cached && _cache.getWindow().contains(result.frame))
                         {
-                            break;
+                            if (result.compressed)
+                            {
+                                _cache.add(result.frame, result.compressed, result.diskCacheKey);
+                            }
+                            else
+                            {
+                                // Copy memory-mapped images before they are
+                                // cached, the cache should not keep files open.
+                                result.image->detach();
+                                _cache.add(result.frame, result.image, result.diskCacheKey);
+                            }
                         }
-                        _videoQueue.addFrame(VideoFrame(i.first, i.second));
                     }
                 }
 
-                if (Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceSize))
+                // Add the frames to the queue. Frames that do not fit are kept
+                // until there is room instead of being decoded again.
+                while (p.queuePending.size() &&
+                    _videoQueue.getCount() < _videoQueue.getMax() &&
+                    _videoQueue.addFrame(p.queuePending.front()))
+                {
+                    p.queuePending.pop_front();
+                }
+                if (p.queueRequestsFinished && p.queueFutures.empty() && p.queuePending.empty())
                 {
-                    std::lock_guard<std::mutex> lock(_mutex);
                     _videoQueue.setFinished(true);
                 }
-
-                return futures.size();
             }
 
-            void ISequenceRead::_readCache(size_t count, const AV::IO::InOutPoints& inOutPoints)
+            void ISequenceRead::_readCache(size_t count, size_t dataByteCount)
             {
                 DJV_PRIVATE_PTR();
 
                 // Get frames to be added to the cache.
-                Frame::Number frame = Frame::invalid;
-                {
-                    std::lock_guard<std::mutex> lock(_mutex);
-                    if (_videoQueue.getCount())
-                    {
-                        frame = _videoQueue.getFrame().frame;
-                    }
-                }
+                const Frame::Number frame = _videoQueue.getFrameNumber();
                 if (count > 0 && frame != Frame::invalid)
                 {
-                    const size_t sequenceSize = _sequence.getSize();
-                    const auto range = inOutPoints.getRange(_sequence.getSize());
                     _cache.setDirection(p.direction);
                     _cache.setCurrentFrame(frame);
-                    const size_t readBehind = _cache.getReadBehind();
-                    switch (p.direction)
-                    {
-                    case Direction::Forward:
+
+                    // Only request as many frames as will fit in the memory that
+                    // is available to this reader, otherwise the frames would be
+                    // evicted as soon as they are added.
+                    size_t availableByteCount = _cache.getAvailableByteCount();
+                    const size_t pendingByteCount = p.cacheFutures.size() * dataByteCount;
+                    availableByteCount = availableByteCount > pendingByteCount ?
+                        (availableByteCount - pendingByteCount) :
+                        0;
+
+                    // Request the frames in the order given by the cache window.
+                    bool done = false;
+                    for (const auto& span : _cache.getWindow().spans)
                     {
-                        for (size_t i = 0; i < readBehind; ++i)
-                        {
-                            --frame;
-                            if (frame < range.min)
-                            {
-                                frame = range.max;
-                            }
-                        }
-                        const size_t max = std::min(_cache.getMax(), sequenceSize);
-                        for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
+                        const size_t size = span.getSize();
+                        for (size_t i = 0; i < size; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (p.cacheFutures.size() >= count)
                             {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                done = true;
+                                break;
                             }
-                            ++frame;
-                            if (frame > range.max)
+                            const Frame::Index index = span.getFrame(i);
+                            if (!_cache.contains(index) && p.cacheFutures.find(index) == p.cacheFutures.end())
                             {
-                                frame = range.min;
+                                if (availableByteCount < dataByteCount)
+                                {
+                                    done = true;
+                                    break;
+                                }
+                                availableByteCount -= dataByteCount;
+                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(index));
+                                p.cacheFutures[index] = _getFuture(
+                                    index,
+                                    fileName,
+                                    span.readBehind ? JobPriority::ReadBehind : JobPriority::Cache,
+                                    _options.cacheCompression);
                             }
                         }
-                        break;
+                        if (done)
+                            break;
                     }
-                    case Direction::Reverse:
+                }
+
+                // Get the results.
+                auto i = p.cacheFutures.begin();
+                while (i != p.cacheFutures.end())
+                {
+                    if (i->second.valid() &&
+                        i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        for (size_t i = 0; i < readBehind; ++i)
+                        const auto result = i->second.get();
+                        if (result.compressed)
                         {
-                            ++frame;
-                            if (frame > range.max)
-                            {
-                                frame = range.min;
-                            }
+                            _cache.add(result.frame, result.compressed, result.diskCacheKey);
                         }
-                        const size_t max = std::min(_cache.getMax(), sequenceSize);
-                        for (Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
+                        else if (result.image)
                         {
-                            if (!_cache.contains(frame))
-                            {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
-                            }
-                            --frame;
-                            if (frame < range.min)
+                            result.image->detach();
+                            _cache.add(result.frame, result.image, result.diskCacheKey);
+                        }
+                        i = p.cacheFutures.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+
+            void ISequenceRead::_readAhead(bool cacheEnabled)
+            {
+                DJV_PRIVATE_PTR();
+                const size_t sequenceSize = _sequence.getSize();
+                if (!p.asyncIO || !sequenceSize)
+                    return;
+
+                // Get the frames that will be decoded next, first the frames
+                // that have not been requested for the queue and then the
+                // frames in the cache window.
+                const size_t count = _options.readAhead;
+                std::vector<Frame::Index> frames;
+                if (!p.queueRequestsFinished)
+                {
+                    Frame::Index frame = p.frame;
+                    for (size_t i = 0; i < count && frame >= 0 && frame < static_cast<Frame::Index>(sequenceSize); ++i)
+                    {
+                        frames.push_back(frame);
+                        switch (p.direction)
+                        {
+                        case Direction::Forward:
+                            frame = frame < static_cast<Frame::Index>(sequenceSize) - 1 ? (frame + 1) : 0;
+                            break;
+                        case Direction::Reverse:
+                            frame = frame > 0 ? (frame - 1) : (static_cast<Frame::Index>(sequenceSize) - 1);
+                            break;
+                        default: break;
+                        }
+                        if (frame == frames[0])
+                            break;
+                    }
+                }
+                if (cacheEnabled)
+                {
+                    for (const auto& span : _cache.getWindow().spans)
+                    {
+                        const size_t size = span.getSize();
+                        for (size_t i = 0; i < size && frames.size() < count; ++i)
+                        {
+                            const Frame::Index index = span.getFrame(i);
+                            if (!_cache.contains(index) &&
+                                p.cacheFutures.find(index) == p.cacheFutures.end() &&
+                                std::find(frames.begin(), frames.end(), index) == frames.end())
                             {
-                                frame = range.max;
+                                frames.push_back(index);
                             }
                         }
-                        break;
                     }
+                }
+
+                std::lock_guard<std::mutex> lock(p.readAheadMutex);
+
+                // Discard the frames that are no longer needed, unless they
+                // have already been requested for decoding.
+                auto i = p.readAhead.begin();
+                while (i != p.readAhead.end())
+                {
+                    if (!i->second.requested &&
+                        std::find(frames.begin(), frames.end(), i->first) == frames.end())
+                    {
+                        i = p.readAhead.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+
+                // Submit the new reads together so they are in flight at the
+                // same time.
+                std::vector<Frame::Index> requestFrames;
+                std::vector<FileSystem::AsyncReadRequest> requests;
+                for (const auto& frame : frames)
+                {
+                    if (p.readAhead.find(frame) == p.readAhead.end())
+                    {
+                        requestFrames.push_back(frame);
+                        requests.push_back(FileSystem::AsyncReadRequest(_fileInfo.getFileName(_sequence.getFrame(frame))));
+                    }
+                }
+                if (requests.size())
+                {
+                    auto futures = p.asyncIO->read(requests);
+                    for (size_t j = 0; j < futures.size(); ++j)
+                    {
+                        ReadAhead readAhead;
+                        readAhead.fileName = requests[j].fileName;
+                        readAhead.future = std::move(futures[j]);
+                        p.readAhead[requestFrames[j]] = std::move(readAhead);
+                    }
+                }
+            }
+
+            size_t ISequenceRead::_getPrefetchCount(size_t threadCount, bool playback, const Time::Speed& speed) const
+            {
+                DJV_PRIVATE_PTR();
+                size_t out = _options.prefetch;
+                double frameTime = 0.0;
+                {
+                    std::lock_guard<std::mutex> lock(p.prefetchMutex);
+                    frameTime = p.frameTime;
+                }
+                if (out && frameTime > 0.0)
+                {
+                    // Prefetch the frames that will be consumed in twice the
+                    // time it takes to read and decode a frame, so slower
+                    // storage or decoding prefetches further ahead.
+                    const double rate = playback ?
+                        std::abs(speed.toFloat()) :
+                        (std::max(threadCount, static_cast<size_t>(1)) / frameTime);
+                    const size_t count = static_cast<size_t>(std::ceil(rate * frameTime * 2.0));
+                    out = std::max(std::min(count, out), static_cast<size_t>(1));
+                }
+                return out;
+            }
+
+            void ISequenceRead::_prefetch(size_t count, bool cacheEnabled)
+            {
+                DJV_PRIVATE_PTR();
+                const size_t sequenceSize = _sequence.getSize();
+                if (!count ||
+                    !sequenceSize ||
+                    p.queueRequestsFinished ||
+                    p.frame < 0 ||
+                    p.frame >= static_cast<Frame::Index>(sequenceSize))
+                    return;
+
+                // Get the next frames that have not been decoded or requested.
+                std::vector<Frame::Index> frames;
+                Frame::Index frame = p.frame;
+                for (size_t i = 0; i < sequenceSize && frames.size() < count; ++i)
+                {
+                    if (!(cacheEnabled && _cache.contains(frame)) &&
+                        p.cacheFutures.find(frame) == p.cacheFutures.end())
+                    {
+                        frames.push_back(frame);
+                    }
+                    switch (p.direction)
+                    {
+                    case Direction::Forward:
+                        frame = frame < static_cast<Frame::Index>(sequenceSize) - 1 ? (frame + 1) : 0;
+                        break;
+                    case Direction::Reverse:
+                        frame = frame > 0 ? (frame - 1) : (static_cast<Frame::Index>(sequenceSize) - 1);
+                        break;
                     default: break;
                     }
                 }
 
-                // Get the results.
-                auto i = p.cacheFutures.begin();
-                while (i != p.cacheFutures.end())
+                // Queue the files that have not already been prefetched.
+                bool notify = false;
                 {
-                    if (i->valid() &&
-                        i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    std::lock_guard<std::mutex> lock(p.prefetchMutex);
+                    for (const auto& i : frames)
                     {
-                        const auto result = i->get();
-                        if (result.image)
+                        if (std::find(p.prefetchFrames.begin(), p.prefetchFrames.end(), i) == p.prefetchFrames.end())
                         {
-#if defined(DJV_MMAP)
-                            result.image->detach();
-#endif // DJV_MMAP
-                            _cache.add(result.frame, result.image);
+                            p.prefetchQueue.push_back(_fileInfo.getFileName(_sequence.getFrame(i)));
+                            notify = true;
                         }
-                        i = p.cacheFutures.erase(i);
+                    }
+                    while (p.prefetchQueue.size() > count)
+                    {
+                        p.prefetchQueue.pop_front();
+                    }
+                }
+                p.prefetchFrames = std::move(frames);
+                if (notify)
+                {
+                    p.prefetchCV.notify_one();
+                }
+            }
+
+            bool ISequenceRead::_hasReadAhead() const
+            {
+                return false;
+            }
+
+            bool ISequenceRead::_getHeaderTemplate(const std::vector<uint8_t>& key, Info& out) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.headerTemplateMutex);
+                const auto i = p.headerTemplates.find(key);
+                if (i != p.headerTemplates.end())
+                {
+                    out = i->second;
+                    return true;
+                }
+                return false;
+            }
+
+            void ISequenceRead::_addHeaderTemplate(const std::vector<uint8_t>& key, const Info& info)
+            {
+                DJV_PRIVATE_PTR();
+                bool mismatch = false;
+                {
+                    std::lock_guard<std::mutex> lock(p.headerTemplateMutex);
+                    std::vector<Image::Info> imageInfo;
+                    for (const auto& i : info.video)
+                    {
+                        imageInfo.push_back(i.info);
+                    }
+                    if (p.headerTemplates.empty())
+                    {
+                        p.headerTemplateInfo = imageInfo;
+                    }
+                    else if (imageInfo != p.headerTemplateInfo)
+                    {
+                        mismatch = true;
+                    }
+                    if (p.headerTemplates.size() < headerTemplateMax)
+                    {
+                        p.headerTemplates[key] = info;
+                    }
+                }
+                if (mismatch)
+                {
+                    std::stringstream ss;
+                    ss << DJV_TEXT("The file") << " '" << info.fileName << "' " <<
+                        DJV_TEXT("does not have the same format as the first file in the sequence") << ".";
+                    _logSystem->log("djv::AV::ISequenceRead", ss.str(), LogLevel::Warning);
+                }
+            }
+
+            bool ISequenceRead::_hasProxy() const
+            {
+                return false;
+            }
+
+            std::shared_ptr<Image::Image> ISequenceRead::_readScanlines(
+                FileSystem::FileIO& io,
+                const Image::Info& info,
+                const ReadOptions& options)
+            {
+                const BBox2i region = getReadRegion(info.size, options);
+                const int scale = static_cast<int>(getProxyScale(options.proxy));
+                auto outInfo = info;
+                outInfo.size = getReadSize(info.size, options);
+                auto out = Image::Image::create(outInfo);
+                const size_t pos = io.getPos();
+                const size_t pixelByteCount = info.getPixelByteCount();
+                const size_t scanlineByteCount = info.getScanlineByteCount();
+                const bool mirrorX = info.layout.mirror.x;
+                const bool mirrorY = info.layout.mirror.y;
+                const int x = mirrorX ? (info.size.w - 1 - region.max.x) : region.min.x;
+                std::vector<uint8_t> scanline(region.w() * pixelByteCount);
+                for (uint16_t y = 0; y < outInfo.size.h; ++y)
+                {
+                    // Convert the display coordinates to the file scanline.
+                    const int inY = region.min.y + y * scale;
+                    const size_t fileY = mirrorY ? (info.size.h - 1 - inY) : inY;
+                    uint8_t* outP = out->getData(mirrorY ? (outInfo.size.h - 1 - y) : y);
+                    io.setPos(pos + fileY * scanlineByteCount + x * pixelByteCount);
+                    if (1 == scale)
+                    {
+                        io.read(outP, region.w() * pixelByteCount);
                     }
                     else
                     {
-                        ++i;
+                        // Keep every Nth pixel, starting from the left edge
+                        // of the region in display coordinates.
+                        io.read(scanline.data(), scanline.size());
+                        for (uint16_t i = 0; i < outInfo.size.w; ++i)
+                        {
+                            const size_t inX = mirrorX ? (region.w() - 1 - i * scale) : (i * scale);
+                            const size_t outX = mirrorX ? (outInfo.size.w - 1 - i) : i;
+                            memcpy(
+                                outP + outX * pixelByteCount,
+                                scanline.data() + inX * pixelByteCount,
+                                pixelByteCount);
+                        }
                     }
                 }
+                return out;
+            }
+
+            bool ISequenceRead::_openReadAhead(const std::string& fileName, FileSystem::FileIO& io)
+            {
+                DJV_PRIVATE_PTR();
+                std::future<FileSystem::AsyncReadResult> future;
+                {
+                    std::lock_guard<std::mutex> lock(p.readAheadMutex);
+                    for (auto i = p.readAhead.begin(); i != p.readAhead.end(); ++i)
+                    {
+                        if (fileName == i->second.fileName)
+                        {
+                            future = std::move(i->second.future);
+                            p.readAhead.erase(i);
+                            break;
+                        }
+                    }
+                }
+                bool out = false;
+                if (future.valid())
+                {
+                    try
+                    {
+                        const auto result = future.get();
+                        io.open(fileName, result.buffer, result.size);
+                        out = true;
+                    }
+                    catch (const std::exception&)
+                    {
+                        // Fall back to reading the file directly.
+                    }
+                }
+                return out;
             }
 
             struct ISequenceWrite::Private
@@ -602,98 +1202,113 @@ namespace djv
                         p.convert = Image::Convert::create(_resourceSystem);
 
                         const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                        struct Future
+                        {
+                            std::string fileName;
+                            bool error = false;
+                            std::string errorString;
+                            std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+                        };
+                        std::deque<std::future<Future> > futures;
                         while (p.running)
                         {
-                            std::vector<std::shared_ptr<Image::Image> > images;
+                            // Start writing frames while the number of frames in
+                            // flight is below the thread count. The frames are
+                            // written independently of each other, so a slow frame
+                            // does not hold up the frames after it.
+                            bool active = false;
+                            const bool finished = _videoQueue.isFinished();
+                            while (!_videoQueue.isEmpty() && futures.size() < _threadCount)
                             {
-                                std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
-                                if (lock.owns_lock())
+                                auto image = _videoQueue.popFrame().image;
+                                const auto fileName = p.fileInfo.getFileName(p.frameNumber);
+                                if (p.frameNumber != Frame::invalid)
                                 {
-                                    while (!_videoQueue.isEmpty() && images.size() < _threadCount)
-                                    {
-                                        auto frame = _videoQueue.popFrame();
-                                        images.push_back(frame.image);
-                                    }
-                                    if (_videoQueue.isEmpty() && _videoQueue.isFinished())
-                                    {
-                                        p.running = false;
-                                    }
+                                    ++p.frameNumber;
                                 }
-                            }
-                            if (images.size())
-                            {
-                                struct Future
+                                const Image::Type imageType = _getImageType(image->getType());
+                                if (Image::Type::None == imageType)
                                 {
-                                    std::string fileName;
-                                    bool error = false;
-                                    std::string errorString;
-                                };
-                                std::vector<std::future<Future> > futures;
-                                for (size_t i = 0; i < images.size(); ++i)
+                                    std::stringstream ss;
+                                    ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be written") << ".";
+                                    throw FileSystem::Error(ss.str());
+                                }
+                                const Image::Layout imageLayout = _getImageLayout();
+                                if (imageType != image->getType() ||
+                                    (imageLayout != image->getLayout() && !_hasImageLayoutConversion()))
                                 {
-                                    const auto fileName = p.fileInfo.getFileName(p.frameNumber);
-                                    /*{
-                                        std::stringstream ss;
-                                        ss << "Writing: " << fileName;
-                                        _logSystem->log("djv::AV::IO::ISequenceWrite", ss.str());
-                                    }*/
-                                    if (p.frameNumber != Frame::invalid)
-                                    {
-                                        ++p.frameNumber;
-                                    }
-                                    auto image = images[i];
-                                    const Image::Type imageType = _getImageType(image->getType());
-                                    if (Image::Type::None == imageType)
-                                    {
-                                        std::stringstream ss;
-                                        ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be written") << ".";
-                                        throw FileSystem::Error(ss.str());
-                                    }
-                                    const Image::Layout imageLayout = _getImageLayout();
-                                    if (imageType != image->getType() || imageLayout != image->getLayout())
+                                    const Image::Info info(image->getSize(), imageType, imageLayout);
+                                    auto tmp = Image::Image::create(info);
+                                    tmp->setTags(image->getTags());
+                                    p.convert->process(*image, info, *tmp);
+                                    image = tmp;
+                                }
+                                futures.push_back(std::async(
+                                    std::launch::async,
+                                    [this, fileName, image]
                                     {
-                                        const Image::Info info(image->getSize(), imageType, imageLayout);
-                                        auto tmp = Image::Image::create(info);
-                                        tmp->setTags(image->getTags());
-                                        p.convert->process(*image, info, *tmp);
-                                        image = tmp;
-                                    }
-                                    futures.push_back(std::async(
-                                        std::launch::async,
-                                        [this, fileName, image]
+                                        Future out;
+                                        out.fileName = fileName;
+                                        const auto start = std::chrono::steady_clock::now();
+                                        try
                                         {
-                                            Future out;
-                                            out.fileName = fileName;
-                                            try
-                                            {
-                                                _write(fileName, image);
-                                            }
-                                            catch (const std::exception& e)
-                                            {
-                                                out.error = true;
-                                                out.errorString = e.what();
-                                            }
-                                            return out;
-                                        }));
+                                            _write(fileName, image);
+                                        }
+                                        catch (const std::exception& e)
+                                        {
+                                            out.error = true;
+                                            out.errorString = e.what();
+                                        }
+                                        out.time = std::chrono::steady_clock::now() - start;
+                                        return out;
+                                    }));
+                                active = true;
+                            }
+                            const bool done = finished && _videoQueue.isEmpty();
+
+                            // Collect the frames that have been written in whatever
+                            // order they finish, or all of them when there are no
+                            // more frames to write.
+                            auto future = futures.begin();
+                            while (future != futures.end())
+                            {
+                                if (!done && future->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                                {
+                                    ++future;
+                                    continue;
                                 }
-                                for (auto& future : futures)
+                                const auto result = future->get();
+                                future = futures.erase(future);
+                                active = true;
+                                if (result.error)
                                 {
-                                    const auto result = future.get();
-                                    if (result.error)
-                                    {
-                                        std::stringstream ss;
-                                        ss << DJV_TEXT("The file") << " '" << result.fileName << "' " <<
-                                            DJV_TEXT("cannot be written") << ". " << result.errorString;
-                                        _logSystem->log("djv::AV::ISequenceWrite", ss.str(), LogLevel::Error);
-                                        p.running = false;
-                                    }
+                                    std::stringstream ss;
+                                    ss << DJV_TEXT("The file") << " '" << result.fileName << "' " <<
+                                        DJV_TEXT("cannot be written") << ". " << result.errorString;
+                                    _logSystem->log("djv::AV::ISequenceWrite", ss.str(), LogLevel::Error);
+                                    p.running = false;
+                                }
+                                else
+                                {
+                                    std::stringstream ss;
+                                    ss << "Wrote: " << result.fileName << " (" <<
+                                        std::chrono::duration_cast<std::chrono::milliseconds>(result.time).count() << "ms)";
+                                    _logSystem->log("djv::AV::ISequenceWrite", ss.str());
                                 }
                             }
-                            else
+                            if (done)
+                            {
+                                p.running = false;
+                            }
+                            else if (!active)
                             {
                                 std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
                             }
                         }
+                        for (auto& future : futures)
+                        {
+                            future.wait();
+                        }
 
                         p.convert.reset();
                     }
@@ -728,6 +1343,11 @@ namespace djv
                 return Image::Layout();
             }
 
+            bool ISequenceWrite::_hasImageLayoutConversion() const
+            {
+                return false;
+            }
+
             void ISequenceWrite::_finish()
             {
                 DJV_PRIVATE_PTR();
@@ -30,16 +30,61 @@
 #pragma once
 
 #include <djvAV/IO.h>
+#include <djvAV/IOThreadPool.h>
 
 #include <djvCore/Frame.h>
 
 namespace djv
 {
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            class FileIO;
+
+        } // namespace FileSystem
+    } // namespace Core
+
     namespace AV
     {
         namespace IO
         {
             //! This class provides an interface for reading sequences.
+            //!
+            //! Frames are decoded by jobs submitted to the shared thread pool,
+            //! the thread count limits how many jobs a reader has in flight.
+            //! Jobs are prioritized so the frame to be displayed is decoded
+            //! before the queue and cache are filled, and seeking cancels any
+            //! jobs that have not started yet.
+            //!
+            //! When ReadOptions::readAhead is set, the files for the next
+            //! frames are read into memory asynchronously before they are
+            //! decoded. Plugins use _openReadAhead() to open the files from
+            //! memory.
+            //!
+            //! When ReadOptions::prefetch is set, the files for frames that are
+            //! further ahead are prefetched into the operating system cache by
+            //! a separate thread, so they open quickly without using memory
+            //! for decoded images.
+            //!
+            //! When ReadOptions::cacheCompression is set, the jobs compress the
+            //! frames that are added to the cache, and frames that are read
+            //! from the cache are decompressed by jobs.
+            //!
+            //! Plugins can use header templates to avoid parsing the full header
+            //! of every file in a sequence. The plugin builds a key from the
+            //! header fields that determine how the image data is read, like the
+            //! data offset, size, packing, and endian. Files whose keys match a
+            //! template use the information from the template, and only the
+            //! other files need a full parse. Files that do not have the same
+            //! image information as the first file in the sequence are logged as
+            //! warnings.
+            //!
+            //! When ReadOptions::roi or ReadOptions::proxy are set, the
+            //! reported image sizes are reduced to match. Plugins that return
+            //! true from _hasProxy() read the reduced images directly, for the
+            //! other plugins the images are decimated by the jobs after they
+            //! are read.
             class ISequenceRead : public IRead
             {
                 DJV_NON_COPYABLE(ISequenceRead);
@@ -48,6 +93,8 @@ namespace djv
                 void _init(
                     const Core::FileSystem::FileInfo&,
                     const ReadOptions&,
+                    const std::shared_ptr<ThreadPool>&,
+                    const std::shared_ptr<CacheManager>&,
                     const std::shared_ptr<Core::ResourceSystem>&,
                     const std::shared_ptr<Core::LogSystem>&);
                 ISequenceRead();
@@ -65,6 +112,38 @@ namespace djv
                 virtual std::shared_ptr<Image::Image> _readImage(const std::string & fileName) = 0;
                 void _finish();
 
+                //! Get whether the plugin opens files with _openReadAhead().
+                virtual bool _hasReadAhead() const;
+
+                //! Open a file that has been read ahead. This waits for the
+                //! read to finish if it is still in progress. Returns false if
+                //! the file has not been read ahead, or the read failed.
+                bool _openReadAhead(const std::string & fileName, Core::FileSystem::FileIO &);
+
+                //! Get the header template for a key. Returns false if there is
+                //! no template for the key.
+                bool _getHeaderTemplate(const std::vector<uint8_t>& key, Info&) const;
+
+                //! Add a header template, after the header of a file has been
+                //! parsed.
+                void _addHeaderTemplate(const std::vector<uint8_t>& key, const Info&);
+
+                //! Get whether the plugin applies ReadOptions::roi and
+                //! ReadOptions::proxy itself in _readImage().
+                virtual bool _hasProxy() const;
+
+                //! Read uncompressed scanlines starting at the current file
+                //! position, applying ReadOptions::roi and ReadOptions::proxy.
+                //! Only the scanlines that are needed are read, and the data is
+                //! not converted.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                static std::shared_ptr<Image::Image> _readScanlines(
+                    Core::FileSystem::FileIO&,
+                    const Image::Info&,
+                    const ReadOptions&);
+
                 Core::Time::Speed _speed;
                 Core::Frame::Sequence _sequence;
 
@@ -72,9 +151,14 @@ namespace djv
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName);
-                size_t _readQueue(size_t count, bool cacheEnabled);
-                void _readCache(size_t count, const AV::IO::InOutPoints&);
+                std::future<Future> _getFuture(Core::Frame::Number, const std::string& fileName, JobPriority, bool compress);
+                std::future<Future> _getFuture(Core::Frame::Number, const std::shared_ptr<Image::CompressedData>&, JobPriority);
+                void _cancelRequests();
+                void _readQueue(size_t count, bool cacheEnabled);
+                void _readCache(size_t count, size_t dataByteCount);
+                void _readAhead(bool cacheEnabled);
+                size_t _getPrefetchCount(size_t threadCount, bool playback, const Core::Time::Speed&) const;
+                void _prefetch(size_t count, bool cacheEnabled);
 
                 DJV_PRIVATE();
             };
@@ -101,6 +185,12 @@ namespace djv
             protected:
                 virtual Image::Type _getImageType(Image::Type) const;
                 virtual Image::Layout _getImageLayout() const;
+
+                //! Get whether the writer handles any image layout itself in
+                //! _write(), so that images are only converted when the type
+                //! changes.
+                virtual bool _hasImageLayoutConversion() const;
+
                 virtual void _write(const std::string & fileName, const std::shared_ptr<Image::Image> &) = 0;
                 void _finish();
 
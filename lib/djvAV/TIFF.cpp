@@ -110,7 +110,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _cacheManager, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
@@ -130,6 +130,9 @@ namespace djv
             ss << value.compression;
             out.get<picojson::object>()["Compression"] = picojson::value(ss.str());
         }
+        out.get<picojson::object>()["ThreadCount"] = toJSON(value.threadCount);
+        out.get<picojson::object>()["RowsPerStrip"] = toJSON(value.rowsPerStrip);
+        out.get<picojson::object>()["Predictor"] = toJSON(value.predictor);
         return out;
     }
 
@@ -144,6 +147,18 @@ namespace djv
                     std::stringstream ss(i.second.get<std::string>());
                     ss >> out.compression;
                 }
+                else if ("ThreadCount" == i.first)
+                {
+                    fromJSON(i.second, out.threadCount);
+                }
+                else if ("RowsPerStrip" == i.first)
+                {
+                    fromJSON(i.second, out.rowsPerStrip);
+                }
+                else if ("Predictor" == i.first)
+                {
+                    fromJSON(i.second, out.predictor);
+                }
             }
         }
         else
@@ -157,7 +172,8 @@ namespace djv
         Compression,
         DJV_TEXT("None"),
         DJV_TEXT("RLE"),
-        DJV_TEXT("LZW"));
+        DJV_TEXT("LZW"),
+        DJV_TEXT("ZIP"));
 
 } // namespace djv
 
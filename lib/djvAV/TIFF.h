@@ -54,9 +54,10 @@ namespace djv
                     None,
                     RLE,
                     LZW,
+                    ZIP,
 
                     Count,
-                    First
+                    First = None
                 };
                 DJV_ENUM_HELPERS(Compression);
 
@@ -64,6 +65,19 @@ namespace djv
                 struct Options
                 {
                     Compression compression = Compression::LZW;
+
+                    //! The number of threads used to decompress or compress the
+                    //! strips or tiles of a single image. The threads are shared
+                    //! with the other readers and writers, see parallelChunks().
+                    //! The frames of a sequence are already read and written in
+                    //! parallel, so this defaults to one.
+                    size_t      threadCount = 1;
+
+                    //! The number of scanlines in each strip that is written.
+                    size_t      rowsPerStrip = 64;
+
+                    //! Use a differencing predictor with LZW and ZIP compression.
+                    bool        predictor = true;
                 };
 
                 //! Load a TIFF file palette.
@@ -75,6 +89,16 @@ namespace djv
                     uint16_t * green,
                     uint16_t * blue);
 
+                //! Write the image data of a TIFF file after the fields have been
+                //! set. The strips are compressed in batches with the compression
+                //! and predictor of the file, using up to the given number of
+                //! threads (see parallelChunks()), and then written in order with
+                //! TIFFWriteRawStrip().
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                void writeStrips(::TIFF*, const Image::Image&, size_t threadCount);
+
                 //! This class provides the TIFF file reader.
                 class Read : public ISequenceRead
                 {
@@ -89,16 +113,22 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const Options&,
+                        const std::shared_ptr<ThreadPool>&,
+                        const std::shared_ptr<CacheManager>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    bool _hasProxy() const override;
 
                 private:
                     struct File;
                     Info _open(const std::string &, File &);
+
+                    DJV_PRIVATE();
                 };
                 
                 //! This class provides the TIFF file writer.
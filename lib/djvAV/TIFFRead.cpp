@@ -29,9 +29,13 @@
 
 #include <djvAV/TIFF.h>
 
+#include <djvAV/ImageUtil.h>
+
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 
+#include <algorithm>
+
 using namespace djv::Core;
 
 namespace djv
@@ -57,9 +61,105 @@ namespace djv
                     bool     compression = false;
                     bool     palette     = false;
                     uint16 * colormap[3] = { nullptr, nullptr, nullptr };
+                    bool     separate    = false;
+                    bool     tiled       = false;
+                    uint32   rowsPerStrip = 0;
+                    uint32   tileWidth   = 0;
+                    uint32   tileLength  = 0;
+                    size_t   pixelByteCount = 0;
                 };
 
-                Read::Read()
+                namespace
+                {
+                    ::TIFF* tiffOpen(const std::string& fileName)
+                    {
+                        return TIFFOpen(fileName.data(), "r");
+                    }
+
+                    //! Read a range of strips into an image whose first scanline
+                    //! is the first scanline of the region.
+                    void readStrips(
+                        ::TIFF*       tiff,
+                        uint32        rowsPerStrip,
+                        uint32        height,
+                        const BBox2i& region,
+                        uint32        minStrip,
+                        uint32        maxStrip,
+                        uint8_t*      data,
+                        size_t        scanlineByteCount)
+                    {
+                        const tmsize_t rowByteCount = TIFFScanlineSize(tiff);
+                        std::vector<uint8_t> buf(TIFFStripSize(tiff));
+                        for (uint32 strip = minStrip; strip <= maxStrip; ++strip)
+                        {
+                            if (TIFFReadEncodedStrip(tiff, strip, buf.data(), -1) == -1)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("Error reading strip."));
+                            }
+                            const int y0 = static_cast<int>(strip * rowsPerStrip);
+                            const int y1 = static_cast<int>(std::min((strip + 1) * rowsPerStrip, height)) - 1;
+                            for (int y = std::max(y0, region.min.y); y <= std::min(y1, region.max.y); ++y)
+                            {
+                                memcpy(
+                                    data + (y - region.min.y) * scanlineByteCount,
+                                    buf.data() + (y - y0) * rowByteCount,
+                                    rowByteCount);
+                            }
+                        }
+                    }
+
+                    //! Read the tiles in a range of tile rows that intersect the
+                    //! region into an image whose first scanline is the first
+                    //! scanline of the region.
+                    void readTiles(
+                        ::TIFF*       tiff,
+                        uint32        tileWidth,
+                        uint32        tileLength,
+                        size_t        pixelByteCount,
+                        const BBox2i& region,
+                        uint32        minTileRow,
+                        uint32        maxTileRow,
+                        uint8_t*      data,
+                        size_t        scanlineByteCount)
+                    {
+                        const tmsize_t rowByteCount = TIFFTileRowSize(tiff);
+                        std::vector<uint8_t> buf(TIFFTileSize(tiff));
+                        const uint32 minTileColumn = region.min.x / tileWidth;
+                        const uint32 maxTileColumn = region.max.x / tileWidth;
+                        for (uint32 tileRow = minTileRow; tileRow <= maxTileRow; ++tileRow)
+                        {
+                            for (uint32 tileColumn = minTileColumn; tileColumn <= maxTileColumn; ++tileColumn)
+                            {
+                                const int x0 = static_cast<int>(tileColumn * tileWidth);
+                                const int y0 = static_cast<int>(tileRow * tileLength);
+                                if (TIFFReadTile(tiff, buf.data(), x0, y0, 0, 0) == -1)
+                                {
+                                    throw FileSystem::Error(DJV_TEXT("Error reading tile."));
+                                }
+                                const int minX = std::max(x0, region.min.x);
+                                const int maxX = std::min(x0 + static_cast<int>(tileWidth) - 1, region.max.x);
+                                const int minY = std::max(y0, region.min.y);
+                                const int maxY = std::min(y0 + static_cast<int>(tileLength) - 1, region.max.y);
+                                for (int y = minY; y <= maxY; ++y)
+                                {
+                                    memcpy(
+                                        data + (y - region.min.y) * scanlineByteCount + minX * pixelByteCount,
+                                        buf.data() + (y - y0) * rowByteCount + (minX - x0) * pixelByteCount,
+                                        (maxX - minX + 1) * pixelByteCount);
+                                }
+                            }
+                        }
+                    }
+
+                } // namespace
+
+                struct Read::Private
+                {
+                    Options options;
+                };
+
+                Read::Read() :
+                    _p(new Private)
                 {}
 
                 Read::~Read()
@@ -70,11 +170,15 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_p->options = options;
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -86,36 +190,128 @@ namespace djv
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
-                    std::shared_ptr<Image::Image> out;
+                    DJV_PRIVATE_PTR();
                     File f;
                     const auto info = _open(fileName, f);
-                    out = Image::Image::create(info.video[0].info);
+                    const Image::Info& fileInfo = info.video[0].info;
+
+                    // Only the strips or tiles that intersect the region of interest
+                    // are read, the proxy scale is applied afterwards. The region is
+                    // mapped to the file's orientation.
+                    const BBox2i region = getReadRegion(fileInfo.size, _options);
+                    const bool fullRead = isFullRead(fileInfo.size, _options);
+                    const int w = fileInfo.size.w;
+                    const int h = fileInfo.size.h;
+                    const BBox2i fileRegion(
+                        fileInfo.layout.mirror.x ? (w - 1 - region.max.x) : region.min.x,
+                        fileInfo.layout.mirror.y ? (h - 1 - region.max.y) : region.min.y,
+                        region.w(),
+                        region.h());
+                    auto imageInfo = fileInfo;
+                    imageInfo.size.h = static_cast<uint16_t>(region.h());
+                    auto out = Image::Image::create(imageInfo);
                     out->setPluginName(pluginName);
-                    for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
+                    uint8_t* data = out->getData();
+                    const size_t scanlineByteCount = imageInfo.getScanlineByteCount();
+
+                    if (f.separate)
+                    {
+                        for (int y = fileRegion.min.y; y <= fileRegion.max.y; ++y)
+                        {
+                            if (TIFFReadScanline(f.f, (tdata_t *)(data + (y - fileRegion.min.y) * scanlineByteCount), y) == -1)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("Error reading scanline."));
+                            }
+                        }
+                    }
+                    else
                     {
-                        if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
+                        // Compressed strips or tiles are decoded in parallel, with
+                        // each thread using its own file handle.
+                        uint32 minChunk = 0;
+                        uint32 maxChunk = 0;
+                        if (f.tiled)
+                        {
+                            minChunk = fileRegion.min.y / f.tileLength;
+                            maxChunk = fileRegion.max.y / f.tileLength;
+                        }
+                        else
                         {
-                            throw FileSystem::Error(DJV_TEXT("Error reading scanline."));
+                            minChunk = fileRegion.min.y / f.rowsPerStrip;
+                            maxChunk = fileRegion.max.y / f.rowsPerStrip;
                         }
-                        if (f.palette)
+                        const size_t chunkCount = maxChunk - minChunk + 1;
+                        const size_t threadCount = f.compression ? p.options.threadCount : 1;
+                        auto read = [&f, h, fileRegion, data, scanlineByteCount](::TIFF* tiff, uint32 min, uint32 max)
+                        {
+                            if (f.tiled)
+                            {
+                                readTiles(tiff, f.tileWidth, f.tileLength, f.pixelByteCount, fileRegion, min, max, data, scanlineByteCount);
+                            }
+                            else
+                            {
+                                readStrips(tiff, f.rowsPerStrip, h, fileRegion, min, max, data, scanlineByteCount);
+                            }
+                        };
+
+                        // The first chunk uses the file that is already open. The
+                        // other chunks open their own handles, which are closed when
+                        // the chunk finishes, and parallelChunks() waits for all of
+                        // the chunks before re-throwing an error.
+                        parallelChunks(
+                            chunkCount,
+                            threadCount,
+                            [&f, &fileName, &read, minChunk](size_t begin, size_t end)
+                            {
+                                const uint32 min = minChunk + static_cast<uint32>(begin);
+                                const uint32 max = minChunk + static_cast<uint32>(end) - 1;
+                                if (0 == begin)
+                                {
+                                    read(f.f, min, max);
+                                }
+                                else
+                                {
+                                    File handle;
+                                    handle.f = tiffOpen(fileName);
+                                    if (!handle.f)
+                                    {
+                                        throw FileSystem::Error(DJV_TEXT("Cannot open file."));
+                                    }
+                                    read(handle.f, min, max);
+                                }
+                            });
+                    }
+
+                    if (f.palette)
+                    {
+                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
                         {
                             TIFF::paletteLoad(
                                 out->getData(y),
-                                info.video[0].info.size.w,
-                                static_cast<int>(Image::getChannelCount(info.video[0].info.type)),
+                                imageInfo.size.w,
+                                static_cast<int>(Image::getChannelCount(imageInfo.type)),
                                 f.colormap[0], f.colormap[1], f.colormap[2]);
                         }
                     }
+
+                    if (!fullRead)
+                    {
+                        out = Image::decimate(
+                            out,
+                            BBox2i(region.min.x, 0, region.w(), region.h()),
+                            getProxyScale(_options.proxy));
+                    }
                     return out;
                 }
 
+                bool Read::_hasProxy() const
+                {
+                    return true;
+                }
+
                 Info Read::_open(const std::string & fileName, File & f)
                 {
-#if defined(DJV_PLATFORM_WINDOWS)
-                    f.f = TIFFOpen(fileName.data(), "r");
-#else
-                    f.f = TIFFOpen(fileName.data(), "r");
-#endif // DJV_WINDOWS
+                    f.f = tiffOpen(fileName);
                     if (!f.f)
                     {
                         throw FileSystem::Error(DJV_TEXT("Cannot open file."));
@@ -181,6 +377,23 @@ namespace djv
 
                     f.compression = compression != COMPRESSION_NONE;
                     f.palette = PHOTOMETRIC_PALETTE == photometric;
+                    f.separate = PLANARCONFIG_SEPARATE == channels;
+                    f.tiled = TIFFIsTiled(f.f) != 0;
+                    if (f.tiled)
+                    {
+                        TIFFGetField(f.f, TIFFTAG_TILEWIDTH, &f.tileWidth);
+                        TIFFGetField(f.f, TIFFTAG_TILELENGTH, &f.tileLength);
+                        if (!f.tileWidth || !f.tileLength)
+                        {
+                            throw FileSystem::Error(DJV_TEXT("Unsupported tile size."));
+                        }
+                    }
+                    else
+                    {
+                        TIFFGetFieldDefaulted(f.f, TIFFTAG_ROWSPERSTRIP, &f.rowsPerStrip);
+                        f.rowsPerStrip = std::max(std::min(f.rowsPerStrip, height), static_cast<uint32>(1));
+                    }
+                    f.pixelByteCount = samples * sampleDepth / 8;
 
                     AV::Tags tags;
                     char * tag = 0;
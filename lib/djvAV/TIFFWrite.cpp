@@ -31,6 +31,9 @@
 
 #include <djvCore/FileSystem.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace djv::Core;
 
 namespace djv
@@ -84,6 +87,221 @@ namespace djv
 
                         ::TIFF * f = nullptr;
                     };
+
+                    //! This struct provides the fields shared by the output file
+                    //! and the in-memory files used to compress the strips.
+                    struct Fields
+                    {
+                        uint32 width            = 0;
+                        uint16 photometric      = 0;
+                        uint16 samples          = 0;
+                        uint16 sampleDepth      = 0;
+                        uint16 sampleFormat     = 0;
+                        uint16 extraSamplesSize = 0;
+                        uint16 compression      = COMPRESSION_NONE;
+                        uint16 predictor        = PREDICTOR_NONE;
+                    };
+
+                    void setFields(::TIFF * f, const Fields & fields, uint32 height, uint32 rowsPerStrip)
+                    {
+                        uint16 extraSamples[] = { EXTRASAMPLE_ASSOCALPHA };
+                        TIFFSetField(f, TIFFTAG_IMAGEWIDTH, fields.width);
+                        TIFFSetField(f, TIFFTAG_IMAGELENGTH, height);
+                        TIFFSetField(f, TIFFTAG_PHOTOMETRIC, fields.photometric);
+                        TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, fields.samples);
+                        TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, fields.sampleDepth);
+                        TIFFSetField(f, TIFFTAG_SAMPLEFORMAT, fields.sampleFormat);
+                        TIFFSetField(f, TIFFTAG_EXTRASAMPLES, fields.extraSamplesSize, extraSamples);
+                        TIFFSetField(f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+                        TIFFSetField(f, TIFFTAG_COMPRESSION, fields.compression);
+                        if (fields.predictor != PREDICTOR_NONE)
+                        {
+                            TIFFSetField(f, TIFFTAG_PREDICTOR, fields.predictor);
+                        }
+                        TIFFSetField(f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                        TIFFSetField(f, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+                    }
+
+                    //! Get the fields of a file.
+                    Fields getFields(::TIFF * f)
+                    {
+                        Fields out;
+                        uint16 * extraSamples = nullptr;
+                        TIFFGetField(f, TIFFTAG_IMAGEWIDTH, &out.width);
+                        TIFFGetField(f, TIFFTAG_PHOTOMETRIC, &out.photometric);
+                        TIFFGetFieldDefaulted(f, TIFFTAG_SAMPLESPERPIXEL, &out.samples);
+                        TIFFGetFieldDefaulted(f, TIFFTAG_BITSPERSAMPLE, &out.sampleDepth);
+                        TIFFGetFieldDefaulted(f, TIFFTAG_SAMPLEFORMAT, &out.sampleFormat);
+                        TIFFGetFieldDefaulted(f, TIFFTAG_EXTRASAMPLES, &out.extraSamplesSize, &extraSamples);
+                        TIFFGetFieldDefaulted(f, TIFFTAG_COMPRESSION, &out.compression);
+                        if (COMPRESSION_LZW == out.compression || COMPRESSION_ADOBE_DEFLATE == out.compression)
+                        {
+                            TIFFGetField(f, TIFFTAG_PREDICTOR, &out.predictor);
+                        }
+                        return out;
+                    }
+
+                    //! This struct provides an in-memory file for libtiff.
+                    struct MemoryFile
+                    {
+                        std::vector<uint8_t> data;
+                        size_t               pos = 0;
+                    };
+
+                    tsize_t memoryRead(thandle_t handle, tdata_t buf, tsize_t size)
+                    {
+                        auto file = reinterpret_cast<MemoryFile *>(handle);
+                        const size_t byteCount = std::min(
+                            static_cast<size_t>(size),
+                            file->pos < file->data.size() ? file->data.size() - file->pos : 0);
+                        if (byteCount)
+                        {
+                            memcpy(buf, file->data.data() + file->pos, byteCount);
+                            file->pos += byteCount;
+                        }
+                        return static_cast<tsize_t>(byteCount);
+                    }
+
+                    tsize_t memoryWrite(thandle_t handle, tdata_t buf, tsize_t size)
+                    {
+                        auto file = reinterpret_cast<MemoryFile *>(handle);
+                        const size_t end = file->pos + static_cast<size_t>(size);
+                        if (end > file->data.size())
+                        {
+                            file->data.resize(end);
+                        }
+                        memcpy(file->data.data() + file->pos, buf, size);
+                        file->pos = end;
+                        return size;
+                    }
+
+                    toff_t memorySeek(thandle_t handle, toff_t offset, int whence)
+                    {
+                        auto file = reinterpret_cast<MemoryFile *>(handle);
+                        switch (whence)
+                        {
+                        case SEEK_SET: file->pos = static_cast<size_t>(offset); break;
+                        case SEEK_CUR: file->pos += static_cast<size_t>(offset); break;
+                        case SEEK_END: file->pos = file->data.size() + static_cast<size_t>(offset); break;
+                        default: break;
+                        }
+                        return static_cast<toff_t>(file->pos);
+                    }
+
+                    int memoryClose(thandle_t)
+                    {
+                        return 0;
+                    }
+
+                    toff_t memorySize(thandle_t handle)
+                    {
+                        return static_cast<toff_t>(reinterpret_cast<MemoryFile *>(handle)->data.size());
+                    }
+
+                    int memoryMap(thandle_t, tdata_t *, toff_t *)
+                    {
+                        return 0;
+                    }
+
+                    void memoryUnmap(thandle_t, tdata_t, toff_t)
+                    {}
+
+                    //! Compress a strip by encoding it as the only strip of an
+                    //! in-memory file and returning the raw strip data. This lets
+                    //! the strips be compressed concurrently with the libtiff
+                    //! codecs and then written in order with TIFFWriteRawStrip().
+                    std::vector<uint8_t> compressStrip(const Fields & fields, std::vector<uint8_t> && data, uint32 rows)
+                    {
+                        if (COMPRESSION_NONE == fields.compression)
+                        {
+                            return std::move(data);
+                        }
+                        MemoryFile memoryFile;
+                        File f;
+                        f.f = TIFFClientOpen(
+                            "",
+                            "w",
+                            reinterpret_cast<thandle_t>(&memoryFile),
+                            memoryRead,
+                            memoryWrite,
+                            memorySeek,
+                            memoryClose,
+                            memorySize,
+                            memoryMap,
+                            memoryUnmap);
+                        if (!f.f)
+                        {
+                            throw FileSystem::Error(DJV_TEXT("Error writing strip."));
+                        }
+                        setFields(f.f, fields, rows, rows);
+                        if (TIFFWriteEncodedStrip(f.f, 0, data.data(), static_cast<tmsize_t>(data.size())) == -1)
+                        {
+                            throw FileSystem::Error(DJV_TEXT("Error writing strip."));
+                        }
+                        uint64 * offsets = nullptr;
+                        uint64 * byteCounts = nullptr;
+                        if (!TIFFGetField(f.f, TIFFTAG_STRIPOFFSETS, &offsets) ||
+                            !TIFFGetField(f.f, TIFFTAG_STRIPBYTECOUNTS, &byteCounts) ||
+                            offsets[0] + byteCounts[0] > memoryFile.data.size())
+                        {
+                            throw FileSystem::Error(DJV_TEXT("Error writing strip."));
+                        }
+                        const auto begin = memoryFile.data.begin() + static_cast<size_t>(offsets[0]);
+                        return std::vector<uint8_t>(begin, begin + static_cast<size_t>(byteCounts[0]));
+                    }
+
+                } // namespace
+
+                void writeStrips(::TIFF * f, const Image::Image & image, size_t threadCount)
+                {
+                    const Fields fields = getFields(f);
+                    uint32 height = 0;
+                    uint32 rowsPerStrip = 0;
+                    TIFFGetField(f, TIFFTAG_IMAGELENGTH, &height);
+                    TIFFGetFieldDefaulted(f, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+                    rowsPerStrip = std::max(std::min(rowsPerStrip, height), uint32(1));
+
+                    // Compress the strips in batches and write them in order. Each
+                    // batch is split into "threadCount" chunks of strips, which run
+                    // on the worker threads that are shared with the other readers
+                    // and writers.
+                    const uint32 stripCount = (height + rowsPerStrip - 1) / rowsPerStrip;
+                    const auto& info = image.getInfo();
+                    const size_t scanlineByteCount = static_cast<size_t>(info.size.w) * Image::getByteCount(info.type);
+                    const size_t chunkCount = COMPRESSION_NONE == fields.compression ?
+                        1 :
+                        std::max(threadCount, size_t(1));
+                    const uint32 batchSize = static_cast<uint32>(chunkCount * 4);
+                    std::vector<std::vector<uint8_t> > strips;
+                    for (uint32 batch = 0; batch < stripCount; batch += batchSize)
+                    {
+                        const uint32 count = std::min(batchSize, stripCount - batch);
+                        strips.resize(count);
+                        parallelChunks(
+                            count,
+                            chunkCount,
+                            [&strips, &fields, &image, batch, rowsPerStrip, height, scanlineByteCount](size_t begin, size_t end)
+                            {
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    const uint32 y0 = (batch + static_cast<uint32>(i)) * rowsPerStrip;
+                                    const uint32 rows = std::min(rowsPerStrip, height - y0);
+                                    std::vector<uint8_t> data(rows * scanlineByteCount);
+                                    for (uint32 y = 0; y < rows; ++y)
+                                    {
+                                        memcpy(data.data() + y * scanlineByteCount, image.getData(y0 + y), scanlineByteCount);
+                                    }
+                                    strips[i] = compressStrip(fields, std::move(data), rows);
+                                }
+                            });
+                        for (uint32 i = 0; i < count; ++i)
+                        {
+                            if (TIFFWriteRawStrip(f, batch + i, strips[i].data(), static_cast<tmsize_t>(strips[i].size())) == -1)
+                            {
+                                throw FileSystem::Error(DJV_TEXT("Error writing strip."));
+                            }
+                        }
+                    }
                 }
 
                 Image::Type Write::_getImageType(Image::Type value) const
@@ -138,78 +356,76 @@ namespace djv
                     }
 
                     const auto& info = image->getInfo();
-                    uint16 photometric      = 0;
-                    uint16 samples          = 0;
-                    uint16 sampleDepth      = 0;
-                    uint16 sampleFormat     = 0;
-                    uint16 extraSamples[]   = { EXTRASAMPLE_ASSOCALPHA };
-                    uint16 extraSamplesSize = 0;
-                    uint16 compression      = 0;
+                    Fields fields;
+                    fields.width = info.size.w;
                     switch (Image::getChannelCount(info.type))
                     {
                     case 1:
-                        photometric = PHOTOMETRIC_MINISBLACK;
-                        samples = 1;
+                        fields.photometric = PHOTOMETRIC_MINISBLACK;
+                        fields.samples = 1;
                         break;
                     case 2:
-                        photometric = PHOTOMETRIC_MINISBLACK;
-                        samples = 2;
-                        extraSamplesSize = 1;
+                        fields.photometric = PHOTOMETRIC_MINISBLACK;
+                        fields.samples = 2;
+                        fields.extraSamplesSize = 1;
                         break;
                     case 3:
-                        photometric = PHOTOMETRIC_RGB;
-                        samples = 3;
+                        fields.photometric = PHOTOMETRIC_RGB;
+                        fields.samples = 3;
                         break;
                     case 4:
-                        photometric = PHOTOMETRIC_RGB;
-                        samples = 4;
-                        extraSamplesSize = 1;
+                        fields.photometric = PHOTOMETRIC_RGB;
+                        fields.samples = 4;
+                        fields.extraSamplesSize = 1;
                         break;
                     default: break;
                     }
                     switch (Image::getDataType(info.type))
                     {
                     case Image::DataType::U8:
-                        sampleDepth = 8;
-                        sampleFormat = SAMPLEFORMAT_UINT;
+                        fields.sampleDepth = 8;
+                        fields.sampleFormat = SAMPLEFORMAT_UINT;
                         break;
                     case Image::DataType::U16:
-                        sampleDepth = 16;
-                        sampleFormat = SAMPLEFORMAT_UINT;
+                        fields.sampleDepth = 16;
+                        fields.sampleFormat = SAMPLEFORMAT_UINT;
                         break;
                     case Image::DataType::U32:
-                        sampleDepth = 32;
-                        sampleFormat = SAMPLEFORMAT_UINT;
+                        fields.sampleDepth = 32;
+                        fields.sampleFormat = SAMPLEFORMAT_UINT;
                         break;
                     case Image::DataType::F32:
-                        sampleDepth = 32;
-                        sampleFormat = SAMPLEFORMAT_IEEEFP;
+                        fields.sampleDepth = 32;
+                        fields.sampleFormat = SAMPLEFORMAT_IEEEFP;
                         break;
                     default: break;
                     }
                     switch (_p->options.compression)
                     {
                     case Compression::None:
-                        compression = COMPRESSION_NONE;
+                        fields.compression = COMPRESSION_NONE;
                         break;
                     case Compression::RLE:
-                        compression = COMPRESSION_PACKBITS;
+                        fields.compression = COMPRESSION_PACKBITS;
                         break;
                     case Compression::LZW:
-                        compression = COMPRESSION_LZW;
+                        fields.compression = COMPRESSION_LZW;
+                        break;
+                    case Compression::ZIP:
+                        fields.compression = COMPRESSION_ADOBE_DEFLATE;
                         break;
                     default: break;
                     }
-                    TIFFSetField(f.f, TIFFTAG_IMAGEWIDTH, info.size.w);
-                    TIFFSetField(f.f, TIFFTAG_IMAGELENGTH, info.size.h);
-                    TIFFSetField(f.f, TIFFTAG_PHOTOMETRIC, photometric);
-                    TIFFSetField(f.f, TIFFTAG_SAMPLESPERPIXEL, samples);
-                    TIFFSetField(f.f, TIFFTAG_BITSPERSAMPLE, sampleDepth);
-                    TIFFSetField(f.f, TIFFTAG_SAMPLEFORMAT, sampleFormat);
-                    TIFFSetField(f.f, TIFFTAG_EXTRASAMPLES, extraSamplesSize, extraSamples);
-                    TIFFSetField(f.f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
-                    TIFFSetField(f.f, TIFFTAG_COMPRESSION, compression);
-                    TIFFSetField(f.f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                    if (_p->options.predictor &&
+                        (COMPRESSION_LZW == fields.compression || COMPRESSION_ADOBE_DEFLATE == fields.compression))
+                    {
+                        fields.predictor = SAMPLEFORMAT_IEEEFP == fields.sampleFormat ?
+                            PREDICTOR_FLOATINGPOINT :
+                            PREDICTOR_HORIZONTAL;
+                    }
+                    const uint32 height = info.size.h;
+                    const uint32 rowsPerStrip = std::max(std::min(static_cast<uint32>(_p->options.rowsPerStrip), height), uint32(1));
+                    setFields(f.f, fields, height, rowsPerStrip);
 
                     std::string tag = _info.tags.getTag("Creator");
                     if (!tag.empty())
@@ -232,13 +448,7 @@ namespace djv
                         TIFFSetField(f.f, TIFFTAG_IMAGEDESCRIPTION, tag.data());
                     }
 
-                    for (uint16_t y = 0; y < info.size.h; ++y)
-                    {
-                        if (TIFFWriteScanline(f.f, (tdata_t *)image->getData(y), y) == -1)
-                        {
-                            throw FileSystem::Error(DJV_TEXT("Error writing scanline."));
-                        }
-                    }
+                    writeStrips(f.f, *image, _p->options.threadCount);
                 }
 
             } // namespace TIFF
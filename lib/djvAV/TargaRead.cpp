@@ -53,11 +53,13 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<CacheManager>& cacheManager,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, cacheManager, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -329,10 +331,18 @@ namespace djv
 
                 } // namespace
 
+                bool Read::_hasReadAhead() const
+                {
+                    return true;
+                }
+
                 Info Read::_open(const std::string & fileName, FileSystem::FileIO& io)
                 {
                     io.setEndianConversion(Memory::getEndian() != Memory::Endian::LSB);
-                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    if (!_openReadAhead(fileName, io))
+                    {
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    }
                     Image::Info imageInfo;
                     Header().read(io, imageInfo, _bgr, _compression);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
@@ -592,16 +592,12 @@ namespace djv
                 std::shared_ptr<Image::Image> image;
                 bool finished = false;
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
                     auto& queue = i->read->getVideoQueue();
+                    finished = queue.isFinished();
                     if (!queue.isEmpty())
                     {
                         image = queue.getFrame().image;
                     }
-                    if (queue.isFinished())
-                    {
-                        finished = true;
-                    }
                 }
                 if (image)
                 {
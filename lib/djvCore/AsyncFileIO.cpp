@@ -0,0 +1,753 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/AsyncFileIO.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+
+#if defined(DJV_PLATFORM_WINDOWS)
+#include <malloc.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <cstdlib>
+#endif // DJV_PLATFORM_WINDOWS
+
+#if defined(DJV_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#endif // DJV_IO_URING
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            namespace
+            {
+                std::string getReadErrorMessage(const std::string& fileName)
+                {
+                    std::stringstream ss;
+                    ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be read") << ".";
+                    return ss.str();
+                }
+
+                struct Request
+                {
+                    AsyncReadRequest request;
+                    std::promise<AsyncReadResult> promise;
+                };
+
+                //! Get the result of a request given the size of the file,
+                //! creating the destination buffer if necessary.
+                //! Throws:
+                //! - Error
+                AsyncReadResult getResult(const AsyncReadRequest& request, size_t fileSize)
+                {
+                    AsyncReadResult out;
+                    out.fileName = request.fileName;
+                    out.offset = request.offset;
+                    if (request.offset > fileSize)
+                    {
+                        throw Error(getReadErrorMessage(request.fileName));
+                    }
+                    out.size = request.size ? request.size : (fileSize - request.offset);
+                    if (out.offset + out.size > fileSize)
+                    {
+                        throw Error(getReadErrorMessage(request.fileName));
+                    }
+                    if (request.buffer)
+                    {
+                        if (request.buffer->getSize() < out.size)
+                        {
+                            throw Error(getReadErrorMessage(request.fileName));
+                        }
+                        out.buffer = request.buffer;
+                    }
+                    else
+                    {
+                        out.buffer = ReadBuffer::create(out.size);
+                    }
+                    return out;
+                }
+
+#if defined(DJV_IO_URING)
+                //! This class provides a minimal io_uring interface using the
+                //! system calls directly.
+                class Ring
+                {
+                    DJV_NON_COPYABLE(Ring);
+
+                public:
+                    Ring()
+                    {}
+
+                    ~Ring()
+                    {
+                        if (_sqes != MAP_FAILED)
+                        {
+                            munmap(_sqes, _sqesSize);
+                        }
+                        if (_cqRing != MAP_FAILED && _cqRing != _sqRing)
+                        {
+                            munmap(_cqRing, _cqRingSize);
+                        }
+                        if (_sqRing != MAP_FAILED)
+                        {
+                            munmap(_sqRing, _sqRingSize);
+                        }
+                        if (_fd != -1)
+                        {
+                            close(_fd);
+                        }
+                    }
+
+                    bool init(unsigned entries)
+                    {
+                        io_uring_params params;
+                        memset(&params, 0, sizeof(io_uring_params));
+                        _fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                        if (-1 == _fd)
+                            return false;
+
+                        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                        _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                        const bool singleMMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                        if (singleMMap)
+                        {
+                            _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+                        }
+                        _sqRing = mmap(0, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+                        if (MAP_FAILED == _sqRing)
+                            return false;
+                        if (singleMMap)
+                        {
+                            _cqRing = _sqRing;
+                        }
+                        else
+                        {
+                            _cqRing = mmap(0, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+                            if (MAP_FAILED == _cqRing)
+                                return false;
+                        }
+                        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                        _sqes = mmap(0, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+                        if (MAP_FAILED == _sqes)
+                            return false;
+
+                        uint8_t* sq = reinterpret_cast<uint8_t*>(_sqRing);
+                        _sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                        _sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                        _sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                        uint8_t* cq = reinterpret_cast<uint8_t*>(_cqRing);
+                        _cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                        _cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                        _cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                        return true;
+                    }
+
+                    //! Get a submission queue entry. The number of entries that
+                    //! have not been submitted must be less than the size of the
+                    //! ring.
+                    io_uring_sqe* getSQE()
+                    {
+                        const unsigned tail = *_sqTail + _pending;
+                        const unsigned index = tail & _sqMask;
+                        io_uring_sqe* out = reinterpret_cast<io_uring_sqe*>(_sqes) + index;
+                        memset(out, 0, sizeof(io_uring_sqe));
+                        _sqArray[index] = index;
+                        ++_pending;
+                        return out;
+                    }
+
+                    //! Submit the pending entries and optionally wait for a
+                    //! completion.
+                    bool submit(bool wait)
+                    {
+                        if (_pending)
+                        {
+                            __atomic_store_n(_sqTail, *_sqTail + _pending, __ATOMIC_RELEASE);
+                        }
+                        unsigned submit = _pending;
+                        _pending = 0;
+                        while (submit || wait)
+                        {
+                            const int r = static_cast<int>(syscall(
+                                __NR_io_uring_enter,
+                                _fd,
+                                submit,
+                                wait ? 1 : 0,
+                                wait ? IORING_ENTER_GETEVENTS : 0,
+                                nullptr,
+                                0));
+                            if (r < 0)
+                            {
+                                if (EINTR == errno || EAGAIN == errno || EBUSY == errno)
+                                    continue;
+                                return false;
+                            }
+                            submit -= std::min(submit, static_cast<unsigned>(r));
+                            wait = false;
+                        }
+                        return true;
+                    }
+
+                    //! Get the next completion, or nullptr if there are none.
+                    //! The completion must be released with seen().
+                    const io_uring_cqe* peekCQE() const
+                    {
+                        const unsigned head = *_cqHead;
+                        if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+                            return nullptr;
+                        return _cqes + (head & _cqMask);
+                    }
+
+                    void seen()
+                    {
+                        __atomic_store_n(_cqHead, *_cqHead + 1, __ATOMIC_RELEASE);
+                    }
+
+                private:
+                    int           _fd         = -1;
+                    void*         _sqRing     = MAP_FAILED;
+                    void*         _cqRing     = MAP_FAILED;
+                    void*         _sqes       = MAP_FAILED;
+                    size_t        _sqRingSize = 0;
+                    size_t        _cqRingSize = 0;
+                    size_t        _sqesSize   = 0;
+                    unsigned*     _sqTail     = nullptr;
+                    unsigned      _sqMask     = 0;
+                    unsigned*     _sqArray    = nullptr;
+                    unsigned*     _cqHead     = nullptr;
+                    unsigned*     _cqTail     = nullptr;
+                    unsigned      _cqMask     = 0;
+                    io_uring_cqe* _cqes       = nullptr;
+                    unsigned      _pending    = 0;
+                };
+
+                std::string getReadErrorMessage(const std::string& fileName, int error)
+                {
+                    std::stringstream ss;
+                    char buf[String::cStringLength] = "";
+                    ss << getReadErrorMessage(fileName) << " " << strerror_r(error, buf, String::cStringLength);
+                    return ss.str();
+                }
+
+                //! The completion data for the event that wakes up the I/O
+                //! thread.
+                const uint64_t wakeUpData = static_cast<uint64_t>(-1);
+#endif // DJV_IO_URING
+
+            } // namespace
+
+            ReadBuffer::ReadBuffer()
+            {}
+
+            ReadBuffer::~ReadBuffer()
+            {
+                if (_owner && _data)
+                {
+#if defined(DJV_PLATFORM_WINDOWS)
+                    _aligned_free(_data);
+#else // DJV_PLATFORM_WINDOWS
+                    free(_data);
+#endif // DJV_PLATFORM_WINDOWS
+                }
+            }
+
+            std::shared_ptr<ReadBuffer> ReadBuffer::create(size_t size, size_t alignment)
+            {
+                auto out = std::shared_ptr<ReadBuffer>(new ReadBuffer);
+                if (size)
+                {
+                    void* data = nullptr;
+#if defined(DJV_PLATFORM_WINDOWS)
+                    data = _aligned_malloc(size, alignment);
+#else // DJV_PLATFORM_WINDOWS
+                    if (posix_memalign(&data, alignment, size) != 0)
+                    {
+                        data = nullptr;
+                    }
+#endif // DJV_PLATFORM_WINDOWS
+                    if (!data)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    out->_data = reinterpret_cast<uint8_t*>(data);
+                    out->_owner = true;
+                }
+                out->_size = size;
+                return out;
+            }
+
+            std::shared_ptr<ReadBuffer> ReadBuffer::create(uint8_t* data, size_t size)
+            {
+                auto out = std::shared_ptr<ReadBuffer>(new ReadBuffer);
+                out->_data = data;
+                out->_size = size;
+                return out;
+            }
+
+            uint8_t* ReadBuffer::getData() const
+            {
+                return _data;
+            }
+
+            size_t ReadBuffer::getSize() const
+            {
+                return _size;
+            }
+
+            AsyncReadRequest::AsyncReadRequest()
+            {}
+
+            AsyncReadRequest::AsyncReadRequest(const std::string& fileName, size_t offset, size_t size) :
+                fileName(fileName),
+                offset(offset),
+                size(size)
+            {}
+
+            struct AsyncFileIO::Private
+            {
+                size_t queueDepth = 0;
+                Backend backend = Backend::ThreadPool;
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::deque<std::shared_ptr<Request> > requests;
+                std::atomic<bool> running;
+                std::vector<std::thread> threads;
+#if defined(DJV_IO_URING)
+                std::unique_ptr<Ring> ring;
+                int wakeUp = -1;
+                uint64_t wakeUpValue = 0;
+                struct iovec wakeUpIOV;
+#endif // DJV_IO_URING
+
+                void threadPoolRun();
+#if defined(DJV_IO_URING)
+                void ringRun();
+#endif // DJV_IO_URING
+            };
+
+            void AsyncFileIO::_init(size_t queueDepth, Backend backend)
+            {
+                DJV_PRIVATE_PTR();
+                p.queueDepth = std::max(queueDepth, static_cast<size_t>(1));
+                p.running = true;
+#if defined(DJV_IO_URING)
+                if (Backend::IOURing == backend)
+                {
+                    // The ring has an extra entry for the wake up event.
+                    auto ring = std::unique_ptr<Ring>(new Ring);
+                    const int wakeUp = eventfd(0, EFD_CLOEXEC);
+                    if (wakeUp != -1 && ring->init(static_cast<unsigned>(p.queueDepth + 1)))
+                    {
+                        p.ring = std::move(ring);
+                        p.wakeUp = wakeUp;
+                        p.backend = Backend::IOURing;
+                        p.threads.push_back(std::thread(
+                            [this]
+                            {
+                                _p->ringRun();
+                            }));
+                        return;
+                    }
+                    if (wakeUp != -1)
+                    {
+                        close(wakeUp);
+                    }
+                }
+#else // DJV_IO_URING
+                (void)backend;
+#endif // DJV_IO_URING
+                p.backend = Backend::ThreadPool;
+                for (size_t i = 0; i < p.queueDepth; ++i)
+                {
+                    p.threads.push_back(std::thread(
+                        [this]
+                        {
+                            _p->threadPoolRun();
+                        }));
+                }
+            }
+
+            AsyncFileIO::AsyncFileIO() :
+                _p(new Private)
+            {}
+
+            AsyncFileIO::~AsyncFileIO()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.cv.notify_all();
+#if defined(DJV_IO_URING)
+                if (p.wakeUp != -1)
+                {
+                    const uint64_t value = 1;
+                    ssize_t r = write(p.wakeUp, &value, sizeof(uint64_t));
+                    (void)r;
+                }
+#endif // DJV_IO_URING
+                for (auto& i : p.threads)
+                {
+                    if (i.joinable())
+                    {
+                        i.join();
+                    }
+                }
+#if defined(DJV_IO_URING)
+                p.ring.reset();
+                if (p.wakeUp != -1)
+                {
+                    close(p.wakeUp);
+                }
+#endif // DJV_IO_URING
+            }
+
+            std::shared_ptr<AsyncFileIO> AsyncFileIO::create(size_t queueDepth, Backend backend)
+            {
+                auto out = std::shared_ptr<AsyncFileIO>(new AsyncFileIO);
+                out->_init(queueDepth, backend);
+                return out;
+            }
+
+            const std::shared_ptr<AsyncFileIO>& AsyncFileIO::getGlobal()
+            {
+                static const std::shared_ptr<AsyncFileIO> global = AsyncFileIO::create();
+                return global;
+            }
+
+            AsyncFileIO::Backend AsyncFileIO::getBackend() const
+            {
+                return _p->backend;
+            }
+
+            size_t AsyncFileIO::getQueueDepth() const
+            {
+                return _p->queueDepth;
+            }
+
+            std::future<AsyncReadResult> AsyncFileIO::read(const AsyncReadRequest& value)
+            {
+                auto out = read(std::vector<AsyncReadRequest>({ value }));
+                return std::move(out[0]);
+            }
+
+            std::vector<std::future<AsyncReadResult> > AsyncFileIO::read(const std::vector<AsyncReadRequest>& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<std::future<AsyncReadResult> > out;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    for (const auto& i : value)
+                    {
+                        auto request = std::make_shared<Request>();
+                        request->request = i;
+                        out.push_back(request->promise.get_future());
+                        p.requests.push_back(request);
+                    }
+                }
+                if (Backend::ThreadPool == p.backend)
+                {
+                    p.cv.notify_all();
+                }
+#if defined(DJV_IO_URING)
+                else
+                {
+                    // Wake up the I/O thread, it may be waiting on the ring
+                    // for reads to complete.
+                    p.cv.notify_one();
+                    const uint64_t one = 1;
+                    ssize_t r = write(p.wakeUp, &one, sizeof(uint64_t));
+                    (void)r;
+                }
+#endif // DJV_IO_URING
+                return out;
+            }
+
+            void AsyncFileIO::Private::threadPoolRun()
+            {
+                while (running)
+                {
+                    std::shared_ptr<Request> request;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(
+                            lock,
+                            [this]
+                            {
+                                return requests.size() || !running;
+                            });
+                        if (!running)
+                            break;
+                        request = requests.front();
+                        requests.pop_front();
+                    }
+                    try
+                    {
+                        FileIO io;
+                        io.open(request->request.fileName, FileIO::Mode::Read);
+                        AsyncReadResult result = getResult(request->request, io.getSize());
+                        if (result.size)
+                        {
+                            io.setPos(result.offset);
+                            io.read(result.buffer->getData(), result.size);
+                        }
+                        request->promise.set_value(result);
+                    }
+                    catch (const std::exception&)
+                    {
+                        request->promise.set_exception(std::current_exception());
+                    }
+                }
+            }
+
+#if defined(DJV_IO_URING)
+            void AsyncFileIO::Private::ringRun()
+            {
+                struct Read
+                {
+                    std::shared_ptr<Request> request;
+                    AsyncReadResult result;
+                    int fd = -1;
+                    size_t count = 0;
+                    struct iovec iov;
+                };
+                std::vector<std::unique_ptr<Read> > reads(queueDepth);
+                std::vector<size_t> freeSlots;
+                for (size_t i = 0; i < queueDepth; ++i)
+                {
+                    freeSlots.push_back(queueDepth - 1 - i);
+                }
+                size_t inFlight = 0;
+
+                auto submitRead = [this, &reads](size_t slot)
+                {
+                    Read& read = *reads[slot];
+                    read.iov.iov_base = read.result.buffer->getData() + read.count;
+                    read.iov.iov_len = read.result.size - read.count;
+                    io_uring_sqe* sqe = ring->getSQE();
+                    sqe->opcode = IORING_OP_READV;
+                    sqe->fd = read.fd;
+                    sqe->off = read.result.offset + read.count;
+                    sqe->addr = reinterpret_cast<uint64_t>(&read.iov);
+                    sqe->len = 1;
+                    sqe->user_data = slot;
+                };
+                auto submitWakeUp = [this]
+                {
+                    io_uring_sqe* sqe = ring->getSQE();
+                    sqe->opcode = IORING_OP_READV;
+                    sqe->fd = wakeUp;
+                    sqe->off = 0;
+                    wakeUpIOV.iov_base = &wakeUpValue;
+                    wakeUpIOV.iov_len = sizeof(uint64_t);
+                    sqe->addr = reinterpret_cast<uint64_t>(&wakeUpIOV);
+                    sqe->len = 1;
+                    sqe->user_data = wakeUpData;
+                };
+                auto finish = [&reads, &freeSlots, &inFlight](size_t slot, int error)
+                {
+                    Read& read = *reads[slot];
+                    close(read.fd);
+                    if (error)
+                    {
+                        read.request->promise.set_exception(std::make_exception_ptr(Error(getReadErrorMessage(read.result.fileName, error))));
+                    }
+                    else
+                    {
+                        read.request->promise.set_value(read.result);
+                    }
+                    reads[slot].reset();
+                    freeSlots.push_back(slot);
+                    --inFlight;
+                };
+
+                submitWakeUp();
+                bool ok = ring->submit(false);
+                while (ok && (running || inFlight))
+                {
+                    // Get new requests, only waiting for them when there are no
+                    // reads in flight.
+                    std::vector<std::shared_ptr<Request> > newRequests;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        if (!inFlight)
+                        {
+                            cv.wait(
+                                lock,
+                                [this]
+                                {
+                                    return requests.size() || !running;
+                                });
+                        }
+                        if (running)
+                        {
+                            while (requests.size() && freeSlots.size() > newRequests.size())
+                            {
+                                newRequests.push_back(requests.front());
+                                requests.pop_front();
+                            }
+                        }
+                    }
+
+                    // Open the files and submit the reads.
+                    for (const auto& request : newRequests)
+                    {
+                        const std::string& fileName = request->request.fileName;
+                        const int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+                        if (-1 == fd)
+                        {
+                            request->promise.set_exception(std::make_exception_ptr(Error(getReadErrorMessage(fileName, errno))));
+                            continue;
+                        }
+                        try
+                        {
+                            struct stat info;
+                            if (fstat(fd, &info) != 0)
+                            {
+                                throw Error(getReadErrorMessage(fileName, errno));
+                            }
+                            std::unique_ptr<Read> read(new Read);
+                            read->request = request;
+                            read->result = getResult(request->request, static_cast<size_t>(info.st_size));
+                            read->fd = fd;
+                            if (!read->result.size)
+                            {
+                                close(fd);
+                                request->promise.set_value(read->result);
+                                continue;
+                            }
+                            const size_t slot = freeSlots.back();
+                            freeSlots.pop_back();
+                            reads[slot] = std::move(read);
+                            ++inFlight;
+                            submitRead(slot);
+                        }
+                        catch (const std::exception&)
+                        {
+                            close(fd);
+                            request->promise.set_exception(std::current_exception());
+                        }
+                    }
+
+                    // Wait for a completion. The wake up event completes when
+                    // new requests are added.
+                    if (!ring->submit(inFlight > 0 || running))
+                    {
+                        ok = false;
+                        break;
+                    }
+
+                    // Handle the completions.
+                    while (const io_uring_cqe* cqe = ring->peekCQE())
+                    {
+                        const uint64_t data = cqe->user_data;
+                        const int res = cqe->res;
+                        ring->seen();
+                        if (wakeUpData == data)
+                        {
+                            if (running)
+                            {
+                                submitWakeUp();
+                            }
+                            continue;
+                        }
+                        const size_t slot = static_cast<size_t>(data);
+                        Read& read = *reads[slot];
+                        if (res < 0)
+                        {
+                            finish(slot, -res);
+                        }
+                        else if (0 == res)
+                        {
+                            // The file is shorter than expected.
+                            finish(slot, EIO);
+                        }
+                        else
+                        {
+                            read.count += static_cast<size_t>(res);
+                            if (read.count < read.result.size)
+                            {
+                                submitRead(slot);
+                            }
+                            else
+                            {
+                                finish(slot, 0);
+                            }
+                        }
+                    }
+                }
+
+                // The ring is not usable, fail the reads that are in flight
+                // and the requests that are waiting. The buffers of the reads
+                // in flight are not freed since the kernel may still write to
+                // them.
+                if (!ok)
+                {
+                    for (auto& i : reads)
+                    {
+                        if (i)
+                        {
+                            i->request->promise.set_exception(std::make_exception_ptr(Error(getReadErrorMessage(i->result.fileName))));
+                            i.release();
+                        }
+                    }
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto& i : requests)
+                {
+                    i->promise.set_exception(std::make_exception_ptr(Error(getReadErrorMessage(i->request.fileName))));
+                }
+                requests.clear();
+            }
+#endif // DJV_IO_URING
+
+        } // namespace FileSystem
+    } // namespace Core
+} // namespace djv
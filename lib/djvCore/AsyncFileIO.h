@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            //! This class provides a destination buffer for asynchronous reads.
+            class ReadBuffer
+            {
+                DJV_NON_COPYABLE(ReadBuffer);
+
+            protected:
+                ReadBuffer();
+
+            public:
+                ~ReadBuffer();
+
+                //! The default alignment, this is suitable for reads that
+                //! bypass the operating system cache.
+                static const size_t defaultAlignment = 4096;
+
+                //! Create a new buffer. The alignment must be a power of two.
+                static std::shared_ptr<ReadBuffer> create(size_t, size_t alignment = defaultAlignment);
+
+                //! Create a buffer that uses memory supplied by the caller. The
+                //! memory must remain valid for the lifetime of the buffer.
+                static std::shared_ptr<ReadBuffer> create(uint8_t*, size_t);
+
+                uint8_t* getData() const;
+                size_t getSize() const;
+
+            private:
+                uint8_t* _data = nullptr;
+                size_t _size = 0;
+                bool _owner = false;
+            };
+
+            //! This struct provides an asynchronous read request.
+            struct AsyncReadRequest
+            {
+                AsyncReadRequest();
+                explicit AsyncReadRequest(const std::string& fileName, size_t offset = 0, size_t size = 0);
+
+                std::string fileName;
+                size_t offset = 0;
+
+                //! The number of bytes to read, zero reads the rest of the file.
+                size_t size = 0;
+
+                //! The destination buffer, if this is null a new buffer is
+                //! created.
+                std::shared_ptr<ReadBuffer> buffer;
+            };
+
+            //! This struct provides the result of an asynchronous read.
+            struct AsyncReadResult
+            {
+                std::string fileName;
+                size_t offset = 0;
+                size_t size = 0;
+                std::shared_ptr<ReadBuffer> buffer;
+            };
+
+            //! This class provides asynchronous file reading.
+            //!
+            //! Many reads can be in flight at once, which hides the latency of
+            //! network storage where the number of outstanding requests, not
+            //! the CPU, limits the throughput. On Linux the reads are
+            //! submitted in batches with io_uring when the kernel supports it,
+            //! otherwise each read is performed by a thread from a pool.
+            //!
+            //! \todo Files are opened by the I/O thread before the reads are
+            //! submitted, io_uring could also open them asynchronously.
+            class AsyncFileIO
+            {
+                DJV_NON_COPYABLE(AsyncFileIO);
+
+            public:
+                enum class Backend
+                {
+                    IOURing,
+                    ThreadPool,
+
+                    Count,
+                    First = IOURing
+                };
+
+            protected:
+                void _init(size_t queueDepth, Backend);
+                AsyncFileIO();
+
+            public:
+                ~AsyncFileIO();
+
+                //! Create a new object. If the backend is not available the
+                //! thread pool is used instead.
+                static std::shared_ptr<AsyncFileIO> create(size_t queueDepth = 32, Backend = Backend::IOURing);
+
+                //! Get the object shared by the file readers.
+                static const std::shared_ptr<AsyncFileIO>& getGlobal();
+
+                //! Get the backend that is used.
+                Backend getBackend() const;
+
+                //! Get the maximum number of reads in flight.
+                size_t getQueueDepth() const;
+
+                //! \name Reading
+                //! The futures throw Error if the file cannot be read.
+                ///@{
+
+                std::future<AsyncReadResult> read(const AsyncReadRequest&);
+                std::vector<std::future<AsyncReadResult> > read(const std::vector<AsyncReadRequest>&);
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace FileSystem
+    } // namespace Core
+} // namespace djv
@@ -29,6 +29,9 @@
 
 #include <djvCore/FileIO.h>
 
+#include <djvCore/AsyncFileIO.h>
+
+#include <algorithm>
 #include <sstream>
 
 namespace djv
@@ -43,21 +46,35 @@ namespace djv
                 _pos(other._pos),
                 _size(other._size),
                 _endianConversion(other._endianConversion),
-                _f(other._f)
-#if defined(DJV_MMAP)
-                ,
+                _mmapEnabled(other._mmapEnabled),
+                _f(other._f),
                 _mmap(other._mmap),
                 _mmapStart(other._mmapStart),
                 _mmapEnd(other._mmapEnd),
-                _mmapP(other._mmapP)
-#endif // DJV_MMAP
-            {}
+                _mmapP(other._mmapP),
+                _buffer(std::move(other._buffer))
+            {
+                other._release();
+            }
 
             FileIO::~FileIO()
             {
                 close();
             }
 
+            void FileIO::open(const std::string & fileName, const std::shared_ptr<ReadBuffer> & buffer, size_t size)
+            {
+                close();
+                _fileName  = fileName;
+                _mode      = Mode::Read;
+                _pos       = 0;
+                _size      = std::min(size, buffer ? buffer->getSize() : 0);
+                _buffer    = buffer;
+                _mmapStart = _size ? buffer->getData() : nullptr;
+                _mmapEnd   = _mmapStart ? (_mmapStart + _size) : nullptr;
+                _mmapP     = _mmapStart;
+            }
+
             void FileIO::setPos(size_t in)
             {
                 _setPos(in, false);
@@ -77,35 +94,37 @@ namespace djv
             {
                 if (this != &other)
                 {
+                    close();
                     _fileName = std::move(other._fileName);
                     _mode = other._mode;
                     _pos = other._pos;
                     _size = other._size;
                     _endianConversion = other._endianConversion;
+                    _mmapEnabled = other._mmapEnabled;
                     _f = other._f;
-#if defined(DJV_MMAP)
                     _mmap = other._mmap;
                     _mmapStart = other._mmapStart;
                     _mmapEnd = other._mmapEnd;
                     _mmapP = other._mmapP;
-#endif // DJV_MMAP
+                    _buffer = std::move(other._buffer);
+                    other._release();
                 }
                 return *this;
             }
 
             std::string FileIO::readContents(FileIO & fileIO)
             {
-#ifdef DJV_MMAP
-                const uint8_t * p = fileIO.mmapP();
-                const uint8_t * end = fileIO.mmapEnd();
-                return std::string(reinterpret_cast<const char *>(p), end - p);
-#else // DJV_MMAP
+                if (fileIO.isMMap())
+                {
+                    const uint8_t * p = fileIO.mmapP();
+                    const uint8_t * end = fileIO.mmapEnd();
+                    return std::string(reinterpret_cast<const char *>(p), end - p);
+                }
                 const size_t fileSize = fileIO.getSize();
                 std::string out;
                 out.resize(fileSize);
                 fileIO.read(reinterpret_cast<void*>(&out[0]), fileSize);
                 return out;
-#endif // DJV_MMAP
             }
 
             void FileIO::readWord(FileIO & io, char * out, size_t maxLen)
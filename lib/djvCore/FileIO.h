@@ -31,6 +31,8 @@
 
 #include <djvCore/String.h>
 
+#include <memory>
+
 #if defined(DJV_PLATFORM_WINDOWS)
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -47,6 +49,8 @@ namespace djv
     {
         namespace FileSystem
         {
+            class ReadBuffer;
+
             //! This class provides file I/O.
             class FileIO
             {
@@ -74,6 +78,12 @@ namespace djv
                 //! - IOError
                 void open(const std::string & fileName, Mode);
 
+                //! Open the contents of a file that have already been read into
+                //! memory, for example by AsyncFileIO. The file is opened for
+                //! reading and the buffer is accessed as though it were memory
+                //! mapped.
+                void open(const std::string & fileName, const std::shared_ptr<ReadBuffer> &, size_t size);
+
                 //! Open a temporary file.
                 //! Throws:
                 //! - IOError
@@ -147,18 +157,38 @@ namespace djv
 
                 void write(const std::string &);
 
+                //! Reserve disk space for a file of the given size, so that
+                //! large files are written to contiguous blocks. The file size
+                //! is not changed. Errors are ignored.
+                void preallocate(size_t);
+
                 ///@}
 
                 //! \name Memory Mapping
                 ///@{
 
-#if defined(DJV_MMAP)
-                //! Get the current memory-map position.
+                //! Get whether files opened for reading are memory mapped.
+                bool hasMMap() const;
+
+                //! Set whether files opened for reading are memory mapped. This
+                //! takes effect the next time a file is opened.
+                void setMMap(bool);
+
+                //! Get whether the file is memory mapped.
+                bool isMMap() const;
+
+                //! Get the current memory-map position, or nullptr if the file
+                //! is not memory mapped.
                 const uint8_t * mmapP() const;
 
-                //! Get a pointer to the end of the memory-map.
+                //! Get a pointer to the end of the memory-map, or nullptr if
+                //! the file is not memory mapped.
                 const uint8_t * mmapEnd() const;
-#endif // DJV_MMAP
+
+                //! Tell the operating system that the given number of bytes
+                //! from the current position will be needed soon, so that it
+                //! can start reading them in the background.
+                void mmapWillNeed(size_t);
 
                 ///@}
 
@@ -202,37 +232,37 @@ namespace djv
                 //! - IOError
                 static void writeLines(const std::string & fileName, const std::vector<std::string> &);
 
+                //! Tell the operating system that a file will be read soon, so
+                //! that it can start reading it into the cache in the
+                //! background. Errors are ignored.
+                static void prefetch(const std::string & fileName);
+
                 ///@}
 
             private:
                 void _setPos(size_t, bool seek);
 
+                //! Reset the file handles without closing them, after they have
+                //! been moved to another object.
+                void _release();
+
                 std::string     _fileName;
                 Mode            _mode               = Mode::First;
                 size_t          _pos                = 0;
                 size_t          _size               = 0;
                 bool            _endianConversion   = false;
+                bool            _mmapEnabled        = false;
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                HANDLE          _f                  = INVALID_HANDLE_VALUE;
-#else // DJV_MMAP
                 FILE*           _f                  = nullptr;
-#endif // DJV_MMAP
-#if defined(DJV_MMAP)
-                void *          _mmap               = nullptr;
-                const uint8_t * _mmapStart          = nullptr;
-                const uint8_t * _mmapEnd            = nullptr;
-                const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
+                HANDLE          _mmap               = nullptr;
 #else // DJV_PLATFORM_WINDOWS
                 int             _f                  = -1;
-#if defined(DJV_MMAP)
                 void *          _mmap               = reinterpret_cast<void *>(-1);
+#endif // DJV_PLATFORM_WINDOWS
                 const uint8_t * _mmapStart          = nullptr;
                 const uint8_t * _mmapEnd            = nullptr;
                 const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
-#endif //DJV_PLATFORM_WINDOWS
+                std::shared_ptr<ReadBuffer> _buffer;
             };
 
         } // namespace FileSystem
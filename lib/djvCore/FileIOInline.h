@@ -39,13 +39,9 @@ namespace djv
             inline bool FileIO::isOpen() const
             {
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                return _f != INVALID_HANDLE_VALUE;
-#else // DJV_MMAP
-                return _f != nullptr;
-#endif // DJV_MMAP
+                return _f != nullptr || _buffer;
 #else // DJV_PLATFORM_WINDOWS
-                return _f != -1;
+                return _f != -1 || _buffer;
 #endif //DJV_PLATFORM_WINDOWS
             }
 
@@ -68,7 +64,7 @@ namespace djv
             {
 #if defined(DJV_PLATFORM_WINDOWS)
                 return
-                    _f == INVALID_HANDLE_VALUE ||
+                    (!_f && !_buffer) ||
                     (_size ? _pos >= _size : true);
 #else // DJV_PLATFORM_WINDOWS
                 return
@@ -78,7 +74,21 @@ namespace djv
 #endif //DJV_PLATFORM_WINDOWS
             }
 
-#if defined(DJV_MMAP)
+            inline bool FileIO::hasMMap() const
+            {
+                return _mmapEnabled;
+            }
+
+            inline void FileIO::setMMap(bool value)
+            {
+                _mmapEnabled = value;
+            }
+
+            inline bool FileIO::isMMap() const
+            {
+                return _mmapStart != nullptr;
+            }
+
             inline const uint8_t * FileIO::mmapP() const
             {
                 return _mmapP;
@@ -88,7 +98,6 @@ namespace djv
             {
                 return _mmapEnd;
             }
-#endif // DJV_MMAP
 
             inline bool FileIO::hasEndianConversion() const
             {
@@ -34,7 +34,9 @@
 #include <djvCore/Math.h>
 #include <djvCore/Memory.h>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #if defined(DJV_PLATFORM_LINUX)
@@ -208,21 +210,19 @@ namespace djv
                 _pos      = 0;
                 _size     = info.st_size;
 
-#if defined(DJV_MMAP)
                 // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
+                if (_mmapEnabled && Mode::Read == _mode && _size > 0)
                 {
                     _mmap = mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
-                    madvise(_mmap, _size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
                     if (_mmap == (void *) - 1)
                     {
                         throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
                     }
+                    madvise(_mmap, _size, MADV_SEQUENTIAL);
                     _mmapStart = reinterpret_cast<const uint8_t *>(_mmap);
                     _mmapEnd   = _mmapStart + _size;
                     _mmapP     = _mmapStart;
                 }
-#endif // DJV_MMAP
             }
             
             void FileIO::openTemp()
@@ -258,8 +258,6 @@ namespace djv
             {
                 bool out = true;
                 
-                _fileName = std::string();
-#if defined(DJV_MMAP)
                 if (_mmap != (void *) - 1)
                 {
                     int r = munmap(_mmap, _size);
@@ -273,9 +271,10 @@ namespace djv
                     }
                     _mmap = (void *)-1;
                 }
-                _mmapStart = 0;
-                _mmapEnd   = 0;
-#endif // DJV_MMAP
+                _mmapStart = nullptr;
+                _mmapEnd   = nullptr;
+                _mmapP     = nullptr;
+                _buffer.reset();
                 if (_f != -1)
                 {
                     int r = ::close(_f);
@@ -290,6 +289,7 @@ namespace djv
                     _f = -1;
                 }
 
+                _fileName = std::string();
                 _mode = static_cast<Mode>(0);
                 _pos  = 0;
                 _size = 0;
@@ -303,32 +303,35 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t* mmapP = _mmapP + size * wordSize;
-                    if (mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
+                    if (_mmapStart)
                     {
-                        Memory::endian(_mmapP, in, size, wordSize);
+                        const uint8_t* mmapP = _mmapP + size * wordSize;
+                        if (mmapP > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(_mmapP, in, size, wordSize);
+                        }
+                        else
+                        {
+                            memcpy(in, _mmapP, size * wordSize);
+                        }
+                        _mmapP = mmapP;
                     }
                     else
                     {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = mmapP;
-#else // DJV_MMAP
-                    const size_t r = ::read(_f, in, size * wordSize);
-                    if (r != size * wordSize)
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(in, size, wordSize);
+                        const size_t r = ::read(_f, in, size * wordSize);
+                        if (r != size * wordSize)
+                        {
+                            throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(in, size, wordSize);
+                        }
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -373,25 +376,19 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    if (!seek)
-                    {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + in;
-                    }
-                    else
+                    if (_mmapStart)
                     {
-                        _mmapP += in;
-                    }
-                    if (_mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        const uint8_t* mmapP = !seek ? (_mmapStart + in) : (_mmapP + in);
+                        if (mmapP > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        }
+                        _mmapP = mmapP;
                     }
-#else // DJV_MMAP
-                    if (::lseek(_f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t) - 1)
+                    else if (::lseek(_f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t) - 1)
                     {
                         throw Error(getErrorMessage(ErrorType::Seek, _fileName));
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::Write:
@@ -415,6 +412,80 @@ namespace djv
                 }
             }
 
+            void FileIO::preallocate(size_t value)
+            {
+                if (_f != -1 && value > _size)
+                {
+#if defined(DJV_PLATFORM_LINUX)
+                    fallocate(_f, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(value));
+#elif defined(DJV_PLATFORM_OSX)
+                    fstore_t store;
+                    memset(&store, 0, sizeof(fstore_t));
+                    store.fst_flags = F_ALLOCATECONTIG;
+                    store.fst_posmode = F_PEOFPOSMODE;
+                    store.fst_length = static_cast<off_t>(value - _size);
+                    if (-1 == fcntl(_f, F_PREALLOCATE, &store))
+                    {
+                        store.fst_flags = F_ALLOCATEALL;
+                        fcntl(_f, F_PREALLOCATE, &store);
+                    }
+#endif // DJV_PLATFORM_LINUX
+                }
+            }
+
+            void FileIO::mmapWillNeed(size_t value)
+            {
+                if (_mmap != reinterpret_cast<void *>(-1) && value)
+                {
+                    // The address given to madvise() must be page aligned.
+                    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                    const size_t offset = static_cast<size_t>(_mmapP - _mmapStart);
+                    const size_t start = offset / pageSize * pageSize;
+                    const size_t end = std::min(offset + value, _size);
+                    if (end > start)
+                    {
+                        madvise(const_cast<uint8_t*>(_mmapStart) + start, end - start, MADV_WILLNEED);
+                    }
+                }
+            }
+
+            void FileIO::prefetch(const std::string& fileName)
+            {
+                const int f = ::open(fileName.c_str(), O_RDONLY);
+                if (f != -1)
+                {
+#if defined(DJV_PLATFORM_LINUX)
+                    posix_fadvise(f, 0, 0, POSIX_FADV_WILLNEED);
+#elif defined(DJV_PLATFORM_OSX)
+                    _STAT info;
+                    memset(&info, 0, sizeof(_STAT));
+                    if (0 == fstat(f, &info) && info.st_size > 0)
+                    {
+                        struct radvisory advisory;
+                        advisory.ra_offset = 0;
+                        advisory.ra_count = static_cast<int>(std::min(
+                            static_cast<off_t>(std::numeric_limits<int>::max()),
+                            info.st_size));
+                        fcntl(f, F_RDADVISE, &advisory);
+                    }
+#endif // DJV_PLATFORM_LINUX
+                    ::close(f);
+                }
+            }
+
+            void FileIO::_release()
+            {
+                _f         = -1;
+                _mmap      = reinterpret_cast<void *>(-1);
+                _mmapStart = nullptr;
+                _mmapEnd   = nullptr;
+                _mmapP     = nullptr;
+                _buffer.reset();
+                _mode      = Mode::First;
+                _pos       = 0;
+                _size      = 0;
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
@@ -110,66 +110,6 @@ namespace djv
             {
                 close();
 
-#if defined(DJV_MMAP)
-                // Open the file.
-                DWORD desiredAccess = 0;
-                DWORD shareMode = 0;
-                DWORD disposition = 0;
-                DWORD flags =
-                    //FILE_ATTRIBUTE_NORMAL;
-                    FILE_FLAG_SEQUENTIAL_SCAN;
-                switch (mode)
-                {
-                case Mode::Read:
-                    desiredAccess = GENERIC_READ;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                case Mode::Write:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::ReadWrite:
-                    desiredAccess = GENERIC_READ | GENERIC_WRITE;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::Append:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                default: break;
-                }
-                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
-                _f = CreateFileW(utf16.from_bytes(fileName).c_str(), desiredAccess, shareMode, 0, disposition, flags, 0);
-                if (INVALID_HANDLE_VALUE == _f)
-                {
-                    throw Error(getErrorMessage(ErrorType::Open, fileName));
-                }
-                _fileName = fileName;
-                _mode = mode;
-                _pos = 0;
-                _size = GetFileSize(_f, 0);
-
-                // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
-                {
-                    _mmap = CreateFileMapping(_f, 0, PAGE_READONLY, 0, 0, 0);
-                    if (!_mmap)
-                    {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
-                    }
-
-                    _mmapStart = reinterpret_cast<const uint8_t *>(MapViewOfFile(_mmap, FILE_MAP_READ, 0, 0, 0));
-                    if (!_mmapStart)
-                    {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
-                    }
-
-                    _mmapEnd = _mmapStart + _size;
-                    _mmapP = _mmapStart;
-                }
-#else // DJV_MMAP
                 std::string modeStr;
                 switch (mode)
                 {
@@ -204,7 +144,24 @@ namespace djv
                 {
                     throw Error(getErrorMessage(ErrorType::Open, fileName));
                 }
-#endif // DJV_MMAP
+
+                // Memory mapping.
+                if (_mmapEnabled && Mode::Read == _mode && _size > 0)
+                {
+                    const HANDLE h = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(_f)));
+                    _mmap = CreateFileMapping(h, 0, PAGE_READONLY, 0, 0, 0);
+                    if (!_mmap)
+                    {
+                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                    }
+                    _mmapStart = reinterpret_cast<const uint8_t *>(MapViewOfFile(_mmap, FILE_MAP_READ, 0, 0, 0));
+                    if (!_mmapStart)
+                    {
+                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                    }
+                    _mmapEnd = _mmapStart + _size;
+                    _mmapP = _mmapStart;
+                }
             }
 
             void FileIO::openTemp()
@@ -231,49 +188,41 @@ namespace djv
             {
                 bool out = true;
 
-                _fileName = std::string();
-                
-#if defined(DJV_MMAP)
-                if (_mmapStart != 0)
+                if (_mmapStart && _mmap)
                 {
                     if (!::UnmapViewOfFile((void *)_mmapStart))
                     {
                         out = false;
                         if (error)
                         {
-                            *error = getErrorMessage(Error::CloseMemoryMap, _fileName);
+                            *error = getErrorMessage(ErrorType::CloseMemoryMap, _fileName);
                         }
                     }
-                    _mmapStart = 0;
                 }
-                if (_mmap != 0)
+                if (_mmap)
                 {
                     if (!::CloseHandle(_mmap))
                     {
                         out = false;
                         if (error)
                         {
-                            *error = getErrorMessage(Error::Close, _fileName);
+                            *error = getErrorMessage(ErrorType::Close, _fileName);
                         }
                     }
-                    _mmap = 0;
+                    _mmap = nullptr;
                 }
-                _mmapEnd = 0;
-                _mmapP   = 0;
+                _mmapStart = nullptr;
+                _mmapEnd   = nullptr;
+                _mmapP     = nullptr;
+                _buffer.reset();
 
-                if (_f != INVALID_HANDLE_VALUE)
-                {
-                    CloseHandle(_f);
-                    _f = INVALID_HANDLE_VALUE;
-                }
-#else // DJV_MMAP
                 if (_f)
                 {
                     fclose(_f);
                     _f = nullptr;
                 }
-#endif // DJV_MMAP
 
+                _fileName = std::string();
                 _mode = Mode::First;
                 _pos  = 0;
                 _size = 0;
@@ -287,37 +236,35 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t * p = _mmapP + size * wordSize;
-                    if (p > _mmapEnd)
+                    if (_mmapStart)
                     {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(_mmapP, in, size, wordSize);
+                        const uint8_t * p = _mmapP + size * wordSize;
+                        if (p > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(_mmapP, in, size, wordSize);
+                        }
+                        else
+                        {
+                            memcpy(in, _mmapP, size * wordSize);
+                        }
+                        _mmapP = p;
                     }
                     else
                     {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = p;
-#else // DJV_MMAP
-                    /*DWORD n;
-                    if (!::ReadFile(_f, in, static_cast<DWORD>(size * wordSize), &n, 0))
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }*/
-                    size_t r = fread(in, 1, size * wordSize, _f);
-                    if (r != size * wordSize)
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(in, size, wordSize);
+                        size_t r = fread(in, 1, size * wordSize, _f);
+                        if (r != size * wordSize)
+                        {
+                            throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(in, size, wordSize);
+                        }
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -376,35 +323,19 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    if (!seek)
-                    {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + value;
-                    }
-                    else
+                    if (_mmapStart)
                     {
-                        _mmapP += value;
-                    }
-                    if (_mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        const uint8_t * p = !seek ? (_mmapStart + value) : (_mmapP + value);
+                        if (p > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        }
+                        _mmapP = p;
                     }
-#else // DJV_MMAP
-                    /*LARGE_INTEGER v;
-                    v.QuadPart = value;
-                    if (!::SetFilePointerEx(
-                        _f,
-                        static_cast<LARGE_INTEGER>(v),
-                        0,
-                        !seek ? FILE_BEGIN : FILE_CURRENT))
-                    {
-                        throw Error(getErrorMessage(ErrorType::Seek, _fileName));
-                    }*/
-                    if (fseek(_f, value, !seek ? SEEK_SET : SEEK_CUR) != 0)
+                    else if (fseek(_f, value, !seek ? SEEK_SET : SEEK_CUR) != 0)
                     {
                         throw Error(getErrorMessage(ErrorType::Seek, _fileName));
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::Write:
@@ -440,6 +371,36 @@ namespace djv
                 }
             }
 
+            void FileIO::preallocate(size_t)
+            {
+                //! \todo Use SetFileInformationByHandle() with
+                //! FILE_ALLOCATION_INFO.
+            }
+
+            void FileIO::mmapWillNeed(size_t)
+            {
+                //! \todo Use PrefetchVirtualMemory() when it is available.
+            }
+
+            void FileIO::prefetch(const std::string&)
+            {
+                //! \todo Read the file with FILE_FLAG_OVERLAPPED to warm the
+                //! cache?
+            }
+
+            void FileIO::_release()
+            {
+                _f         = nullptr;
+                _mmap      = nullptr;
+                _mmapStart = nullptr;
+                _mmapEnd   = nullptr;
+                _mmapP     = nullptr;
+                _buffer.reset();
+                _mode      = Mode::First;
+                _pos       = 0;
+                _size      = 0;
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
@@ -286,16 +286,12 @@ namespace djv
                 std::shared_ptr<AV::Image::Image> image;
                 bool finished = false;
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
                     auto& queue = i->read->getVideoQueue();
+                    finished = queue.isFinished();
                     if (!queue.isEmpty())
                     {
                         image = queue.getFrame().image;
                     }
-                    else if (queue.isFinished())
-                    {
-                        finished = true;
-                    }
                 }
                 if (image)
                 {
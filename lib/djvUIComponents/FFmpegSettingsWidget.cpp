@@ -29,6 +29,7 @@
 
 #include <djvUIComponents/FFmpegSettingsWidget.h>
 
+#include <djvUI/ComboBox.h>
 #include <djvUI/FormLayout.h>
 #include <djvUI/GroupBox.h>
 #include <djvUI/IntSlider.h>
@@ -45,6 +46,7 @@ namespace djv
     {
         struct FFmpegSettingsWidget::Private
         {
+            std::shared_ptr<ComboBox> threadTypeComboBox;
             std::shared_ptr<IntSlider> threadCountSlider;
             std::shared_ptr<FormLayout> layout;
         };
@@ -56,10 +58,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             setClassName("djv::UI::FFmpegSettingsWidget");
 
+            p.threadTypeComboBox = ComboBox::create(context);
+
             p.threadCountSlider = IntSlider::create(context);
             p.threadCountSlider->setRange(IntRange(1, 16));
 
             p.layout = FormLayout::create(context);
+            p.layout->addChild(p.threadTypeComboBox);
             p.layout->addChild(p.threadCountSlider);
             addChild(p.layout);
 
@@ -67,6 +72,22 @@ namespace djv
 
             auto weak = std::weak_ptr<FFmpegSettingsWidget>(std::dynamic_pointer_cast<FFmpegSettingsWidget>(shared_from_this()));
             auto contextWeak = std::weak_ptr<Context>(context);
+            p.threadTypeComboBox->setCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::FFmpeg::Options options;
+                            fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
+                            options.threadType = static_cast<AV::IO::FFmpeg::ThreadType>(value);
+                            io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options));
+                        }
+                    }
+                });
+
             p.threadCountSlider->setValueCallback(
                 [weak, contextWeak](int value)
                 {
@@ -114,6 +135,7 @@ namespace djv
         {
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
+            p.layout->setText(p.threadTypeComboBox, _getText(DJV_TEXT("Thread type")) + ":");
             p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("Thread count")) + ":");
             _widgetUpdate();
         }
@@ -127,6 +149,15 @@ namespace djv
                 AV::IO::FFmpeg::Options options;
                 fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
 
+                p.threadTypeComboBox->clearItems();
+                for (auto i : AV::IO::FFmpeg::getThreadTypeEnums())
+                {
+                    std::stringstream ss;
+                    ss << i;
+                    p.threadTypeComboBox->addItem(_getText(ss.str()));
+                }
+                p.threadTypeComboBox->setCurrentItem(static_cast<int>(options.threadType));
+
                 p.threadCountSlider->setValue(options.threadCount);
             }
         }
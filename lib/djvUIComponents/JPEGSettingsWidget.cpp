@@ -29,6 +29,7 @@
 
 #include <djvUIComponents/JPEGSettingsWidget.h>
 
+#include <djvUI/CheckBox.h>
 #include <djvUI/FormLayout.h>
 #include <djvUI/IntSlider.h>
 
@@ -46,6 +47,7 @@ namespace djv
         struct JPEGSettingsWidget::Private
         {
             std::shared_ptr<IntSlider> qualitySlider;
+            std::shared_ptr<CheckBox> fastDecodeCheckBox;
             std::shared_ptr<FormLayout> layout;
         };
 
@@ -59,8 +61,11 @@ namespace djv
             p.qualitySlider = IntSlider::create(context);
             p.qualitySlider->setRange(IntRange(0, 100));
 
+            p.fastDecodeCheckBox = CheckBox::create(context);
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.qualitySlider);
+            p.layout->addChild(p.fastDecodeCheckBox);
             addChild(p.layout);
 
             _widgetUpdate();
@@ -82,6 +87,22 @@ namespace djv
                         }
                     }
                 });
+
+            p.fastDecodeCheckBox->setCheckedCallback(
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::JPEG::Options options;
+                            fromJSON(io->getOptions(AV::IO::JPEG::pluginName), options);
+                            options.fastDecode = value;
+                            io->setOptions(AV::IO::JPEG::pluginName, toJSON(options));
+                        }
+                    }
+                });
         }
 
         JPEGSettingsWidget::JPEGSettingsWidget() :
@@ -115,6 +136,7 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.layout->setText(p.qualitySlider, _getText(DJV_TEXT("Compression quality")) + ":");
+            p.fastDecodeCheckBox->setText(_getText(DJV_TEXT("Fast preview quality decoding")));
         }
 
         void JPEGSettingsWidget::_widgetUpdate()
@@ -126,6 +148,7 @@ namespace djv
                 AV::IO::JPEG::Options options;
                 fromJSON(io->getOptions(AV::IO::JPEG::pluginName), options);
                 p.qualitySlider->setValue(options.quality);
+                p.fastDecodeCheckBox->setChecked(options.fastDecode);
             }
         }
 
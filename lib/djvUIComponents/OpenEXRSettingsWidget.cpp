@@ -51,6 +51,7 @@ namespace djv
             std::shared_ptr<ComboBox> channelsComboBox;
             std::shared_ptr<ComboBox> compressionComboBox;
             std::shared_ptr<FloatSlider> dwaCompressionLevelSlider;
+            std::shared_ptr<IntSlider> zipCompressionLevelSlider;
             std::shared_ptr<FormLayout> layout;
         };
 
@@ -71,11 +72,15 @@ namespace djv
             p.dwaCompressionLevelSlider = FloatSlider::create(context);
             p.dwaCompressionLevelSlider->setRange(FloatRange(0.F, 200.F));
 
+            p.zipCompressionLevelSlider = IntSlider::create(context);
+            p.zipCompressionLevelSlider->setRange(IntRange(1, 9));
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.threadCountSlider);
             p.layout->addChild(p.channelsComboBox);
             p.layout->addChild(p.compressionComboBox);
             p.layout->addChild(p.dwaCompressionLevelSlider);
+            p.layout->addChild(p.zipCompressionLevelSlider);
             addChild(p.layout);
 
             _widgetUpdate();
@@ -145,6 +150,22 @@ namespace djv
                         }
                     }
                 });
+
+            p.zipCompressionLevelSlider->setValueCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::OpenEXR::Options options;
+                            fromJSON(io->getOptions(AV::IO::OpenEXR::pluginName), options);
+                            options.zipCompressionLevel = value;
+                            io->setOptions(AV::IO::OpenEXR::pluginName, toJSON(options));
+                        }
+                    }
+                });
         }
 
         OpenEXRSettingsWidget::OpenEXRSettingsWidget() :
@@ -181,6 +202,7 @@ namespace djv
             p.layout->setText(p.channelsComboBox, _getText(DJV_TEXT("Channel grouping")) + ":");
             p.layout->setText(p.compressionComboBox, _getText(DJV_TEXT("File compression")) + ":");
             p.layout->setText(p.dwaCompressionLevelSlider, _getText(DJV_TEXT("DWA compression level")) + ":");
+            p.layout->setText(p.zipCompressionLevelSlider, _getText(DJV_TEXT("ZIP compression level")) + ":");
             _widgetUpdate();
         }
 
@@ -214,6 +236,7 @@ namespace djv
                 p.compressionComboBox->setCurrentItem(static_cast<int>(options.compression));
 
                 p.dwaCompressionLevelSlider->setValue(options.dwaCompressionLevel);
+                p.zipCompressionLevelSlider->setValue(options.zipCompressionLevel);
             }
         }
 
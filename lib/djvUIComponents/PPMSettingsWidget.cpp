@@ -32,6 +32,7 @@
 #include <djvUI/ComboBox.h>
 #include <djvUI/FormLayout.h>
 #include <djvUI/GroupBox.h>
+#include <djvUI/IntSlider.h>
 
 #include <djvAV/PPM.h>
 
@@ -46,6 +47,7 @@ namespace djv
         struct PPMSettingsWidget::Private
         {
             std::shared_ptr<ComboBox> comboBox;
+            std::shared_ptr<IntSlider> threadCountSlider;
             std::shared_ptr<FormLayout> layout;
         };
 
@@ -58,8 +60,12 @@ namespace djv
 
             p.comboBox = ComboBox::create(context);
 
+            p.threadCountSlider = IntSlider::create(context);
+            p.threadCountSlider->setRange(IntRange(1, 16));
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.comboBox);
+            p.layout->addChild(p.threadCountSlider);
             addChild(p.layout);
 
             _widgetUpdate();
@@ -78,6 +84,19 @@ namespace djv
                         io->setOptions(AV::IO::PPM::pluginName, toJSON(options));
                     }
                 });
+
+            p.threadCountSlider->setValueCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto io = context->getSystemT<AV::IO::System>();
+                        AV::IO::PPM::Options options;
+                        fromJSON(io->getOptions(AV::IO::PPM::pluginName), options);
+                        options.threadCount = value;
+                        io->setOptions(AV::IO::PPM::pluginName, toJSON(options));
+                    }
+                });
         }
 
         PPMSettingsWidget::PPMSettingsWidget() :
@@ -111,6 +130,7 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.layout->setText(p.comboBox, _getText(DJV_TEXT("Data type")) + ":");
+            p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("Thread count")) + ":");
             _widgetUpdate();
         }
 
@@ -131,6 +151,8 @@ namespace djv
                     p.comboBox->addItem(_getText(ss.str()));
                 }
                 p.comboBox->setCurrentItem(static_cast<int>(options.data));
+
+                p.threadCountSlider->setValue(options.threadCount);
             }
         }
 
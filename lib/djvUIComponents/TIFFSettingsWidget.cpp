@@ -29,8 +29,10 @@
 
 #include <djvUIComponents/TIFFSettingsWidget.h>
 
+#include <djvUI/CheckBox.h>
 #include <djvUI/ComboBox.h>
 #include <djvUI/FormLayout.h>
+#include <djvUI/IntSlider.h>
 
 #include <djvAV/TIFF.h>
 
@@ -45,6 +47,9 @@ namespace djv
         struct TIFFSettingsWidget::Private
         {
             std::shared_ptr<ComboBox> compressionComboBox;
+            std::shared_ptr<IntSlider> threadCountSlider;
+            std::shared_ptr<IntSlider> rowsPerStripSlider;
+            std::shared_ptr<CheckBox> predictorCheckBox;
             std::shared_ptr<FormLayout> layout;
         };
 
@@ -57,8 +62,19 @@ namespace djv
 
             p.compressionComboBox = ComboBox::create(context);
 
+            p.threadCountSlider = IntSlider::create(context);
+            p.threadCountSlider->setRange(IntRange(1, 16));
+
+            p.rowsPerStripSlider = IntSlider::create(context);
+            p.rowsPerStripSlider->setRange(IntRange(1, 512));
+
+            p.predictorCheckBox = CheckBox::create(context);
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.compressionComboBox);
+            p.layout->addChild(p.threadCountSlider);
+            p.layout->addChild(p.rowsPerStripSlider);
+            p.layout->addChild(p.predictorCheckBox);
             addChild(p.layout);
 
             _widgetUpdate();
@@ -77,6 +93,45 @@ namespace djv
                         io->setOptions(AV::IO::TIFF::pluginName, toJSON(options));
                     }
                 });
+
+            p.threadCountSlider->setValueCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto io = context->getSystemT<AV::IO::System>();
+                        AV::IO::TIFF::Options options;
+                        fromJSON(io->getOptions(AV::IO::TIFF::pluginName), options);
+                        options.threadCount = value;
+                        io->setOptions(AV::IO::TIFF::pluginName, toJSON(options));
+                    }
+                });
+
+            p.rowsPerStripSlider->setValueCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto io = context->getSystemT<AV::IO::System>();
+                        AV::IO::TIFF::Options options;
+                        fromJSON(io->getOptions(AV::IO::TIFF::pluginName), options);
+                        options.rowsPerStrip = value;
+                        io->setOptions(AV::IO::TIFF::pluginName, toJSON(options));
+                    }
+                });
+
+            p.predictorCheckBox->setCheckedCallback(
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto io = context->getSystemT<AV::IO::System>();
+                        AV::IO::TIFF::Options options;
+                        fromJSON(io->getOptions(AV::IO::TIFF::pluginName), options);
+                        options.predictor = value;
+                        io->setOptions(AV::IO::TIFF::pluginName, toJSON(options));
+                    }
+                });
         }
 
         TIFFSettingsWidget::TIFFSettingsWidget() :
@@ -110,6 +165,9 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.layout->setText(p.compressionComboBox, _getText(DJV_TEXT("File compression")) + ":");
+            p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("Thread count")) + ":");
+            p.layout->setText(p.rowsPerStripSlider, _getText(DJV_TEXT("Rows per strip")) + ":");
+            p.predictorCheckBox->setText(_getText(DJV_TEXT("LZW and ZIP predictor")));
             _widgetUpdate();
         }
 
@@ -130,6 +188,10 @@ namespace djv
                     p.compressionComboBox->addItem(_getText(ss.str()));
                 }
                 p.compressionComboBox->setCurrentItem(static_cast<int>(options.compression));
+
+                p.threadCountSlider->setValue(options.threadCount);
+                p.rowsPerStripSlider->setValue(options.rowsPerStrip);
+                p.predictorCheckBox->setChecked(options.predictor);
             }
         }
 
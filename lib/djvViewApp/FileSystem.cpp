@@ -46,6 +46,9 @@
 #include <djvUI/SettingsSystem.h>
 #include <djvUI/Shortcut.h>
 
+#include <djvAV/IO.h>
+#include <djvAV/IOCacheManager.h>
+
 #include <djvCore/Context.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/RecentFilesModel.h>
@@ -70,6 +73,8 @@ namespace djv
             std::shared_ptr<ListSubject<std::shared_ptr<Media> > > media;
             std::shared_ptr<ValueSubject<std::shared_ptr<Media> > > currentMedia;
             std::shared_ptr<ValueSubject<float> > cachePercentage;
+            std::shared_ptr<MapSubject<std::shared_ptr<Media>, size_t> > cacheByteCounts;
+            std::shared_ptr<AV::IO::CacheManager> cacheManager;
             std::map<std::string, std::shared_ptr<UI::Action> > actions;
             std::shared_ptr<UI::Menu> menu;
             std::shared_ptr<UI::FileBrowser::Dialog> fileBrowserDialog;
@@ -101,6 +106,11 @@ namespace djv
             p.media = ListSubject<std::shared_ptr<Media> >::create();
             p.currentMedia = ValueSubject<std::shared_ptr<Media> >::create();
             p.cachePercentage = ValueSubject<float>::create();
+            p.cacheByteCounts = MapSubject<std::shared_ptr<Media>, size_t>::create();
+            if (auto ioSystem = context->getSystemT<AV::IO::System>())
+            {
+                p.cacheManager = ioSystem->getCacheManager();
+            }
 
             p.actions["Open"] = UI::Action::create();
             p.actions["Open"]->setIcon("djvIconFileOpen");
@@ -424,20 +434,26 @@ namespace djv
                 {
                     if (auto system = weak.lock())
                     {
-                        size_t cacheMaxByteCount  = 0;
-                        size_t cacheByteCount = 0;
+                        std::map<std::shared_ptr<Media>, size_t> cacheByteCounts;
                         for (const auto& i : system->_p->media->get())
                         {
                             if (i->hasCache())
                             {
-                                cacheMaxByteCount  += i->getCacheMaxByteCount();
-                                cacheByteCount += i->getCacheByteCount();
+                                cacheByteCounts[i] = i->getCacheByteCount();
                             }
                         }
+                        size_t cacheMaxByteCount = 0;
+                        size_t cacheByteCount = 0;
+                        if (const auto& cacheManager = system->_p->cacheManager)
+                        {
+                            cacheMaxByteCount = cacheManager->getMaxByteCount();
+                            cacheByteCount = cacheManager->getByteCount();
+                        }
                         const float percentage = cacheMaxByteCount ?
                             (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
                             0.F;
                         system->_p->cachePercentage->setIfChanged(percentage);
+                        system->_p->cacheByteCounts->setIfChanged(cacheByteCounts);
                     }
                 });
         }
@@ -498,6 +514,11 @@ namespace djv
             return _p->cachePercentage;
         }
 
+        std::shared_ptr<IMapSubject<std::shared_ptr<Media>, size_t> > FileSystem::observeCacheByteCounts() const
+        {
+            return _p->cacheByteCounts;
+        }
+
         void FileSystem::open()
         {
             _showFileBrowserDialog();
@@ -638,22 +659,18 @@ namespace djv
         void FileSystem::_cacheUpdate()
         {
             DJV_PRIVATE_PTR();
-            size_t cacheCount = 0;
-            const auto& media = p.media->get();
-            for (const auto& i : media)
-            {
-                if (i->hasCache())
-                {
-                    ++cacheCount;
-                }
-            }
             const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
             const size_t cacheMaxByteCount = p.settings->observeCacheMaxGB()->get() * Memory::gigabyte;
-            const size_t mediaCacheSizeByteCount = cacheCount > 0 ? (cacheMaxByteCount / cacheCount) : 0;
-            for (const auto& i : media)
+            if (p.cacheManager)
+            {
+                p.cacheManager->setMaxByteCount(cacheMaxByteCount);
+            }
+            // The media share the cache, so each one may use all of it and
+            // the cache manager decides which frames are kept.
+            for (const auto& i : p.media->get())
             {
                 i->setCacheEnabled(cacheEnabled);
-                i->setCacheMaxByteCount(mediaCacheSizeByteCount);
+                i->setCacheMaxByteCount(cacheMaxByteCount);
             }
         }
 
@@ -32,6 +32,7 @@
 #include <djvViewApp/IViewSystem.h>
 
 #include <djvCore/ListObserver.h>
+#include <djvCore/MapObserver.h>
 #include <djvCore/ValueObserver.h>
 
 #include <glm/vec2.hpp>
@@ -72,6 +73,10 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<Media> > > observeCurrentMedia() const;
             std::shared_ptr<Core::IValueSubject<float> > observeCachePercentage() const;
 
+            //! Observe the number of bytes each media is using in the cache,
+            //! keyed by media.
+            std::shared_ptr<Core::IMapSubject<std::shared_ptr<Media>, size_t> > observeCacheByteCounts() const;
+
             void open();
             void open(const Core::FileSystem::FileInfo&);
             void open(const Core::FileSystem::FileInfo&, const glm::vec2& pos);
@@ -50,6 +50,18 @@ namespace djv
             //! \todo Should this be configurable?
             const size_t bufferFrameCount = 256;
             const size_t videoQueueSize = 10;
+
+            AV::IO::PlaybackMode toIO(PlaybackMode value)
+            {
+                AV::IO::PlaybackMode out = AV::IO::PlaybackMode::Loop;
+                switch (value)
+                {
+                case PlaybackMode::Once:     out = AV::IO::PlaybackMode::Once;     break;
+                case PlaybackMode::PingPong: out = AV::IO::PlaybackMode::PingPong; break;
+                default: break;
+                }
+                return out;
+            }
             
         } // namespace
 
@@ -95,6 +107,7 @@ namespace djv
             std::chrono::system_clock::time_point audioDataSamplesTime;
             Frame::Index frameOffset = 0;
             std::chrono::system_clock::time_point startTime;
+            bool seekWait = false;
             std::chrono::system_clock::time_point realSpeedTime;
             size_t realSpeedFrameCount = 0;
             std::chrono::system_clock::time_point playEveryFrameTime;
@@ -313,6 +326,10 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.speed->setIfChanged(value))
             {
+                if (p.read)
+                {
+                    p.read->setPlaybackSpeed(value);
+                }
                 _seek(p.currentFrame->get());
                 p.audioEnabled->setIfChanged(_isAudioEnabled());
                 if (_hasAudioSyncPlayback())
@@ -446,7 +463,14 @@ namespace djv
 
         void Media::setPlaybackMode(PlaybackMode value)
         {
-            _p->playbackMode->setIfChanged(value);
+            DJV_PRIVATE_PTR();
+            if (p.playbackMode->setIfChanged(value))
+            {
+                if (p.read)
+                {
+                    p.read->setPlaybackMode(toIO(value));
+                }
+            }
         }
 
         void Media::setInOutPoints(const AV::IO::InOutPoints& value)
@@ -687,6 +711,8 @@ namespace djv
                     p.info->setIfChanged(info);
                     p.speed->setIfChanged(speed);
                     p.defaultSpeed->setIfChanged(speed);
+                    p.read->setPlaybackSpeed(p.speed->get());
+                    p.read->setPlaybackMode(toIO(p.playbackMode->get()));
                     p.sequence->setIfChanged(sequence);
                     const size_t sequenceSize = sequence.getSize();
                     p.inOutPoints->setIfChanged(AV::IO::InOutPoints(false, 0, sequenceSize > 0 ? (static_cast<Frame::Index>(sequenceSize) - 1) : 0));
@@ -764,7 +790,6 @@ namespace djv
                                     size_t audioQueueMax   = 0;
                                     size_t audioQueueCount = 0;
                                     {
-                                        std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
                                         const auto& videoQueue = media->_p->read->getVideoQueue();
                                         const auto& audioQueue = media->_p->read->getAudioQueue();
                                         videoQueueMax   = videoQueue.getMax();
@@ -890,6 +915,7 @@ namespace djv
                 p.audioDataSamplesTime = now;
                 p.frameOffset = p.currentFrame->get();
                 p.startTime = now;
+                p.seekWait = true;
                 p.realSpeedTime = p.startTime;
                 p.realSpeedFrameCount = 0;
                 p.playEveryFrameTime = now;
@@ -999,6 +1025,20 @@ namespace djv
                 }
                 else
                 {
+                    if (p.seekWait)
+                    {
+                        // Don't start the clock until the reader has the first frame
+                        // after seeking, otherwise the decoder latency (for example
+                        // with FFmpeg frame threading) is skipped over.
+                        if (p.read && p.read->isSeeking())
+                        {
+                            break;
+                        }
+                        p.seekWait = false;
+                        p.startTime = now;
+                        p.realSpeedTime = now;
+                        p.realSpeedFrameCount = 0;
+                    }
                     std::chrono::duration<double> delta = now - p.startTime;
                     Frame::Index elapsed = static_cast<Frame::Index>(delta.count() * speed.toFloat());
                     Frame::Index frame = Frame::invalid;
@@ -1073,7 +1113,6 @@ namespace djv
                 AV::IO::VideoFrame frame;
                 bool gotFrame = false;
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
                     auto& queue = p.read->getVideoQueue();
                     if (p.playEveryFrame->get())
                     {
@@ -1111,10 +1150,13 @@ namespace djv
                     }
                 }
 
-                // Update the audio queue.
-                if (_hasAudio() && !_hasAudioSyncPlayback())
+                // Update the audio queue. The audio queue only supports one
+                // consumer, so the frames are only trimmed here while the audio
+                // stream is stopped. The stream is only started from this
+                // thread and stopping it waits for the callback to finish, so
+                // the callback cannot pop the queue at the same time.
+                if (_hasAudio() && !p.rtAudio->isStreamRunning())
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
                     auto& queue = p.read->getAudioQueue();
                     while (queue.getCount() > queue.getMax())
                     {
@@ -1148,13 +1190,11 @@ namespace djv
             // Get audio frames from the read queue.
             std::vector<AV::IO::AudioFrame> frames;
             {
-                std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
                 auto& queue = media->_p->read->getAudioQueue();
                 while (!queue.isEmpty() && sampleCount < outputSampleCount)
                 {
-                    auto frame = queue.getFrame();
+                    auto frame = queue.popFrame();
                     frames.push_back(frame);
-                    queue.popFrame();
                     sampleCount += frame.audio->getSampleCount();
                 }
             }
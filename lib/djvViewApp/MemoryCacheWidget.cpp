@@ -31,8 +31,10 @@
 
 #include <djvViewApp/FileSettings.h>
 #include <djvViewApp/FileSystem.h>
+#include <djvViewApp/Media.h>
 
 #include <djvUI/CheckBox.h>
+#include <djvUI/FormLayout.h>
 #include <djvUI/IntSlider.h>
 #include <djvUI/Label.h>
 #include <djvUI/RowLayout.h>
@@ -50,6 +52,7 @@ namespace djv
         struct MemoryCacheWidget::Private
         {
             float percentageUsed = 0.F;
+            std::map<std::shared_ptr<Media>, size_t> cacheByteCounts;
 
             std::shared_ptr<UI::Label> titleLabel;
             std::shared_ptr<UI::CheckBox> enabledCheckBox;
@@ -57,11 +60,14 @@ namespace djv
             std::shared_ptr<UI::Label> maxGBLabel;
             std::shared_ptr<UI::Label> percentageLabel;
             std::shared_ptr<UI::Label> percentageLabel2;
+            std::map<std::shared_ptr<Media>, std::shared_ptr<UI::Label> > mediaLabels;
+            std::shared_ptr<UI::FormLayout> mediaLayout;
             std::shared_ptr<UI::VerticalLayout> layout;
 
             std::shared_ptr<ValueObserver<bool> > enabledObserver;
             std::shared_ptr<ValueObserver<int> > maxGBObserver;
             std::shared_ptr<ValueObserver<float> > percentageObserver;
+            std::shared_ptr<MapObserver<std::shared_ptr<Media>, size_t> > cacheByteCountsObserver;
         };
 
         void MemoryCacheWidget::_init(const std::shared_ptr<Core::Context>& context)
@@ -87,6 +93,9 @@ namespace djv
             p.percentageLabel2 = UI::Label::create(context);
             p.percentageLabel2->setFont(AV::Font::familyMono);
 
+            p.mediaLayout = UI::FormLayout::create(context);
+            p.mediaLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+
             p.layout = UI::VerticalLayout::create(context);
             p.layout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::None));
             p.layout->addChild(p.titleLabel);
@@ -107,6 +116,7 @@ namespace djv
             hLayout->addChild(p.percentageLabel);
             hLayout->addChild(p.percentageLabel2);
             vLayout->addChild(hLayout);
+            vLayout->addChild(p.mediaLayout);
             p.layout->addChild(vLayout);
             addChild(p.layout);
 
@@ -174,6 +184,17 @@ namespace djv
                             widget->_widgetUpdate();
                         }
                     });
+
+                p.cacheByteCountsObserver = MapObserver<std::shared_ptr<Media>, size_t>::create(
+                    fileSystem->observeCacheByteCounts(),
+                    [weak](const std::map<std::shared_ptr<Media>, size_t>& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->cacheByteCounts = value;
+                            widget->_widgetUpdate();
+                        }
+                    });
             }
         }
 
@@ -219,6 +240,41 @@ namespace djv
             std::stringstream ss;
             ss << static_cast<int>(p.percentageUsed) << "%";
             p.percentageLabel2->setText(ss.str());
+
+            bool mediaChanged = p.cacheByteCounts.size() != p.mediaLabels.size();
+            for (const auto& i : p.cacheByteCounts)
+            {
+                if (p.mediaLabels.find(i.first) == p.mediaLabels.end())
+                {
+                    mediaChanged = true;
+                    break;
+                }
+            }
+            if (mediaChanged)
+            {
+                p.mediaLayout->clearChildren();
+                p.mediaLabels.clear();
+                if (auto context = getContext().lock())
+                {
+                    for (const auto& i : p.cacheByteCounts)
+                    {
+                        auto label = UI::Label::create(context);
+                        label->setTextHAlign(UI::TextHAlign::Left);
+                        label->setFont(AV::Font::familyMono);
+                        p.mediaLayout->addChild(label);
+                        p.mediaLayout->setText(label, i.first->getFileInfo().getFileName(Frame::invalid, false) + ":");
+                        p.mediaLabels[i.first] = label;
+                    }
+                }
+            }
+            for (const auto& i : p.mediaLabels)
+            {
+                const auto j = p.cacheByteCounts.find(i.first);
+                if (j != p.cacheByteCounts.end())
+                {
+                    i.second->setText(Memory::getSizeLabel(j->second));
+                }
+            }
         }
 
     } // namespace ViewApp
@@ -138,14 +138,14 @@ namespace djv
                         {
                             bool erase = false;
                             {
-                                std::unique_lock<std::mutex> lock((*i)->getMutex());
                                 auto& queue = (*i)->getVideoQueue();
+                                const bool finished = queue.isFinished();
                                 if (!queue.isEmpty())
                                 {
                                     erase = true;
                                     widget->_images.push_back(queue.popFrame().image);
                                 }
-                                else if (queue.isFinished())
+                                else if (finished)
                                 {
                                     erase = true;
                                 }
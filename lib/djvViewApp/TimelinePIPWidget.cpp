@@ -108,8 +108,7 @@ namespace djv
                         {
                             AV::IO::VideoFrame frame;
                             {
-                                std::lock_guard<std::mutex> lock(widget->_p->read->getMutex());
-                                const auto& videoQueue = widget->_p->read->getVideoQueue();
+                                auto& videoQueue = widget->_p->read->getVideoQueue();
                                 if (!videoQueue.isEmpty())
                                 {
                                     frame = videoQueue.getFrame();
@@ -173,7 +173,6 @@ void Application::_init(int argc, char ** argv)
             while (1)
             {
                 {
-                    std::lock_guard<std::mutex> lock(read->getMutex());
                     auto& queue = read->getVideoQueue();
                     if (!queue.isEmpty())
                     {
@@ -0,0 +1,650 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <djvAVTest/CineonTest.h>
+
+#include <djvAV/Cineon.h>
+#include <djvAV/IO.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            // The widths are not multiples of the SIMD widths so that both the
+            // SIMD and the scalar code paths are used for each scanline.
+            const std::vector<uint16_t> widths = { 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33 };
+            const uint16_t height = 2;
+
+            void write32(uint32_t value, Memory::Endian endian, uint8_t* out)
+            {
+                if (endian != Memory::getEndian())
+                {
+                    Memory::endian(&value, 1, 4);
+                }
+                memcpy(out, &value, 4);
+            }
+
+            void write16(uint16_t value, Memory::Endian endian, uint8_t* out)
+            {
+                if (endian != Memory::getEndian())
+                {
+                    Memory::endian(&value, 1, 2);
+                }
+                memcpy(out, &value, 2);
+            }
+
+            uint32_t read32(const uint8_t* in)
+            {
+                uint32_t out = 0;
+                memcpy(&out, in, 4);
+                return out;
+            }
+
+            uint16_t read16(const uint8_t* in)
+            {
+                uint16_t out = 0;
+                memcpy(&out, in, 2);
+                return out;
+            }
+
+            uint32_t read32(const uint8_t* in, Memory::Endian endian)
+            {
+                uint32_t out = read32(in);
+                if (endian != Memory::getEndian())
+                {
+                    Memory::endian(&out, 1, 4);
+                }
+                return out;
+            }
+
+            //! Get the position of a header field in the file.
+            size_t getHeaderPos(const IO::Cineon::Header& header, const void* field)
+            {
+                return reinterpret_cast<const uint8_t*>(field) - reinterpret_cast<const uint8_t*>(&header);
+            }
+
+            //! Write a Cineon file of 10-bit RGB words, with the image data at
+            //! the given offset and the given orientation.
+            void writeFile(
+                const std::string&           fileName,
+                const Image::Size&           size,
+                const std::vector<uint32_t>& words,
+                uint32_t                     imageOffset,
+                IO::Cineon::Orient           orient)
+            {
+                {
+                    IO::Info info;
+                    info.video.push_back(Image::Info(size, Image::Type::RGB_U10));
+                    FileSystem::FileIO io;
+                    io.open(fileName, FileSystem::FileIO::Mode::Write);
+                    IO::Cineon::write(io, info, IO::Cineon::ColorProfile::Raw);
+                    const size_t pos = io.getPos();
+                    std::vector<uint8_t> data(imageOffset - pos + words.size() * 4, 0);
+                    uint8_t* p = data.data() + imageOffset - pos;
+                    for (const auto word : words)
+                    {
+                        write32(word, Memory::Endian::MSB, p);
+                        p += 4;
+                    }
+                    io.write(data.data(), data.size());
+                    IO::Cineon::writeFinish(io);
+                }
+                const IO::Cineon::Header header = {};
+                FileSystem::FileIO io;
+                io.open(fileName, FileSystem::FileIO::Mode::ReadWrite);
+                uint8_t buf[4];
+                write32(imageOffset, Memory::Endian::MSB, buf);
+                io.setPos(getHeaderPos(header, &header.file.imageOffset));
+                io.write(buf, 4);
+                buf[0] = static_cast<uint8_t>(orient);
+                io.setPos(getHeaderPos(header, &header.image.orient));
+                io.write(buf, 1);
+            }
+
+            //! The pixels of the 2x2 images used to test packing, from the top
+            //! left of the image, and the 10-bit RGB words they are packed to.
+            struct PackData
+            {
+                Image::Type                          type;
+                std::vector<std::array<uint16_t, 3> > pixels;
+                std::vector<uint32_t>                 words;
+            };
+
+            const std::vector<PackData> packData =
+            {
+                {
+                    Image::Type::RGB_U8,
+                    { { 255, 0, 128 }, { 1, 64, 254 }, { 0, 0, 0 }, { 255, 255, 255 } },
+                    { 0xffc00808, 0x01101fec, 0x00000000, 0xfffffffc }
+                },
+                {
+                    Image::Type::RGBA_U8,
+                    { { 255, 0, 128 }, { 1, 64, 254 }, { 0, 0, 0 }, { 255, 255, 255 } },
+                    { 0xffc00808, 0x01101fec, 0x00000000, 0xfffffffc }
+                },
+                {
+                    Image::Type::RGB_U16,
+                    { { 65535, 32768, 64 }, { 4660, 65472, 0 }, { 0, 0, 0 }, { 65535, 65535, 65535 } },
+                    { 0xffe00004, 0x123ff000, 0x00000000, 0xfffffffc }
+                },
+                {
+                    Image::Type::RGB_U10,
+                    { { 1023, 512, 1 }, { 72, 1023, 0 }, { 0, 0, 0 }, { 1023, 1023, 1023 } },
+                    { 0xffe00004, 0x123ff000, 0x00000000, 0xfffffffc }
+                }
+            };
+
+            //! Create a 2x2 image from the test pixels, storing them where the
+            //! layout mirroring expects them.
+            std::shared_ptr<Image::Image> createPackImage(const PackData& data, const Image::Layout& layout)
+            {
+                const uint16_t w = 2;
+                const uint16_t h = 2;
+                auto out = Image::Image::create(Image::Info(w, h, data.type, layout));
+                for (uint16_t y = 0; y < h; ++y)
+                {
+                    for (uint16_t x = 0; x < w; ++x)
+                    {
+                        const auto& pixel = data.pixels[y * w + x];
+                        uint8_t* p = out->getData(
+                            layout.mirror.x ? (w - 1 - x) : x,
+                            layout.mirror.y ? (h - 1 - y) : y);
+                        switch (Image::getDataType(data.type))
+                        {
+                        case Image::DataType::U8:
+                            for (size_t c = 0; c < 3; ++c)
+                            {
+                                p[c] = static_cast<uint8_t>(pixel[c]);
+                            }
+                            break;
+                        case Image::DataType::U10:
+                            write32((static_cast<uint32_t>(pixel[0]) << 22) | (pixel[1] << 12) | (pixel[2] << 2), layout.endian, p);
+                            break;
+                        case Image::DataType::U16:
+                            for (size_t c = 0; c < 3; ++c)
+                            {
+                                write16(pixel[c], layout.endian, p + c * 2);
+                            }
+                            break;
+                        default: break;
+                        }
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        CineonTest::CineonTest(const std::shared_ptr<Core::Context>& context) :
+            ITickTest("djv::AVTest::CineonTest", context)
+        {}
+        
+        void CineonTest::run(const std::vector<std::string>& args)
+        {
+            _unpackType();
+            _unpackU10();
+            _unpackU12();
+            _packScanline();
+            _writeImage();
+            _writeImageDirect();
+            _headerTemplate();
+        }
+
+        void CineonTest::_unpackType()
+        {
+            IO::Cineon::Packing packing;
+            DJV_ASSERT(Image::Type::None == IO::Cineon::getUnpackType(Image::Type::RGB_U10, packing, Image::Type::RGBA_U8));
+            packing.bitDepth = 10;
+            DJV_ASSERT(Image::Type::None == IO::Cineon::getUnpackType(Image::Type::RGB_U10, packing, Image::Type::None));
+            DJV_ASSERT(Image::Type::RGBA_U8 == IO::Cineon::getUnpackType(Image::Type::RGB_U10, packing, Image::Type::RGBA_U8));
+            DJV_ASSERT(Image::Type::RGB_U16 == IO::Cineon::getUnpackType(Image::Type::RGB_U10, packing, Image::Type::RGB_U16));
+            packing.methodB = true;
+            DJV_ASSERT(Image::Type::RGB_U10 == IO::Cineon::getUnpackType(Image::Type::RGB_U10, packing, Image::Type::None));
+            packing.bitDepth = 12;
+            DJV_ASSERT(Image::Type::L_U16 == IO::Cineon::getUnpackType(Image::Type::L_U16, packing, Image::Type::None));
+            DJV_ASSERT(Image::Type::RGBA_U8 == IO::Cineon::getUnpackType(Image::Type::RGB_U16, packing, Image::Type::RGBA_U8));
+        }
+
+        void CineonTest::_unpackU10()
+        {
+            std::mt19937 random(1);
+            for (const auto endian : Memory::getEndianEnums())
+            {
+                for (const bool methodB : { false, true })
+                {
+                    for (const auto w : widths)
+                    {
+                        // Pack random samples into 32-bit words.
+                        Image::Info info(w, height, Image::Type::RGB_U10);
+                        info.layout.endian = endian;
+                        auto in = Image::Image::create(info);
+                        std::vector<uint16_t> samples(w * height * 3);
+                        for (uint16_t y = 0; y < height; ++y)
+                        {
+                            uint8_t* p = in->getData(y);
+                            for (uint16_t x = 0; x < w; ++x, p += 4)
+                            {
+                                uint16_t* s = samples.data() + (y * w + x) * 3;
+                                for (size_t c = 0; c < 3; ++c)
+                                {
+                                    s[c] = static_cast<uint16_t>(random() & 0x3ff);
+                                }
+                                const uint32_t value = methodB ?
+                                    ((static_cast<uint32_t>(s[0]) << 20) | (s[1] << 10) | s[2]) :
+                                    ((static_cast<uint32_t>(s[0]) << 22) | (s[1] << 12) | (s[2] << 2));
+                                write32(value, endian, p);
+                            }
+                        }
+                        IO::Cineon::Packing packing;
+                        packing.bitDepth = 10;
+                        packing.methodB = methodB;
+
+                        // Check the SIMD code paths.
+                        auto u10 = IO::Cineon::unpack(in, packing, Image::Type::RGB_U10);
+                        auto rgbaU8 = IO::Cineon::unpack(in, packing, Image::Type::RGBA_U8);
+                        DJV_ASSERT(Memory::getEndian() == u10->getLayout().endian);
+                        for (uint16_t y = 0; y < height; ++y)
+                        {
+                            for (uint16_t x = 0; x < w; ++x)
+                            {
+                                const uint16_t* s = samples.data() + (y * w + x) * 3;
+                                DJV_ASSERT(((static_cast<uint32_t>(s[0]) << 22) | (s[1] << 12) | (s[2] << 2)) == read32(u10->getData(x, y)));
+                                const uint8_t* p = rgbaU8->getData(x, y);
+                                for (size_t c = 0; c < 3; ++c)
+                                {
+                                    DJV_ASSERT((s[c] >> 2) == p[c]);
+                                }
+                                DJV_ASSERT(255 == p[3]);
+                            }
+                        }
+
+                        // Check the look-up table code paths.
+                        auto rgbU8 = IO::Cineon::unpack(in, packing, Image::Type::RGB_U8);
+                        auto rgbU16 = IO::Cineon::unpack(in, packing, Image::Type::RGB_U16);
+                        for (uint16_t y = 0; y < height; ++y)
+                        {
+                            for (uint16_t x = 0; x < w; ++x)
+                            {
+                                const uint16_t* s = samples.data() + (y * w + x) * 3;
+                                for (size_t c = 0; c < 3; ++c)
+                                {
+                                    DJV_ASSERT((s[c] >> 2) == rgbU8->getData(x, y)[c]);
+                                    DJV_ASSERT((s[c] << 6) == read16(rgbU16->getData(x, y) + c * 2));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void CineonTest::_unpackU12()
+        {
+            std::mt19937 random(1);
+            for (const auto endian : Memory::getEndianEnums())
+            {
+                for (const bool methodB : { false, true })
+                {
+                    for (const auto type : { Image::Type::L_U16, Image::Type::RGB_U16 })
+                    {
+                        const uint8_t channelCount = Image::getChannelCount(type);
+                        for (const auto w : widths)
+                        {
+                            // Pack random samples into 16-bit words, with random
+                            // values in the padding bits.
+                            Image::Info info(w, height, type);
+                            info.layout.endian = endian;
+                            auto in = Image::Image::create(info);
+                            std::vector<uint16_t> samples(w * height * channelCount);
+                            for (uint16_t y = 0; y < height; ++y)
+                            {
+                                uint8_t* p = in->getData(y);
+                                for (size_t x = 0; x < w * channelCount; ++x, p += 2)
+                                {
+                                    uint16_t& s = samples[y * w * channelCount + x];
+                                    s = static_cast<uint16_t>(random() & 0xfff);
+                                    const uint16_t padding = static_cast<uint16_t>(random() & 0xf);
+                                    write16(methodB ? (s | (padding << 12)) : ((s << 4) | padding), endian, p);
+                                }
+                            }
+                            IO::Cineon::Packing packing;
+                            packing.bitDepth = 12;
+                            packing.methodB = methodB;
+
+                            // Check the SIMD code path and the look-up table code
+                            // path.
+                            auto u16 = IO::Cineon::unpack(in, packing, type);
+                            auto u8 = IO::Cineon::unpack(in, packing, Image::getIntType(channelCount, 8));
+                            for (uint16_t y = 0; y < height; ++y)
+                            {
+                                for (size_t x = 0; x < w * channelCount; ++x)
+                                {
+                                    const uint16_t s = samples[y * w * channelCount + x];
+                                    DJV_ASSERT((s << 4) == read16(u16->getData(y) + x * 2));
+                                    DJV_ASSERT((s >> 4) == u8->getData(y)[x]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void CineonTest::_packScanline()
+        {
+            for (const auto& data : packData)
+            {
+                for (const auto inEndian : Memory::getEndianEnums())
+                {
+                    for (const bool mirror : { false, true })
+                    {
+                        Image::Layout layout;
+                        layout.mirror.x = mirror;
+                        layout.endian = inEndian;
+                        auto image = createPackImage(data, layout);
+                        for (const auto endian : Memory::getEndianEnums())
+                        {
+                            for (uint16_t y = 0; y < 2; ++y)
+                            {
+                                uint8_t out[8];
+                                IO::Cineon::packScanline(image->getData(y), image->getInfo(), endian, out);
+                                for (uint16_t x = 0; x < 2; ++x)
+                                {
+                                    DJV_ASSERT(data.words[y * 2 + x] == read32(out + x * 4, endian));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void CineonTest::_writeImage()
+        {
+            const std::string fileName = "CineonTest.cin";
+            for (const auto& data : packData)
+            {
+                for (const auto inEndian : Memory::getEndianEnums())
+                {
+                    for (const auto& mirror : { Image::Mirror(false, false), Image::Mirror(true, false), Image::Mirror(false, true), Image::Mirror(true, true) })
+                    {
+                        Image::Layout layout;
+                        layout.mirror = mirror;
+                        layout.endian = inEndian;
+                        auto image = createPackImage(data, layout);
+                        for (const auto endian : Memory::getEndianEnums())
+                        {
+                            {
+                                FileSystem::FileIO io;
+                                io.open(fileName, FileSystem::FileIO::Mode::Write);
+                                IO::Cineon::writeImage(io, *image, endian, false);
+                            }
+                            FileSystem::FileIO io;
+                            io.open(fileName, FileSystem::FileIO::Mode::Read);
+                            DJV_ASSERT(16 == io.getSize());
+                            uint8_t buf[16];
+                            io.read(buf, 16);
+                            for (size_t i = 0; i < 4; ++i)
+                            {
+                                DJV_ASSERT(data.words[i] == read32(buf + i * 4, endian));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void CineonTest::_writeImageDirect()
+        {
+            // The header is not a multiple of the direct I/O alignment, and the
+            // large image does not fit in the packing buffer.
+            std::mt19937 random(1);
+            for (const auto& size : { Image::Size(3, 2), Image::Size(1000, 1100) })
+            {
+                Image::Info imageInfo(size, Image::Type::RGB_U10);
+                imageInfo.layout.mirror.y = true;
+                imageInfo.layout.endian = Memory::Endian::MSB;
+                auto image = Image::Image::create(imageInfo);
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    uint8_t* p = image->getData(y);
+                    for (uint16_t x = 0; x < size.w; ++x, p += 4)
+                    {
+                        write32(random() & 0xfffffffc, Memory::Endian::MSB, p);
+                    }
+                }
+                IO::Info info;
+                info.video.push_back(Image::Info(size, Image::Type::RGB_U10));
+
+                const std::string fileName = "CineonTest.cin";
+                const std::string directFileName = "CineonTestDirect.cin";
+                {
+                    FileSystem::FileIO io;
+                    io.open(fileName, FileSystem::FileIO::Mode::Write);
+                    IO::Cineon::write(io, info, IO::Cineon::ColorProfile::Raw);
+                    IO::Cineon::writeImage(io, *image, Memory::Endian::MSB, false);
+                    IO::Cineon::writeFinish(io);
+                }
+                {
+                    FileSystem::FileIO io;
+                    io.open(directFileName, FileSystem::FileIO::Mode::Write);
+                    IO::Cineon::write(io, info, IO::Cineon::ColorProfile::Raw);
+                    if (!IO::Cineon::writeImageDirect(io, *image, Memory::Endian::MSB))
+                    {
+                        _print("direct I/O is not available");
+                        return;
+                    }
+                    IO::Cineon::writeFinish(io);
+                }
+
+                // The file written with direct I/O should match the buffered
+                // file, including the end of the header that is read back into
+                // the first block and the size after the padding is truncated.
+                const size_t dataByteCount = static_cast<size_t>(size.w) * size.h * 4;
+                std::string contents;
+                {
+                    FileSystem::FileIO io;
+                    io.open(fileName, FileSystem::FileIO::Mode::Read);
+                    contents = FileSystem::FileIO::readContents(io);
+                }
+                auto io = std::make_shared<FileSystem::FileIO>();
+                io->open(directFileName, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT(2048 + dataByteCount == io->getSize());
+                DJV_ASSERT(contents == FileSystem::FileIO::readContents(*io));
+
+                // Read the file back.
+                io->setPos(0);
+                IO::Info readInfo;
+                readInfo.video.resize(1);
+                IO::Cineon::ColorProfile colorProfile = IO::Cineon::ColorProfile::Raw;
+                const auto header = IO::Cineon::read(*io, readInfo, colorProfile);
+                DJV_ASSERT(io->getSize() == header.file.size);
+                DJV_ASSERT(size == readInfo.video[0].info.size);
+                auto image2 = IO::Cineon::Read::readImage(readInfo, io, IO::ReadOptions(), IO::Cineon::getPacking(header));
+                const auto endian2 = image2->getLayout().endian;
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        DJV_ASSERT(
+                            read32(image->getData(x, size.h - 1 - y), Memory::Endian::MSB) ==
+                            read32(image2->getData(x, y), endian2));
+                    }
+                }
+            }
+        }
+
+        void CineonTest::_headerTemplate()
+        {
+            if (auto context = getContext().lock())
+            {
+                std::vector<std::string> warnings;
+                auto warningsObserver = ListObserver<std::string>::create(
+                    context->getSystemT<LogSystem>()->observeWarnings(),
+                    [&warnings](const std::vector<std::string>& value)
+                    {
+                        warnings.insert(warnings.end(), value.begin(), value.end());
+                    });
+                auto io = context->getSystemT<IO::System>();
+
+                // Write sequences where the third frame has a different size,
+                // image data offset, or orientation than the other frames.
+                // Cineon files are always 10-bit method A, so the packing
+                // cannot change.
+                enum class Change
+                {
+                    None,
+                    Size,
+                    Offset,
+                    Orient
+                };
+                std::mt19937 random(1);
+                for (const auto change : { Change::None, Change::Size, Change::Offset, Change::Orient })
+                {
+                    std::stringstream baseNameSS;
+                    baseNameSS << "CineonTestTemplate" << static_cast<int>(change);
+                    const std::string baseName = baseNameSS.str();
+                    const size_t frameCount = 4;
+                    std::vector<std::string> fileNames;
+                    std::vector<Image::Size> sizes;
+                    std::vector<std::vector<uint32_t> > words;
+                    std::vector<std::vector<uint8_t> > keys;
+                    for (size_t i = 0; i < frameCount; ++i)
+                    {
+                        std::stringstream fileNameSS;
+                        fileNameSS << baseName << "." << (i + 1) << ".cin";
+                        fileNames.push_back(fileNameSS.str());
+                        const bool changed = 2 == i;
+                        sizes.push_back(changed && Change::Size == change ? Image::Size(5, 3) : Image::Size(4, 3));
+                        words.push_back(std::vector<uint32_t>(sizes[i].w * sizes[i].h));
+                        for (auto& word : words[i])
+                        {
+                            word = random() & 0xfffffffc;
+                        }
+                        writeFile(
+                            fileNames[i],
+                            sizes[i],
+                            words[i],
+                            changed && Change::Offset == change ? 4096 : 2048,
+                            changed && Change::Orient == change ?
+                                IO::Cineon::Orient::LeftRightBottomTop :
+                                IO::Cineon::Orient::LeftRightTopBottom);
+
+                        FileSystem::FileIO fileIO;
+                        fileIO.open(fileNames[i], FileSystem::FileIO::Mode::Read);
+                        keys.push_back(IO::Cineon::getTemplateKey(fileIO, IO::Cineon::readHeader(fileIO)));
+                    }
+
+                    // Only the changed frame should have a different template
+                    // key, so the identical frames reuse the template.
+                    DJV_ASSERT(keys[0] == keys[1]);
+                    DJV_ASSERT(keys[0] == keys[3]);
+                    DJV_ASSERT((Change::None == change) == (keys[0] == keys[2]));
+
+                    // Read the sequence and check that each frame is read with
+                    // its own size, offset, and orientation.
+                    warnings.clear();
+                    std::vector<std::shared_ptr<Image::Image> > images;
+                    {
+                        std::stringstream sequenceSS;
+                        sequenceSS << baseName << ".1-" << frameCount << ".cin";
+                        auto read = io->read(FileSystem::FileInfo(FileSystem::Path(sequenceSS.str()), FileSystem::FileType::Sequence, false));
+                        bool running = true;
+                        while (running)
+                        {
+                            bool sleep = false;
+                            {
+                                auto& queue = read->getVideoQueue();
+                                const bool finished = queue.isFinished();
+                                if (!queue.isEmpty())
+                                {
+                                    images.push_back(queue.popFrame().image);
+                                }
+                                else if (finished)
+                                {
+                                    running = false;
+                                }
+                                else
+                                {
+                                    sleep = true;
+                                }
+                            }
+                            if (sleep)
+                            {
+                                std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                            }
+                        }
+                    }
+                    DJV_ASSERT(frameCount == images.size());
+                    for (size_t i = 0; i < frameCount; ++i)
+                    {
+                        const auto& image = images[i];
+                        DJV_ASSERT(image);
+                        DJV_ASSERT(sizes[i] == image->getSize());
+                        DJV_ASSERT((2 == i && Change::Orient == change) == image->getLayout().mirror.y);
+                        for (uint16_t y = 0; y < sizes[i].h; ++y)
+                        {
+                            for (uint16_t x = 0; x < sizes[i].w; ++x)
+                            {
+                                DJV_ASSERT(words[i][y * sizes[i].w + x] == read32(image->getData(x, y), image->getLayout().endian));
+                            }
+                        }
+                    }
+
+                    // A warning should be logged for the frame that has a
+                    // different format.
+                    _tickFor(std::chrono::milliseconds(500));
+                    bool warning = false;
+                    for (const auto& i : warnings)
+                    {
+                        warning |= i.find(fileNames[2]) != std::string::npos;
+                    }
+                    DJV_ASSERT((Change::Size == change || Change::Orient == change) == warning);
+                }
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
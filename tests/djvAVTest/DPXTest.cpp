@@ -0,0 +1,337 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <djvAVTest/DPXTest.h>
+
+#include <djvAV/DPX.h>
+#include <djvAV/IO.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
+
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            void write32(uint32_t value, Memory::Endian endian, uint8_t* out)
+            {
+                if (endian != Memory::getEndian())
+                {
+                    Memory::endian(&value, 1, 4);
+                }
+                memcpy(out, &value, 4);
+            }
+
+            uint32_t read32(const uint8_t* in, Memory::Endian endian)
+            {
+                uint32_t out = 0;
+                memcpy(&out, in, 4);
+                if (endian != Memory::getEndian())
+                {
+                    Memory::endian(&out, 1, 4);
+                }
+                return out;
+            }
+
+            void write16(uint16_t value, Memory::Endian endian, uint8_t* out)
+            {
+                if (endian != Memory::getEndian())
+                {
+                    Memory::endian(&value, 1, 2);
+                }
+                memcpy(out, &value, 2);
+            }
+
+            //! Get the position of a header field in the file.
+            size_t getHeaderPos(const IO::DPX::Header& header, const void* field)
+            {
+                return reinterpret_cast<const uint8_t*>(field) - reinterpret_cast<const uint8_t*>(&header);
+            }
+
+            //! Write an MSB DPX file of 10-bit RGB words, with the image data
+            //! at the given offset and packed with method A or B.
+            void writeFile(
+                const std::string&           fileName,
+                const Image::Size&           size,
+                const std::vector<uint32_t>& words,
+                uint32_t                     imageOffset,
+                IO::DPX::Components          packing)
+            {
+                {
+                    IO::Info info;
+                    info.video.push_back(Image::Info(size, Image::Type::RGB_U10));
+                    FileSystem::FileIO io;
+                    io.open(fileName, FileSystem::FileIO::Mode::Write);
+                    IO::DPX::write(io, info, IO::DPX::Version::_2_0, IO::DPX::Endian::MSB, IO::Cineon::ColorProfile::Raw);
+                    const size_t pos = io.getPos();
+                    std::vector<uint8_t> data(imageOffset - pos + words.size() * 4, 0);
+                    uint8_t* p = data.data() + imageOffset - pos;
+                    for (const auto word : words)
+                    {
+                        write32(IO::DPX::Components::TypeB == packing ? (word >> 2) : word, Memory::Endian::MSB, p);
+                        p += 4;
+                    }
+                    io.write(data.data(), data.size());
+                    IO::DPX::writeFinish(io);
+                }
+                const IO::DPX::Header header = {};
+                FileSystem::FileIO io;
+                io.open(fileName, FileSystem::FileIO::Mode::ReadWrite);
+                uint8_t buf[4];
+                write32(imageOffset, Memory::Endian::MSB, buf);
+                io.setPos(getHeaderPos(header, &header.file.imageOffset));
+                io.write(buf, 4);
+                write16(static_cast<uint16_t>(packing), Memory::Endian::MSB, buf);
+                io.setPos(getHeaderPos(header, &header.image.elem[0].packing));
+                io.write(buf, 2);
+            }
+
+        } // namespace
+
+        DPXTest::DPXTest(const std::shared_ptr<Core::Context>& context) :
+            ITickTest("djv::AVTest::DPXTest", context)
+        {}
+        
+        void DPXTest::run(const std::vector<std::string>& args)
+        {
+            _writeImage();
+            _headerTemplate();
+        }
+
+        void DPXTest::_writeImage()
+        {
+            std::mt19937 random(1);
+            const Image::Size size(5, 3);
+            const std::string fileName = "DPXTest.dpx";
+            for (const auto endian : { IO::DPX::Endian::MSB, IO::DPX::Endian::LSB })
+            {
+                const Memory::Endian fileEndian = IO::DPX::Endian::MSB == endian ? Memory::Endian::MSB : Memory::Endian::LSB;
+                for (const auto inEndian : Memory::getEndianEnums())
+                {
+                    for (const bool directIO : { false, true })
+                    {
+                        // Create a mirrored image, keeping the words from the top
+                        // left of the image.
+                        Image::Info imageInfo(size, Image::Type::RGB_U10);
+                        imageInfo.layout.mirror = Image::Mirror(true, true);
+                        imageInfo.layout.endian = inEndian;
+                        auto image = Image::Image::create(imageInfo);
+                        std::vector<uint32_t> words(size.w * size.h);
+                        for (uint16_t y = 0; y < size.h; ++y)
+                        {
+                            for (uint16_t x = 0; x < size.w; ++x)
+                            {
+                                uint32_t& word = words[y * size.w + x];
+                                word = random() & 0xfffffffc;
+                                write32(word, inEndian, image->getData(size.w - 1 - x, size.h - 1 - y));
+                            }
+                        }
+
+                        {
+                            IO::Info info;
+                            info.video.push_back(Image::Info(size, Image::Type::RGB_U10));
+                            FileSystem::FileIO io;
+                            io.open(fileName, FileSystem::FileIO::Mode::Write);
+                            IO::DPX::write(io, info, IO::DPX::Version::_2_0, endian, IO::Cineon::ColorProfile::Raw);
+                            if (!directIO)
+                            {
+                                IO::Cineon::writeImage(io, *image, fileEndian, false);
+                            }
+                            else if (!IO::Cineon::writeImageDirect(io, *image, fileEndian))
+                            {
+                                _print("direct I/O is not available");
+                                continue;
+                            }
+                            IO::DPX::writeFinish(io);
+                        }
+
+                        // Read the file back, the image data should be stored
+                        // in the endian of the header.
+                        auto io = std::make_shared<FileSystem::FileIO>();
+                        io->open(fileName, FileSystem::FileIO::Mode::Read);
+                        DJV_ASSERT(2048 + words.size() * 4 == io->getSize());
+                        IO::Info info;
+                        info.video.resize(1);
+                        IO::Cineon::ColorProfile colorProfile = IO::Cineon::ColorProfile::Raw;
+                        const auto header = IO::DPX::read(*io, info, colorProfile);
+                        DJV_ASSERT(io->getSize() == header.file.size);
+                        DJV_ASSERT(size == info.video[0].info.size);
+                        DJV_ASSERT(fileEndian == info.video[0].info.layout.endian);
+                        auto image2 = IO::Cineon::Read::readImage(info, io, IO::ReadOptions(), IO::DPX::getPacking(header));
+                        for (uint16_t y = 0; y < size.h; ++y)
+                        {
+                            for (uint16_t x = 0; x < size.w; ++x)
+                            {
+                                DJV_ASSERT(words[y * size.w + x] == read32(image2->getData(x, y), image2->getLayout().endian));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void DPXTest::_headerTemplate()
+        {
+            if (auto context = getContext().lock())
+            {
+                std::vector<std::string> warnings;
+                auto warningsObserver = ListObserver<std::string>::create(
+                    context->getSystemT<LogSystem>()->observeWarnings(),
+                    [&warnings](const std::vector<std::string>& value)
+                    {
+                        warnings.insert(warnings.end(), value.begin(), value.end());
+                    });
+                auto io = context->getSystemT<IO::System>();
+
+                // Write sequences where the third frame has a different size,
+                // image data offset, or packing than the other frames.
+                enum class Change
+                {
+                    None,
+                    Size,
+                    Offset,
+                    Packing
+                };
+                std::mt19937 random(1);
+                for (const auto change : { Change::None, Change::Size, Change::Offset, Change::Packing })
+                {
+                    std::stringstream baseNameSS;
+                    baseNameSS << "DPXTestTemplate" << static_cast<int>(change);
+                    const std::string baseName = baseNameSS.str();
+                    const size_t frameCount = 4;
+                    std::vector<std::string> fileNames;
+                    std::vector<Image::Size> sizes;
+                    std::vector<std::vector<uint32_t> > words;
+                    std::vector<std::vector<uint8_t> > keys;
+                    for (size_t i = 0; i < frameCount; ++i)
+                    {
+                        std::stringstream fileNameSS;
+                        fileNameSS << baseName << "." << (i + 1) << ".dpx";
+                        fileNames.push_back(fileNameSS.str());
+                        const bool changed = 2 == i;
+                        sizes.push_back(changed && Change::Size == change ? Image::Size(5, 3) : Image::Size(4, 3));
+                        words.push_back(std::vector<uint32_t>(sizes[i].w * sizes[i].h));
+                        for (auto& word : words[i])
+                        {
+                            word = random() & 0xfffffffc;
+                        }
+                        writeFile(
+                            fileNames[i],
+                            sizes[i],
+                            words[i],
+                            changed && Change::Offset == change ? 4096 : 2048,
+                            changed && Change::Packing == change ? IO::DPX::Components::TypeB : IO::DPX::Components::TypeA);
+
+                        FileSystem::FileIO fileIO;
+                        fileIO.open(fileNames[i], FileSystem::FileIO::Mode::Read);
+                        keys.push_back(IO::DPX::getTemplateKey(fileIO, IO::DPX::readHeader(fileIO)));
+                    }
+
+                    // Only the changed frame should have a different template
+                    // key, so the identical frames reuse the template.
+                    DJV_ASSERT(keys[0] == keys[1]);
+                    DJV_ASSERT(keys[0] == keys[3]);
+                    DJV_ASSERT((Change::None == change) == (keys[0] == keys[2]));
+
+                    // Read the sequence and check that each frame is read with
+                    // its own size, offset, and packing.
+                    warnings.clear();
+                    std::vector<std::shared_ptr<Image::Image> > images;
+                    {
+                        std::stringstream sequenceSS;
+                        sequenceSS << baseName << ".1-" << frameCount << ".dpx";
+                        auto read = io->read(FileSystem::FileInfo(FileSystem::Path(sequenceSS.str()), FileSystem::FileType::Sequence, false));
+                        bool running = true;
+                        while (running)
+                        {
+                            bool sleep = false;
+                            {
+                                auto& queue = read->getVideoQueue();
+                                const bool finished = queue.isFinished();
+                                if (!queue.isEmpty())
+                                {
+                                    images.push_back(queue.popFrame().image);
+                                }
+                                else if (finished)
+                                {
+                                    running = false;
+                                }
+                                else
+                                {
+                                    sleep = true;
+                                }
+                            }
+                            if (sleep)
+                            {
+                                std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                            }
+                        }
+                    }
+                    DJV_ASSERT(frameCount == images.size());
+                    for (size_t i = 0; i < frameCount; ++i)
+                    {
+                        const auto& image = images[i];
+                        DJV_ASSERT(image);
+                        DJV_ASSERT(sizes[i] == image->getSize());
+                        for (uint16_t y = 0; y < sizes[i].h; ++y)
+                        {
+                            for (uint16_t x = 0; x < sizes[i].w; ++x)
+                            {
+                                DJV_ASSERT(words[i][y * sizes[i].w + x] == read32(image->getData(x, y), image->getLayout().endian));
+                            }
+                        }
+                    }
+
+                    // A warning should be logged for the frame that has a
+                    // different format.
+                    _tickFor(std::chrono::milliseconds(500));
+                    bool warning = false;
+                    for (const auto& i : warnings)
+                    {
+                        warning |= i.find(fileNames[2]) != std::string::npos;
+                    }
+                    DJV_ASSERT((Change::Size == change) == warning);
+                }
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
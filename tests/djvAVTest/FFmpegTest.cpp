@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <djvAVTest/FFmpegTest.h>
+
+#include <djvAV/FFmpeg.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        FFmpegTest::FFmpegTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::FFmpegTest", context)
+        {}
+        
+        void FFmpegTest::run(const std::vector<std::string>& args)
+        {
+            _enum();
+            _threadType();
+            _decodeStats();
+            _serialize();
+        }
+
+        void FFmpegTest::_enum()
+        {
+            for (auto i : IO::FFmpeg::getThreadTypeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("thread type string: " + ss.str());
+                IO::FFmpeg::ThreadType value = IO::FFmpeg::ThreadType::Count;
+                ss >> value;
+                DJV_ASSERT(i == value);
+            }
+        }
+
+        void FFmpegTest::_threadType()
+        {
+            {
+                for (auto i : IO::FFmpeg::getThreadTypeEnums())
+                {
+                    DJV_ASSERT(0 == IO::FFmpeg::getThreadTypeFlags(i, nullptr));
+                }
+            }
+
+            {
+                AVCodec codec = {};
+                codec.capabilities = AV_CODEC_CAP_FRAME_THREADS | AV_CODEC_CAP_SLICE_THREADS;
+                DJV_ASSERT(0 == IO::FFmpeg::getThreadTypeFlags(IO::FFmpeg::ThreadType::None, &codec));
+                DJV_ASSERT(FF_THREAD_FRAME == IO::FFmpeg::getThreadTypeFlags(IO::FFmpeg::ThreadType::Auto, &codec));
+                DJV_ASSERT(FF_THREAD_FRAME == IO::FFmpeg::getThreadTypeFlags(IO::FFmpeg::ThreadType::Frame, &codec));
+                DJV_ASSERT(FF_THREAD_SLICE == IO::FFmpeg::getThreadTypeFlags(IO::FFmpeg::ThreadType::Slice, &codec));
+            }
+
+            {
+                AVCodec codec = {};
+                codec.capabilities = AV_CODEC_CAP_SLICE_THREADS;
+                DJV_ASSERT(FF_THREAD_SLICE == IO::FFmpeg::getThreadTypeFlags(IO::FFmpeg::ThreadType::Auto, &codec));
+                DJV_ASSERT(0 == IO::FFmpeg::getThreadTypeFlags(IO::FFmpeg::ThreadType::Frame, &codec));
+                DJV_ASSERT(FF_THREAD_SLICE == IO::FFmpeg::getThreadTypeFlags(IO::FFmpeg::ThreadType::Slice, &codec));
+            }
+
+            {
+                AVCodec codec = {};
+                for (auto i : IO::FFmpeg::getThreadTypeEnums())
+                {
+                    DJV_ASSERT(0 == IO::FFmpeg::getThreadTypeFlags(i, &codec));
+                }
+            }
+
+            {
+                DJV_ASSERT(IO::FFmpeg::ThreadType::None == IO::FFmpeg::getThreadType(0));
+                DJV_ASSERT(IO::FFmpeg::ThreadType::Frame == IO::FFmpeg::getThreadType(FF_THREAD_FRAME));
+                DJV_ASSERT(IO::FFmpeg::ThreadType::Slice == IO::FFmpeg::getThreadType(FF_THREAD_SLICE));
+                DJV_ASSERT(IO::FFmpeg::ThreadType::Frame == IO::FFmpeg::getThreadType(FF_THREAD_FRAME | FF_THREAD_SLICE));
+            }
+        }
+
+        void FFmpegTest::_decodeStats()
+        {
+            {
+                const IO::FFmpeg::DecodeStats stats;
+                DJV_ASSERT(IO::FFmpeg::ThreadType::None == stats.threadType);
+                DJV_ASSERT(0.F == stats.getFramesPerSecond());
+                DJV_ASSERT(0.F == stats.getSeekLatency());
+            }
+
+            {
+                IO::FFmpeg::DecodeStats stats;
+                stats.frameCount = 10;
+                stats.decodeTime = 2.0;
+                stats.seekCount = 4;
+                stats.seekTime = 1.0;
+                DJV_ASSERT(5.F == stats.getFramesPerSecond());
+                DJV_ASSERT(.25F == stats.getSeekLatency());
+            }
+        }
+
+        void FFmpegTest::_serialize()
+        {
+            for (auto i : IO::FFmpeg::getThreadTypeEnums())
+            {
+                IO::FFmpeg::Options options;
+                options.threadType = i;
+                options.threadCount = 2;
+                auto json = toJSON(options);
+                IO::FFmpeg::Options options2;
+                fromJSON(json, options2);
+                DJV_ASSERT(options.threadType == options2.threadType);
+                DJV_ASSERT(options.threadCount == options2.threadCount);
+            }
+
+            try
+            {
+                auto json = picojson::value(picojson::string_type, true);
+                IO::FFmpeg::Options options;
+                fromJSON(json, options);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/IOCacheManagerTest.h>
+
+#include <djvAV/IOCacheManager.h>
+#include <djvAV/ImageCompressedData.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            IO::CacheWindow getWindow(Frame::Index first, size_t count, IO::Direction direction)
+            {
+                IO::CacheWindow out;
+                out.spans.push_back(IO::CacheSpan(first, count, direction));
+                return out;
+            }
+
+        } // namespace
+
+        IOCacheManagerTest::IOCacheManagerTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::IOCacheManagerTest", context)
+        {}
+        
+        void IOCacheManagerTest::run(const std::vector<std::string>& args)
+        {
+            const Image::Info info(16, 16, Image::Type::RGB_U8);
+            const size_t byteCount = Image::Image::create(info)->getDataByteCount();
+            
+            {
+                auto cacheManager = IO::CacheManager::create();
+                DJV_ASSERT(0 == cacheManager->getMaxByteCount());
+                DJV_ASSERT(0 == cacheManager->getByteCount());
+                const UID client = cacheManager->addClient();
+                cacheManager->setWindow(client, getWindow(0, 10, IO::Direction::Forward));
+                DJV_ASSERT(!cacheManager->add(client, 0, Image::Image::create(info)));
+                DJV_ASSERT(0 == cacheManager->getCount(client));
+                DJV_ASSERT(0 == cacheManager->getAvailableByteCount(client));
+            }
+            
+            {
+                auto cacheManager = IO::CacheManager::create();
+                cacheManager->setMaxByteCount(byteCount * 4);
+                DJV_ASSERT(byteCount * 4 == cacheManager->getMaxByteCount());
+
+                const UID client = cacheManager->addClient();
+                cacheManager->setWindow(client, getWindow(0, 10, IO::Direction::Forward));
+                DJV_ASSERT(!cacheManager->add(client, 10, Image::Image::create(info)));
+                for (Frame::Index i = 0; i < 4; ++i)
+                {
+                    DJV_ASSERT(cacheManager->add(client, i, Image::Image::create(info)));
+                }
+                DJV_ASSERT(!cacheManager->add(client, 4, Image::Image::create(info)));
+                DJV_ASSERT(4 == cacheManager->getCount(client));
+                DJV_ASSERT(byteCount * 4 == cacheManager->getByteCount(client));
+                DJV_ASSERT(byteCount * 4 == cacheManager->getByteCount());
+                DJV_ASSERT(0 == cacheManager->getAvailableByteCount(client));
+                DJV_ASSERT(Frame::Sequence(Frame::Range(0, 3)) == cacheManager->getFrames(client));
+                std::shared_ptr<Image::Image> image;
+                DJV_ASSERT(cacheManager->get(client, 0, image));
+                DJV_ASSERT(image);
+
+                // The second client is the most recently used, so it takes
+                // memory from the first client starting with the least
+                // important frames.
+                const UID client2 = cacheManager->addClient();
+                cacheManager->setWindow(client2, getWindow(0, 10, IO::Direction::Forward));
+                DJV_ASSERT(byteCount * 4 == cacheManager->getAvailableByteCount(client2));
+                DJV_ASSERT(cacheManager->add(client2, 0, Image::Image::create(info)));
+                DJV_ASSERT(cacheManager->add(client2, 1, Image::Image::create(info)));
+                DJV_ASSERT(2 == cacheManager->getCount(client));
+                DJV_ASSERT(cacheManager->contains(client, 1));
+                DJV_ASSERT(!cacheManager->contains(client, 3));
+                DJV_ASSERT(byteCount * 4 == cacheManager->getByteCount());
+
+                cacheManager->touch(client);
+                DJV_ASSERT(byteCount * 2 == cacheManager->getAvailableByteCount(client));
+                DJV_ASSERT(0 == cacheManager->getAvailableByteCount(client2));
+                DJV_ASSERT(cacheManager->add(client, 2, Image::Image::create(info)));
+                DJV_ASSERT(1 == cacheManager->getCount(client2));
+
+                cacheManager->setWindow(client, getWindow(5, 5, IO::Direction::Forward));
+                DJV_ASSERT(0 == cacheManager->getCount(client));
+                DJV_ASSERT(0 == cacheManager->getByteCount(client));
+
+                cacheManager->setMaxByteCount(0);
+                DJV_ASSERT(0 == cacheManager->getByteCount());
+
+                cacheManager->removeClient(client);
+                cacheManager->removeClient(client2);
+                DJV_ASSERT(0 == cacheManager->getCount(client));
+            }
+            
+            {
+                auto cacheManager = IO::CacheManager::create();
+                cacheManager->setMaxByteCount(byteCount * 2);
+                const UID client = cacheManager->addClient();
+                cacheManager->setWindow(client, getWindow(9, 10, IO::Direction::Reverse));
+                DJV_ASSERT(cacheManager->add(client, 9, Image::Image::create(info)));
+                DJV_ASSERT(cacheManager->add(client, 7, Image::Image::create(info)));
+                DJV_ASSERT(cacheManager->add(client, 8, Image::Image::create(info)));
+                DJV_ASSERT(!cacheManager->add(client, 0, Image::Image::create(info)));
+                DJV_ASSERT(Frame::Sequence(Frame::Range(8, 9)) == cacheManager->getFrames(client));
+                cacheManager->clear(client);
+                DJV_ASSERT(0 == cacheManager->getCount(client));
+                DJV_ASSERT(0 == cacheManager->getByteCount());
+            }
+
+            {
+                // Compressed frames use their compressed size.
+                auto cacheManager = IO::CacheManager::create();
+                cacheManager->setMaxByteCount(byteCount);
+                const UID client = cacheManager->addClient();
+                cacheManager->setWindow(client, getWindow(0, 10, IO::Direction::Forward));
+                auto image = Image::Image::create(info);
+                image->zero();
+                auto compressed = Image::CompressedData::create(*image);
+                DJV_ASSERT(cacheManager->add(client, 0, compressed));
+                DJV_ASSERT(cacheManager->add(client, 1, compressed));
+                DJV_ASSERT(compressed->getCompressedByteCount() * 2 == cacheManager->getByteCount());
+                std::shared_ptr<Image::CompressedData> compressed2;
+                DJV_ASSERT(cacheManager->getCompressed(client, 0, compressed2));
+                DJV_ASSERT(compressed == compressed2);
+                std::shared_ptr<Image::Image> image2;
+                DJV_ASSERT(cacheManager->get(client, 0, image2));
+                DJV_ASSERT(*image2 == *image);
+
+                DJV_ASSERT(cacheManager->add(client, 0, Image::Image::create(info)));
+                DJV_ASSERT(!cacheManager->getCompressed(client, 0, compressed2));
+                DJV_ASSERT(byteCount == cacheManager->getByteCount());
+            }
+
+            {
+                // A frame that cannot be replaced stays in the cache.
+                auto cacheManager = IO::CacheManager::create();
+                cacheManager->setMaxByteCount(byteCount);
+                const UID client = cacheManager->addClient();
+                cacheManager->setWindow(client, getWindow(0, 10, IO::Direction::Forward));
+                auto image = Image::Image::create(info);
+                DJV_ASSERT(cacheManager->add(client, 0, image));
+                DJV_ASSERT(!cacheManager->add(client, 0, Image::Image::create(Image::Info(32, 32, Image::Type::RGB_U8))));
+                std::shared_ptr<Image::Image> image2;
+                DJV_ASSERT(cacheManager->get(client, 0, image2));
+                DJV_ASSERT(image == image2);
+                DJV_ASSERT(byteCount == cacheManager->getByteCount());
+                DJV_ASSERT(cacheManager->add(client, 0, Image::Image::create(info)));
+                DJV_ASSERT(1 == cacheManager->getCount(client));
+                DJV_ASSERT(byteCount == cacheManager->getByteCount());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/IOCachePolicyTest.h>
+
+#include <djvAV/IOCachePolicy.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        IOCachePolicyTest::IOCachePolicyTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::IOCachePolicyTest", context)
+        {}
+        
+        void IOCachePolicyTest::run(const std::vector<std::string>& args)
+        {
+            auto policy = IO::CachePolicy::create();
+            policy->setReadBehind(.5F);
+            DJV_ASSERT(.5F == policy->getReadBehind());
+
+            {
+                IO::CacheState state;
+                DJV_ASSERT(policy->getWindow(state).spans.empty());
+                state.sequenceSize = 100;
+                DJV_ASSERT(policy->getWindow(state).spans.empty());
+            }
+
+            {
+                // When playback is stopped the window is centered on the
+                // current frame.
+                IO::CacheState state;
+                state.max = 10;
+                state.sequenceSize = 100;
+                state.currentFrame = 50;
+                const auto window = policy->getWindow(state);
+                DJV_ASSERT(2 == window.spans.size());
+                DJV_ASSERT(IO::CacheSpan(50, 5, IO::Direction::Forward) == window.spans[0]);
+                DJV_ASSERT(IO::CacheSpan(49, 5, IO::Direction::Reverse, true) == window.spans[1]);
+                DJV_ASSERT(10 == window.getSize());
+                DJV_ASSERT(Frame::Sequence(Frame::Range(45, 54)) == window.getSequence());
+                size_t position = 0;
+                DJV_ASSERT(window.getPosition(52, position));
+                DJV_ASSERT(2 == position);
+                DJV_ASSERT(window.getPosition(48, position));
+                DJV_ASSERT(6 == position);
+                DJV_ASSERT(!window.contains(55));
+            }
+
+            {
+                // Loop playback wraps around to the start of the sequence.
+                IO::CacheState state;
+                state.max = 20;
+                state.sequenceSize = 100;
+                state.currentFrame = 95;
+                state.playback = true;
+                state.playbackSpeed = Time::Speed(24);
+                const auto window = policy->getWindow(state);
+                DJV_ASSERT(3 == window.spans.size());
+                DJV_ASSERT(IO::CacheSpan(95, 5, IO::Direction::Forward) == window.spans[0]);
+                DJV_ASSERT(IO::CacheSpan(0, 5, IO::Direction::Forward) == window.spans[1]);
+                DJV_ASSERT(IO::CacheSpan(94, 10, IO::Direction::Reverse, true) == window.spans[2]);
+                DJV_ASSERT(20 == window.getSize());
+                size_t position = 0;
+                DJV_ASSERT(window.getPosition(1, position));
+                DJV_ASSERT(6 == position);
+
+                state.direction = IO::Direction::Reverse;
+                state.currentFrame = 2;
+                const auto window2 = policy->getWindow(state);
+                DJV_ASSERT(3 == window2.spans.size());
+                DJV_ASSERT(IO::CacheSpan(2, 3, IO::Direction::Reverse) == window2.spans[0]);
+                DJV_ASSERT(IO::CacheSpan(99, 7, IO::Direction::Reverse) == window2.spans[1]);
+                DJV_ASSERT(IO::CacheSpan(3, 10, IO::Direction::Forward, true) == window2.spans[2]);
+            }
+
+            {
+                // Ping-pong playback turns around at the end of the sequence.
+                IO::CacheState state;
+                state.max = 20;
+                state.sequenceSize = 100;
+                state.currentFrame = 95;
+                state.playback = true;
+                state.playbackSpeed = Time::Speed(24);
+                state.playbackMode = IO::PlaybackMode::PingPong;
+                const auto window = policy->getWindow(state);
+                DJV_ASSERT(2 == window.spans.size());
+                DJV_ASSERT(IO::CacheSpan(95, 5, IO::Direction::Forward) == window.spans[0]);
+                DJV_ASSERT(IO::CacheSpan(94, 15, IO::Direction::Reverse) == window.spans[1]);
+
+                // Playing once keeps the remaining frames for scrubbing.
+                state.playbackMode = IO::PlaybackMode::Once;
+                const auto window2 = policy->getWindow(state);
+                DJV_ASSERT(2 == window2.spans.size());
+                DJV_ASSERT(IO::CacheSpan(95, 5, IO::Direction::Forward) == window2.spans[0]);
+                DJV_ASSERT(IO::CacheSpan(94, 15, IO::Direction::Reverse, true) == window2.spans[1]);
+            }
+
+            {
+                // The window is limited to the in/out points.
+                IO::CacheState state;
+                state.max = 100;
+                state.sequenceSize = 100;
+                state.inOutPoints = IO::InOutPoints(true, 10, 19);
+                state.currentFrame = 15;
+                const auto window = policy->getWindow(state);
+                DJV_ASSERT(Frame::Sequence(Frame::Range(10, 19)) == window.getSequence());
+            }
+
+            {
+                // The amount of time kept behind the current frame is scaled
+                // by the playback speed.
+                IO::CacheState state;
+                state.max = 100;
+                state.sequenceSize = 1000;
+                state.currentFrame = 500;
+                state.playback = true;
+                state.playbackSpeed = Time::Speed(48);
+                const auto window = policy->getWindow(state);
+                DJV_ASSERT(2 == window.spans.size());
+                DJV_ASSERT(IO::CacheSpan(500, 76, IO::Direction::Forward) == window.spans[0]);
+                DJV_ASSERT(IO::CacheSpan(499, 24, IO::Direction::Reverse, true) == window.spans[1]);
+
+                policy->setReadBehind(0.F);
+                const auto window2 = policy->getWindow(state);
+                DJV_ASSERT(1 == window2.spans.size());
+                DJV_ASSERT(IO::CacheSpan(500, 100, IO::Direction::Forward) == window2.spans[0]);
+                policy->setReadBehind(.5F);
+            }
+
+            {
+                IO::Cache cache;
+                DJV_ASSERT(cache.getPolicy());
+                cache.setMax(40);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(50);
+                DJV_ASSERT(Frame::Sequence(Frame::Range(30, 69)) == cache.getSequence());
+                cache.setPlayback(true);
+                cache.setPlaybackSpeed(Time::Speed(24));
+                DJV_ASSERT(Frame::Sequence(Frame::Range(38, 77)) == cache.getSequence());
+                DJV_ASSERT(2 == cache.getWindow().spans.size());
+                cache.setPolicy(policy);
+                DJV_ASSERT(policy == cache.getPolicy());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/IODiskCacheTest.h>
+
+#include <djvAV/IOCacheManager.h>
+#include <djvAV/IODiskCache.h>
+
+#include <djvCore/FileInfo.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        IODiskCacheTest::IODiskCacheTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::IODiskCacheTest", context)
+        {}
+        
+        void IODiskCacheTest::run(const std::vector<std::string>& args)
+        {
+            const std::string path = "IODiskCacheTest";
+            Image::Info info(16, 16, Image::Type::RGB_U8);
+            info.name = "Layer";
+            info.pixelAspectRatio = 2.F;
+            info.layout.mirror.y = true;
+            const size_t byteCount = info.getDataByteCount();
+
+            {
+                const IO::DiskCacheKey key("image.0001.dpx", 1, 0, 1);
+                DJV_ASSERT(key == IO::DiskCacheKey("image.0001.dpx", 1, 0, 1));
+                DJV_ASSERT(key < IO::DiskCacheKey("image.0001.dpx", 2, 0, 1));
+                DJV_ASSERT(key < IO::DiskCacheKey("image.0001.dpx", 1, 1, 1));
+                DJV_ASSERT(key < IO::DiskCacheKey("image.0002.dpx", 1, 0, 1));
+            }
+
+            {
+                auto diskCache = IO::DiskCache::create(path, byteCount * 2);
+                DJV_ASSERT(path == diskCache->getPath());
+                DJV_ASSERT(byteCount * 2 == diskCache->getMaxByteCount());
+                DJV_ASSERT(0 == diskCache->getByteCount());
+                DJV_ASSERT(0 == diskCache->getCount());
+
+                auto image = Image::Image::create(info);
+                for (size_t i = 0; i < byteCount; ++i)
+                {
+                    image->getData()[i] = static_cast<uint8_t>(i);
+                }
+                image->setPluginName("DPX");
+                Tags tags;
+                tags.setTag("Key", "Value");
+                image->setTags(tags);
+
+                const IO::DiskCacheKey key("image.0001.dpx", 1, 0, 1);
+                DJV_ASSERT(!diskCache->get(key));
+                diskCache->add(key, image);
+                diskCache->flush();
+                DJV_ASSERT(diskCache->contains(key));
+                DJV_ASSERT(1 == diskCache->getCount());
+                DJV_ASSERT(byteCount == diskCache->getByteCount());
+
+                // The frame is read back from the memory-mapped file.
+                auto image2 = diskCache->get(key);
+                DJV_ASSERT(image2);
+                DJV_ASSERT(image2->getInfo() == info);
+                DJV_ASSERT(image2->getPluginName() == "DPX");
+                DJV_ASSERT(image2->getTags() == tags);
+                DJV_ASSERT(*image2 == *image);
+                DJV_ASSERT(!diskCache->get(IO::DiskCacheKey("image.0001.dpx", 2, 0, 1)));
+
+                // The least recently used frames are removed when the cache
+                // is full.
+                diskCache->add(IO::DiskCacheKey("image.0002.dpx", 1, 0, 2), image);
+                diskCache->flush();
+                diskCache->get(key);
+                diskCache->add(IO::DiskCacheKey("image.0003.dpx", 1, 0, 3), image);
+                diskCache->flush();
+                DJV_ASSERT(2 == diskCache->getCount());
+                DJV_ASSERT(diskCache->contains(key));
+                DJV_ASSERT(!diskCache->contains(IO::DiskCacheKey("image.0002.dpx", 1, 0, 2)));
+
+                diskCache->setMaxByteCount(byteCount);
+                DJV_ASSERT(1 == diskCache->getCount());
+                DJV_ASSERT(byteCount == diskCache->getByteCount());
+
+                diskCache->clear();
+                DJV_ASSERT(0 == diskCache->getCount());
+                DJV_ASSERT(0 == diskCache->getByteCount());
+                DJV_ASSERT(!diskCache->get(key));
+            }
+
+            {
+                // Adding a frame again while it is being written does not
+                // add it twice.
+                auto diskCache = IO::DiskCache::create(path, byteCount * 10);
+                auto image = Image::Image::create(info);
+                const IO::DiskCacheKey key("image.0001.dpx", 1, 0, 1);
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    diskCache->add(key, image);
+                }
+                diskCache->flush();
+                diskCache->add(key, image);
+                diskCache->flush();
+                DJV_ASSERT(1 == diskCache->getCount());
+                DJV_ASSERT(byteCount == diskCache->getByteCount());
+                FileSystem::DirectoryListOptions options;
+                options.fileExtensions.insert(".djvcache");
+                DJV_ASSERT(1 == FileSystem::FileInfo::directoryList(FileSystem::Path(path), options).size());
+            }
+
+            {
+                // Frames evicted from the memory cache are spilled to disk.
+                auto diskCache = IO::DiskCache::create(path, byteCount * 10);
+                auto cacheManager = IO::CacheManager::create();
+                cacheManager->setMaxByteCount(byteCount * 2);
+                cacheManager->setDiskCache(diskCache);
+                DJV_ASSERT(diskCache == cacheManager->getDiskCache());
+                const UID client = cacheManager->addClient();
+                IO::CacheWindow window;
+                window.spans.push_back(IO::CacheSpan(0, 10, IO::Direction::Forward));
+                cacheManager->setWindow(client, window);
+                for (Frame::Index i = 0; i < 2; ++i)
+                {
+                    DJV_ASSERT(cacheManager->add(
+                        client,
+                        i,
+                        Image::Image::create(info),
+                        IO::DiskCacheKey("image.dpx", 1, 0, i)));
+                }
+                window.spans[0] = IO::CacheSpan(1, 10, IO::Direction::Forward);
+                cacheManager->setWindow(client, window);
+                diskCache->flush();
+                DJV_ASSERT(1 == diskCache->getCount());
+                DJV_ASSERT(diskCache->contains(IO::DiskCacheKey("image.dpx", 1, 0, 0)));
+
+                // Frames removed by clearing the cache are not spilled.
+                cacheManager->clear(client);
+                diskCache->flush();
+                DJV_ASSERT(1 == diskCache->getCount());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
@@ -29,12 +29,19 @@
 
 #include <djvAVTest/IOTest.h>
 
+#include <djvAV/IFF.h>
 #include <djvAV/IO.h>
+#include <djvAV/ImageUtil.h>
+#include <djvAV/RLA.h>
+#include <djvAV/SGI.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
+#include <algorithm>
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -56,6 +63,9 @@ namespace djv
             _audioFrame();
             _audioQueue();
             _cache();
+            _readRegion();
+            _parallelChunks();
+            _rle();
             _io();
             _system();
             _operators();
@@ -156,7 +166,7 @@ namespace djv
         void IOTest::_videoQueue()
         {
             {
-                const IO::VideoQueue queue;
+                IO::VideoQueue queue;
                 DJV_ASSERT(0 == queue.getMax());
                 DJV_ASSERT(queue.isEmpty());
                 DJV_ASSERT(0 == queue.getCount());
@@ -176,11 +186,157 @@ namespace djv
                 DJV_ASSERT(3 == queue.getCount());
                 DJV_ASSERT(frame == queue.getFrame());
                 DJV_ASSERT(frame == queue.popFrame());
+                DJV_ASSERT(2 == queue.getFrameNumber());
                 queue.clearFrames();
                 DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(Frame::invalid == queue.getFrameNumber());
+                queue.addFrame(IO::VideoFrame(4, nullptr));
+                DJV_ASSERT(1 == queue.getCount());
+                DJV_ASSERT(4 == queue.popFrame().frame);
+                DJV_ASSERT(queue.isEmpty());
                 queue.setFinished(true);
                 DJV_ASSERT(queue.isFinished());
             }
+
+            {
+                IO::VideoQueue queue;
+                queue.setMax(1);
+                size_t count = 0;
+                while (queue.addFrame(IO::VideoFrame(count, nullptr)))
+                {
+                    ++count;
+                }
+                DJV_ASSERT(count >= queue.getMax());
+                DJV_ASSERT(count == queue.getCount());
+            }
+
+            {
+                // The slots of the frames that were cleared are not reused
+                // until the consumer has checked the queue.
+                IO::VideoQueue queue;
+                queue.setMax(1);
+                size_t count = 0;
+                while (queue.addFrame(IO::VideoFrame(count, nullptr)))
+                {
+                    queue.clearFrames();
+                    ++count;
+                }
+                DJV_ASSERT(count > queue.getMax());
+                DJV_ASSERT(0 == queue.getCount());
+                DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(queue.addFrame(IO::VideoFrame(count, nullptr)));
+                DJV_ASSERT(count == queue.getFrame().frame);
+            }
+
+            {
+                // Clearing the frames makes room without the consumer popping
+                // them.
+                IO::VideoQueue queue;
+                queue.setMax(10);
+                for (Frame::Number i = 0; i < 1000; ++i)
+                {
+                    queue.clearFrames();
+                    DJV_ASSERT(queue.isEmpty());
+                    for (size_t j = 0; j < queue.getMax(); ++j)
+                    {
+                        DJV_ASSERT(queue.addFrame(IO::VideoFrame(i, nullptr)));
+                    }
+                    DJV_ASSERT(i == queue.getFrame().frame);
+                    DJV_ASSERT(queue.getMax() == queue.getCount());
+                }
+                DJV_ASSERT(999 == queue.popFrame().frame);
+                DJV_ASSERT(queue.getMax() - 1 == queue.getCount());
+            }
+
+            {
+                IO::VideoQueue queue;
+                queue.setMax(10);
+                const Frame::Number frameCount = 1000;
+                std::thread thread(
+                    [&queue, frameCount]
+                    {
+                        for (Frame::Number i = 0; i < frameCount; ++i)
+                        {
+                            while (!queue.addFrame(IO::VideoFrame(i, nullptr)))
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                        queue.setFinished(true);
+                    });
+                Frame::Number frame = 0;
+                while (true)
+                {
+                    const bool finished = queue.isFinished();
+                    if (!queue.isEmpty())
+                    {
+                        DJV_ASSERT(frame == queue.popFrame().frame);
+                        ++frame;
+                    }
+                    else if (finished)
+                    {
+                        break;
+                    }
+                }
+                thread.join();
+                DJV_ASSERT(frameCount == frame);
+            }
+
+            {
+                // Add, clear, and pop frames at the same time. This should be
+                // run with a thread sanitizer to check that the producer does
+                // not write the slots that the consumer is reading.
+                IO::VideoQueue queue;
+                queue.setMax(4);
+                std::vector<std::shared_ptr<Image::Image> > images;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    images.push_back(Image::Image::create(Image::Info(1, 1, Image::Type::L_U8)));
+                }
+                const Frame::Number frameCount = 10000;
+                std::thread thread(
+                    [&queue, &images, frameCount]
+                    {
+                        for (Frame::Number i = 0; i < frameCount; ++i)
+                        {
+                            while (!queue.addFrame(IO::VideoFrame(i, images[i % images.size()])))
+                            {
+                                std::this_thread::yield();
+                            }
+                            if (0 == i % 3)
+                            {
+                                queue.clearFrames();
+                            }
+                        }
+                        queue.setFinished(true);
+                    });
+                Frame::Number frame = -1;
+                while (true)
+                {
+                    const bool finished = queue.isFinished();
+                    if (!queue.isEmpty())
+                    {
+                        const auto a = queue.getFrame();
+                        if (a.image)
+                        {
+                            DJV_ASSERT(a.frame > frame);
+                            DJV_ASSERT(images[a.frame % images.size()] == a.image);
+                        }
+                        const auto b = queue.popFrame();
+                        if (b.image)
+                        {
+                            DJV_ASSERT(b.frame > frame);
+                            DJV_ASSERT(images[b.frame % images.size()] == b.image);
+                            frame = b.frame;
+                        }
+                    }
+                    else if (finished)
+                    {
+                        break;
+                    }
+                }
+                thread.join();
+            }
         }
         
         void IOTest::_audioFrame()
@@ -200,7 +356,7 @@ namespace djv
         void IOTest::_audioQueue()
         {
             {
-                const IO::AudioQueue queue;
+                IO::AudioQueue queue;
                 DJV_ASSERT(0 == queue.getMax());
                 DJV_ASSERT(queue.isEmpty());
                 DJV_ASSERT(0 == queue.getCount());
@@ -226,6 +382,69 @@ namespace djv
                 queue.setFinished(true);
                 DJV_ASSERT(queue.isFinished());
             }
+
+            {
+                IO::AudioQueue queue;
+                queue.setMax(10);
+                auto audio = Audio::Data::create(Audio::Info(1, Audio::Type::S16, 2, 3));
+                for (size_t i = 0; i < 1000; ++i)
+                {
+                    queue.clearFrames();
+                    DJV_ASSERT(queue.isEmpty());
+                    for (size_t j = 0; j < queue.getMax(); ++j)
+                    {
+                        DJV_ASSERT(queue.addFrame(IO::AudioFrame(audio)));
+                    }
+                    DJV_ASSERT(queue.getMax() == queue.getCount());
+                }
+                DJV_ASSERT(audio == queue.popFrame().audio);
+                DJV_ASSERT(queue.getMax() - 1 == queue.getCount());
+            }
+
+            {
+                // Add, clear, and pop frames at the same time, see
+                // _videoQueue().
+                IO::AudioQueue queue;
+                queue.setMax(4);
+                std::vector<std::shared_ptr<Audio::Data> > audio;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    audio.push_back(Audio::Data::create(Audio::Info(1, Audio::Type::S16, 2, 3)));
+                }
+                const size_t frameCount = 10000;
+                std::thread thread(
+                    [&queue, &audio, frameCount]
+                    {
+                        for (size_t i = 0; i < frameCount; ++i)
+                        {
+                            while (!queue.addFrame(IO::AudioFrame(audio[i % audio.size()])))
+                            {
+                                std::this_thread::yield();
+                            }
+                            if (0 == i % 3)
+                            {
+                                queue.clearFrames();
+                            }
+                        }
+                        queue.setFinished(true);
+                    });
+                while (true)
+                {
+                    const bool finished = queue.isFinished();
+                    if (!queue.isEmpty())
+                    {
+                        for (const auto& frame : { queue.getFrame(), queue.popFrame() })
+                        {
+                            DJV_ASSERT(!frame.audio || std::find(audio.begin(), audio.end(), frame.audio) != audio.end());
+                        }
+                    }
+                    else if (finished)
+                    {
+                        break;
+                    }
+                }
+                thread.join();
+            }
         }
         
         void IOTest::_cache()
@@ -281,6 +500,233 @@ namespace djv
             }
         }
         
+        void IOTest::_readRegion()
+        {
+            for (auto i : IO::getProxyEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("proxy string: " + ss.str());
+                IO::Proxy proxy = IO::Proxy::First;
+                ss >> proxy;
+                DJV_ASSERT(i == proxy);
+            }
+            
+            {
+                DJV_ASSERT(1 == IO::getProxyScale(IO::Proxy::None));
+                DJV_ASSERT(2 == IO::getProxyScale(IO::Proxy::Half));
+                DJV_ASSERT(4 == IO::getProxyScale(IO::Proxy::Quarter));
+                DJV_ASSERT(8 == IO::getProxyScale(IO::Proxy::Eighth));
+            }
+            
+            {
+                const Image::Size size(100, 50);
+                IO::ReadOptions options;
+                DJV_ASSERT(BBox2i(0, 0, 100, 50) == IO::getReadRegion(size, options));
+                DJV_ASSERT(size == IO::getReadSize(size, options));
+                DJV_ASSERT(IO::isFullRead(size, options));
+                
+                options.proxy = IO::Proxy::Quarter;
+                DJV_ASSERT(Image::Size(25, 13) == IO::getReadSize(size, options));
+                DJV_ASSERT(!IO::isFullRead(size, options));
+                
+                options.roi = BBox2i(90, 40, 20, 20);
+                DJV_ASSERT(BBox2i(90, 40, 10, 10) == IO::getReadRegion(size, options));
+                DJV_ASSERT(Image::Size(3, 3) == IO::getReadSize(size, options));
+                
+                options.proxy = IO::Proxy::None;
+                options.roi = BBox2i(200, 200, 10, 10);
+                DJV_ASSERT(BBox2i(0, 0, 100, 50) == IO::getReadRegion(size, options));
+                DJV_ASSERT(IO::isFullRead(size, options));
+            }
+            
+            for (auto mirror : { Image::Mirror(false, false), Image::Mirror(true, true) })
+            {
+                Image::Info info(5, 4, Image::Type::L_U8);
+                info.layout.mirror = mirror;
+                auto image = Image::Image::create(info);
+                image->setPluginName("decimate");
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < info.size.w; ++x)
+                    {
+                        const uint16_t displayX = mirror.x ? (info.size.w - 1 - x) : x;
+                        const uint16_t displayY = mirror.y ? (info.size.h - 1 - y) : y;
+                        *image->getData(x, y) = static_cast<uint8_t>(displayY * 10 + displayX);
+                    }
+                }
+                auto decimated = Image::decimate(image, BBox2i(1, 1, 4, 3), 2);
+                DJV_ASSERT(Image::Size(2, 2) == decimated->getSize());
+                DJV_ASSERT(info.layout == decimated->getLayout());
+                DJV_ASSERT("decimate" == decimated->getPluginName());
+                for (uint16_t y = 0; y < 2; ++y)
+                {
+                    for (uint16_t x = 0; x < 2; ++x)
+                    {
+                        const uint16_t dataX = mirror.x ? (1 - x) : x;
+                        const uint16_t dataY = mirror.y ? (1 - y) : y;
+                        const uint8_t value = static_cast<uint8_t>((1 + y * 2) * 10 + 1 + x * 2);
+                        DJV_ASSERT(value == *decimated->getData(dataX, dataY));
+                    }
+                }
+            }
+        }
+        
+        void IOTest::_parallelChunks()
+        {
+            for (size_t count : { 0, 1, 2, 7, 100 })
+            {
+                for (size_t threadCount : { 0, 1, 2, 3, 8, 200 })
+                {
+                    std::vector<size_t> calls(count, 0);
+                    size_t chunkCount = 0;
+                    std::mutex mutex;
+                    IO::parallelChunks(
+                        count,
+                        threadCount,
+                        [count, &calls, &chunkCount, &mutex](size_t begin, size_t end)
+                        {
+                            DJV_ASSERT(begin <= end);
+                            DJV_ASSERT(end <= count);
+                            std::lock_guard<std::mutex> lock(mutex);
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                ++calls[i];
+                            }
+                            ++chunkCount;
+                        });
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        DJV_ASSERT(1 == calls[i]);
+                    }
+                    DJV_ASSERT(std::max(std::min(threadCount, count), static_cast<size_t>(1)) == chunkCount);
+                }
+            }
+
+            {
+                std::atomic<size_t> sum(0);
+                IO::parallelChunks(
+                    4,
+                    4,
+                    [&sum](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            IO::parallelChunks(
+                                10,
+                                4,
+                                [&sum](size_t begin2, size_t end2)
+                                {
+                                    sum += end2 - begin2;
+                                });
+                        }
+                    });
+                DJV_ASSERT(40 == sum);
+            }
+
+            for (size_t errorChunk : { 0, 3 })
+            {
+                std::vector<size_t> calls(4, 0);
+                std::mutex mutex;
+                try
+                {
+                    IO::parallelChunks(
+                        4,
+                        4,
+                        [errorChunk, &calls, &mutex](size_t begin, size_t end)
+                        {
+                            {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                ++calls[begin];
+                            }
+                            if (errorChunk == begin)
+                            {
+                                throw std::runtime_error("chunk");
+                            }
+                        });
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    DJV_ASSERT(std::string("chunk") == e.what());
+                }
+                for (size_t i = 0; i < calls.size(); ++i)
+                {
+                    DJV_ASSERT(1 == calls[i]);
+                }
+            }
+        }
+
+        void IOTest::_rle()
+        {
+            {
+                const std::vector<uint8_t> data = { 0x82, 1, 2, 0x02, 7 };
+                std::vector<uint8_t> out(4, 0);
+                DJV_ASSERT(IO::SGI::readRle(data.data(), data.data() + data.size(), out.data(), 4, 1, 1));
+                DJV_ASSERT(std::vector<uint8_t>({ 1, 2, 7, 7 }) == out);
+            }
+            {
+                const std::vector<uint8_t> data = { 0, 0x81, 0x12, 0x34 };
+                std::vector<uint8_t> out(4, 0);
+                DJV_ASSERT(IO::SGI::readRle(data.data(), data.data() + data.size(), out.data(), 1, 2, 4));
+                DJV_ASSERT(std::vector<uint8_t>({ 0x12, 0x34, 0, 0 }) == out);
+            }
+            for (const auto& i : std::vector<std::pair<std::vector<uint8_t>, size_t> >({
+                { {}, 1 },
+                { { 0x84, 1, 2 }, 1 },
+                { { 0x05, 7 }, 1 },
+                { { 0x00, 7 }, 1 },
+                { { 0x04 }, 1 },
+                { { 0x00, 0x81, 0x12 }, 2 },
+                { { 0x00, 0x01 }, 2 } }))
+            {
+                std::vector<uint8_t> out(8, 0);
+                DJV_ASSERT(!IO::SGI::readRle(i.first.data(), i.first.data() + i.first.size(), out.data(), 4, i.second, i.second));
+            }
+
+            {
+                const std::vector<uint8_t> data = { 0x00, 0x05, 0x01, 9, 0xfe, 3, 4, 0xff };
+                const uint8_t* p = data.data();
+                std::vector<uint8_t> out(4, 0);
+                DJV_ASSERT(IO::RLA::readRle(p, data.data() + data.size(), out.data(), 4, 1, 1));
+                DJV_ASSERT(std::vector<uint8_t>({ 9, 9, 3, 4 }) == out);
+                DJV_ASSERT(data.data() + 7 == p);
+            }
+            for (const auto& i : std::vector<std::vector<uint8_t> >({
+                {},
+                { 0x00 },
+                { 0x00, 0x08, 0x01, 9 },
+                { 0x00, 0x02, 0x04, 9 },
+                { 0x00, 0x02, 0x01, 9 },
+                { 0x00, 0x02, 0xfc, 1 },
+                { 0x00, 0x01, 0x03 } }))
+            {
+                const uint8_t* p = i.data();
+                std::vector<uint8_t> out(4, 0);
+                DJV_ASSERT(!IO::RLA::readRle(p, i.data() + i.size(), out.data(), 4, 1, 1));
+            }
+
+            {
+                const std::vector<uint8_t> data = { 0x81, 5, 0x01, 6, 7, 0xff };
+                const uint8_t* p = data.data();
+                std::vector<uint8_t> out(4, 0);
+                DJV_ASSERT(IO::IFF::readRle(p, data.data() + data.size(), out.data(), 4));
+                DJV_ASSERT(std::vector<uint8_t>({ 5, 5, 6, 7 }) == out);
+                DJV_ASSERT(data.data() + 5 == p);
+            }
+            for (const auto& i : std::vector<std::vector<uint8_t> >({
+                {},
+                { 0x83 },
+                { 0x03, 1, 2 },
+                { 0x84, 5 },
+                { 0x04, 1, 2, 3, 4, 5 } }))
+            {
+                const uint8_t* p = i.data();
+                std::vector<uint8_t> out(4, 0);
+                DJV_ASSERT(!IO::IFF::readRle(p, i.data() + i.size(), out.data(), 4));
+            }
+        }
+        
         void IOTest::_io()
         {
             if (auto context = getContext().lock())
@@ -327,7 +773,6 @@ namespace djv
                                     info.video.push_back(imageInfo);
                                     auto write = io->write(FileSystem::FileInfo(path), info);
                                     {
-                                        std::lock_guard<std::mutex> lock(write->getMutex());
                                         auto& writeQueue = write->getVideoQueue();
                                         writeQueue.addFrame(IO::VideoFrame(0, image));
                                         writeQueue.setFinished(true);
@@ -343,22 +788,15 @@ namespace djv
                                     {
                                         bool sleep = false;
                                         {
-                                            std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
-                                            if (lock.owns_lock())
+                                            auto& readQueue = read->getVideoQueue();
+                                            const bool finished = readQueue.isFinished();
+                                            if (!readQueue.isEmpty())
+                                            {
+                                                auto frame = readQueue.popFrame();
+                                            }
+                                            else if (finished)
                                             {
-                                                auto& readQueue = read->getVideoQueue();
-                                                if (!readQueue.isEmpty())
-                                                {
-                                                    auto frame = readQueue.popFrame();
-                                                }
-                                                else if (readQueue.isFinished())
-                                                {
-                                                    running = false;
-                                                }
-                                                else
-                                                {
-                                                    sleep = true;
-                                                }
+                                                running = false;
                                             }
                                             else
                                             {
@@ -49,6 +49,9 @@ namespace djv
             void _audioFrame();
             void _audioQueue();
             void _cache();
+            void _readRegion();
+            void _parallelChunks();
+            void _rle();
             void _io();
             void _system();
             void _operators();
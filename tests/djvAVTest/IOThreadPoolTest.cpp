@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/IOThreadPoolTest.h>
+
+#include <djvAV/IOThreadPool.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        IOThreadPoolTest::IOThreadPoolTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::IOThreadPoolTest", context)
+        {}
+        
+        void IOThreadPoolTest::run(const std::vector<std::string>& args)
+        {
+            {
+                auto threadPool = IO::ThreadPool::create();
+                DJV_ASSERT(threadPool->getThreadCount() > 0);
+            }
+            
+            {
+                auto threadPool = IO::ThreadPool::create(2);
+                DJV_ASSERT(2 == threadPool->getThreadCount());
+                const UID client = threadPool->addClient();
+                const UID client2 = threadPool->addClient();
+                DJV_ASSERT(0 == threadPool->getJobCount(client));
+                std::vector<std::future<int> > futures;
+                for (int i = 0; i < 10; ++i)
+                {
+                    futures.push_back(threadPool->submit<int>(
+                        i % 2 ? client : client2,
+                        IO::JobPriority::Queue,
+                        nullptr,
+                        [i]
+                        {
+                            return i;
+                        }));
+                }
+                for (int i = 0; i < 10; ++i)
+                {
+                    DJV_ASSERT(i == futures[i].get());
+                }
+                threadPool->removeClient(client);
+                threadPool->removeClient(client2);
+                DJV_ASSERT(0 == threadPool->getJobCount(client));
+            }
+
+            {
+                auto cancelToken = IO::CancelToken::create();
+                DJV_ASSERT(!cancelToken->isCancelled());
+                cancelToken->cancel();
+                DJV_ASSERT(cancelToken->isCancelled());
+            }
+
+            {
+                auto threadPool = IO::ThreadPool::create(1);
+                const UID client = threadPool->addClient();
+                
+                // Block the worker thread while the other jobs are submitted.
+                std::promise<void> promise;
+                auto blockFuture = promise.get_future().share();
+                auto future = threadPool->submit<void>(
+                    client,
+                    IO::JobPriority::Display,
+                    nullptr,
+                    [blockFuture]
+                    {
+                        blockFuture.wait();
+                    });
+                
+                std::mutex mutex;
+                std::vector<IO::JobPriority> order;
+                auto cancelToken = IO::CancelToken::create();
+                std::vector<std::future<void> > futures;
+                for (auto priority : {
+                    IO::JobPriority::ReadBehind,
+                    IO::JobPriority::Cache,
+                    IO::JobPriority::Queue,
+                    IO::JobPriority::Display })
+                {
+                    futures.push_back(threadPool->submit<void>(
+                        client,
+                        priority,
+                        nullptr,
+                        [priority, &mutex, &order]
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            order.push_back(priority);
+                        }));
+                }
+                auto cancelledFuture = threadPool->submit<void>(
+                    client,
+                    IO::JobPriority::Display,
+                    cancelToken,
+                    [&mutex, &order]
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        order.push_back(IO::JobPriority::Count);
+                    });
+                cancelToken->cancel();
+                promise.set_value();
+                future.get();
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+                threadPool->removeClient(client);
+                const std::vector<IO::JobPriority> result =
+                {
+                    IO::JobPriority::Display,
+                    IO::JobPriority::Queue,
+                    IO::JobPriority::Cache,
+                    IO::JobPriority::ReadBehind
+                };
+                DJV_ASSERT(result == order);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ImageCompressedDataTest.h>
+
+#include <djvAV/ImageCompressedData.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageCompressedDataTest::ImageCompressedDataTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageCompressedDataTest", context)
+        {}
+        
+        void ImageCompressedDataTest::run(const std::vector<std::string>& args)
+        {
+            for (auto type : { Image::Type::L_U8, Image::Type::RGB_U10, Image::Type::RGBA_F16, Image::Type::RGBA_F32 })
+            {
+                for (const auto& size : { Image::Size(0, 0), Image::Size(1, 1), Image::Size(12, 1), Image::Size(17, 1), Image::Size(301, 203) })
+                {
+                    const Image::Info info(size, type);
+                    auto image = Image::Image::create(info);
+                    image->setPluginName("Plugin");
+                    Tags tags;
+                    tags.setTag("Key", "Value");
+                    image->setTags(tags);
+
+                    // A flat background with a noisy area in the middle.
+                    uint8_t* p = image->getData();
+                    const size_t dataByteCount = image->getDataByteCount();
+                    uint32_t random = 1;
+                    for (size_t i = 0; i < dataByteCount; ++i)
+                    {
+                        random = random * 1103515245 + 12345;
+                        p[i] = (i > dataByteCount / 3 && i < dataByteCount / 2) ? static_cast<uint8_t>(random >> 16) : 0;
+                    }
+
+                    auto compressed = Image::CompressedData::create(*image);
+                    DJV_ASSERT(compressed->getInfo() == info);
+                    DJV_ASSERT(dataByteCount == compressed->getDataByteCount());
+                    DJV_ASSERT(compressed->getCompressedByteCount() <= dataByteCount);
+                    if (dataByteCount > 1000)
+                    {
+                        DJV_ASSERT(compressed->getRatio() > 1.F);
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << "ratio: " << compressed->getRatio();
+                        _print(ss.str());
+                    }
+
+                    auto image2 = compressed->decompress();
+                    DJV_ASSERT(image2);
+                    DJV_ASSERT(*image2 == *image);
+                    DJV_ASSERT(image2->getPluginName() == "Plugin");
+                    DJV_ASSERT(image2->getTags() == tags);
+                }
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
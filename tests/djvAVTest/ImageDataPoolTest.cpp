@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ImageDataPoolTest.h>
+
+#include <djvAV/ImageData.h>
+#include <djvAV/ImageDataPool.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageDataPoolTest::ImageDataPoolTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageDataPoolTest", context)
+        {}
+        
+        void ImageDataPoolTest::run(const std::vector<std::string>& args)
+        {
+            {
+                DJV_ASSERT(0 == Image::DataPool::getSizeClass(0));
+                const size_t pageSize = Image::DataPool::getSizeClass(1);
+                DJV_ASSERT(pageSize > 0);
+                DJV_ASSERT(pageSize == Image::DataPool::getSizeClass(pageSize));
+                DJV_ASSERT(pageSize * 2 == Image::DataPool::getSizeClass(pageSize + 1));
+            }
+
+            {
+                auto pool = Image::DataPool::create();
+                DJV_ASSERT(!pool->allocate(0));
+                pool->release(nullptr, 0);
+
+                const size_t byteCount = 1000000;
+                const size_t sizeClass = Image::DataPool::getSizeClass(byteCount);
+                uint8_t* data = pool->allocate(byteCount);
+                DJV_ASSERT(data);
+                DJV_ASSERT(0 == reinterpret_cast<uintptr_t>(data) % Image::DataPool::getSizeClass(1));
+                DJV_ASSERT(sizeClass == pool->getUsedByteCount());
+                DJV_ASSERT(0 == pool->getFreeByteCount());
+
+                // Released buffers are reused for the same size class.
+                pool->release(data, byteCount);
+                DJV_ASSERT(0 == pool->getUsedByteCount());
+                DJV_ASSERT(sizeClass == pool->getFreeByteCount());
+                DJV_ASSERT(1 == pool->getFreeCount());
+                uint8_t* data2 = pool->allocate(byteCount);
+                DJV_ASSERT(data == data2);
+                DJV_ASSERT(0 == pool->getFreeCount());
+                uint8_t* data3 = pool->allocate(byteCount * 2);
+                pool->release(data2, byteCount);
+                pool->release(data3, byteCount * 2);
+                DJV_ASSERT(2 == pool->getFreeCount());
+
+                // The least recently released buffers are freed when the
+                // high-water mark is exceeded.
+                pool->setHighWaterMark(Image::DataPool::getSizeClass(byteCount * 2));
+                DJV_ASSERT(1 == pool->getFreeCount());
+                uint8_t* data4 = pool->allocate(byteCount * 2);
+                DJV_ASSERT(data3 == data4);
+                pool->release(data4, byteCount * 2);
+
+                pool->trim();
+                DJV_ASSERT(0 == pool->getFreeCount());
+                DJV_ASSERT(0 == pool->getFreeByteCount());
+
+                pool->setHighWaterMark(0);
+                DJV_ASSERT(0 == pool->getHighWaterMark());
+                data = pool->allocate(byteCount);
+                pool->release(data, byteCount);
+                DJV_ASSERT(0 == pool->getFreeCount());
+            }
+
+            {
+                auto pool = Image::DataPool::create();
+                pool->setPrefault(true);
+                DJV_ASSERT(pool->hasPrefault());
+                uint8_t* data = pool->allocate(100000);
+                DJV_ASSERT(0 == data[0]);
+                pool->release(data, 100000);
+            }
+
+            {
+                // Image data is allocated from the global pool.
+                auto pool = Image::DataPool::getGlobal();
+                const Image::Info info(64, 64, Image::Type::RGBA_U8);
+                const size_t usedByteCount = pool->getUsedByteCount();
+                {
+                    auto data = Image::Data::create(info);
+                    DJV_ASSERT(usedByteCount + Image::DataPool::getSizeClass(info.getDataByteCount()) == pool->getUsedByteCount());
+                }
+                DJV_ASSERT(usedByteCount == pool->getUsedByteCount());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
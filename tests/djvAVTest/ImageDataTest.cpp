@@ -31,8 +31,11 @@
 
 #include <djvAV/ImageData.h>
 
+#include <djvCore/FileIO.h>
 #include <djvCore/Memory.h>
 
+#include <cstring>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -229,6 +232,40 @@ namespace djv
                 auto data2 = Image::Data::create(info);
                 DJV_ASSERT(data->getUID() != data2->getUID());
             }
+
+            {
+                const Image::Info info(2, 2, Image::Type::L_U8);
+                const std::string fileName = "ImageDataTest";
+                const uint8_t pixels[] = { 0, 1, 2, 3 };
+                {
+                    FileSystem::FileIO io;
+                    io.open(fileName, FileSystem::FileIO::Mode::Write);
+                    io.writeU8(pixels, 4);
+                }
+
+                // Memory-mapped data refers to the file until it is modified.
+                auto io = std::shared_ptr<FileSystem::FileIO>(new FileSystem::FileIO);
+                io->setMMap(true);
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(data->isMMap());
+                const auto& constData = *data;
+                DJV_ASSERT(io->mmapP() == constData.getData());
+                DJV_ASSERT(info.getDataByteCount() == data->getDataByteCount());
+                DJV_ASSERT(0 == memcmp(pixels, constData.getData(), 4));
+                data->getData()[0] = 4;
+                DJV_ASSERT(!data->isMMap());
+                DJV_ASSERT(4 == constData.getData()[0]);
+                DJV_ASSERT(0 == memcmp(pixels + 1, constData.getData() + 1, 3));
+                DJV_ASSERT(0 == io->mmapP()[0]);
+
+                // Files that are too small are copied.
+                io->setPos(1);
+                auto data2 = Image::Data::create(info, io);
+                DJV_ASSERT(!data2->isMMap());
+                DJV_ASSERT(0 == memcmp(pixels + 1, data2->getData(), 3));
+                DJV_ASSERT(0 == data2->getData()[3]);
+            }
         }
         
         void ImageDataTest::_util()
@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <djvAVTest/PPMTest.h>
+
+#include <djvAV/PPM.h>
+
+#include <djvCore/FileSystem.h>
+
+#include <random>
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            const uint8_t* getBegin(const std::string& value)
+            {
+                return reinterpret_cast<const uint8_t*>(value.data());
+            }
+
+            const uint8_t* getEnd(const std::string& value)
+            {
+                return reinterpret_cast<const uint8_t*>(value.data()) + value.size();
+            }
+
+        } // namespace
+
+        PPMTest::PPMTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::PPMTest", context)
+        {}
+        
+        void PPMTest::run(const std::vector<std::string>& args)
+        {
+            _countASCII();
+            _readASCII();
+            _readASCIIChunks();
+        }
+
+        void PPMTest::_countASCII()
+        {
+            for (const auto& i : std::vector<std::pair<std::string, size_t> >({
+                { "", 0 },
+                { " \t\n\r", 0 },
+                { "# 1 2 3", 0 },
+                { "1 22 333", 3 },
+                { "1\n22\n333\n", 3 },
+                { "# 1 2\n3 4", 2 },
+                { "# 1 2\r3\r4", 2 },
+                { "# 1 2\r\n3\r\n4\r\n", 2 },
+                { "1#2\n3", 2 } }))
+            {
+                DJV_ASSERT(i.second == IO::PPM::countASCII(getBegin(i.first), getEnd(i.first)));
+            }
+        }
+
+        void PPMTest::_readASCII()
+        {
+            {
+                const std::string data = "# 1 2\r10\r20 # 3\r30 40";
+                std::vector<uint8_t> out(3, 0);
+                DJV_ASSERT(3 == IO::PPM::readASCII(getBegin(data), getEnd(data), out.data(), 3, 8));
+                DJV_ASSERT(std::vector<uint8_t>({ 10, 20, 30 }) == out);
+            }
+
+            {
+                const std::string data = "65535\n# 1\n0\n1000\n";
+                std::vector<uint16_t> out(3, 0);
+                DJV_ASSERT(3 == IO::PPM::readASCII(getBegin(data), getEnd(data), reinterpret_cast<uint8_t*>(out.data()), 3, 16));
+                DJV_ASSERT(std::vector<uint16_t>({ 65535, 0, 1000 }) == out);
+            }
+
+            {
+                const std::string data = "1 2 # 3";
+                std::vector<uint8_t> out(3, 0);
+                DJV_ASSERT(2 == IO::PPM::readASCII(getBegin(data), getEnd(data), out.data(), 3, 8));
+            }
+        }
+
+        void PPMTest::_readASCIIChunks()
+        {
+            // Generate data with comments and each kind of line ending, and
+            // check that it is parsed the same with any number of chunks.
+            for (size_t bitDepth : { 8, 16 })
+            {
+                const size_t size = 1000;
+                std::mt19937 rng(static_cast<unsigned int>(bitDepth));
+                std::uniform_int_distribution<int> valueDist(0, 8 == bitDepth ? 255 : 65535);
+                std::uniform_int_distribution<int> separatorDist(0, 5);
+                std::vector<uint16_t> values(size);
+                std::stringstream ss;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    values[i] = static_cast<uint16_t>(valueDist(rng));
+                    ss << values[i];
+                    switch (separatorDist(rng))
+                    {
+                    case 0: ss << " "; break;
+                    case 1: ss << "\n"; break;
+                    case 2: ss << "\r"; break;
+                    case 3: ss << "\r\n"; break;
+                    case 4: ss << " # " << i << " " << i + 1 << "\n"; break;
+                    case 5: ss << "\t# " << i << "\r"; break;
+                    }
+                }
+                const std::string data = ss.str();
+                const size_t componentByteCount = bitDepth / 8;
+                for (size_t threadCount : { 1, 2, 3, 8, 64 })
+                {
+                    std::vector<uint8_t> out(size * componentByteCount, 0);
+                    IO::PPM::readASCIIChunks(getBegin(data), getEnd(data), out.data(), size, bitDepth, threadCount, 1);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        const uint16_t value = 8 == bitDepth ?
+                            out[i] :
+                            reinterpret_cast<const uint16_t*>(out.data())[i];
+                        DJV_ASSERT(values[i] == value);
+                    }
+                }
+
+                for (size_t threadCount : { 1, 2, 8 })
+                {
+                    const std::string truncated = data.substr(0, data.size() / 2);
+                    std::vector<uint8_t> out(size * componentByteCount, 0);
+                    try
+                    {
+                        IO::PPM::readASCIIChunks(getBegin(truncated), getEnd(truncated), out.data(), size, bitDepth, threadCount, 1);
+                        DJV_ASSERT(false);
+                    }
+                    catch (const FileSystem::Error& e)
+                    {
+                        DJV_ASSERT(std::string("Incomplete file.") == e.what());
+                    }
+                }
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
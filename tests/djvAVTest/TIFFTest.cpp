@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <djvAVTest/TIFFTest.h>
+
+#include <djvAV/TIFF.h>
+
+#include <djvCore/FileIO.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            struct File
+            {
+                ~File()
+                {
+                    if (f)
+                    {
+                        TIFFClose(f);
+                    }
+                }
+
+                ::TIFF* f = nullptr;
+            };
+
+            void setFields(::TIFF* f, const Image::Info& info, uint16 compression, uint16 predictor, uint32 rowsPerStrip)
+            {
+                TIFFSetField(f, TIFFTAG_IMAGEWIDTH, static_cast<uint32>(info.size.w));
+                TIFFSetField(f, TIFFTAG_IMAGELENGTH, static_cast<uint32>(info.size.h));
+                TIFFSetField(f, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+                TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, 3);
+                TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, Image::DataType::U16 == Image::getDataType(info.type) ? 16 : 8);
+                TIFFSetField(f, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_UINT);
+                TIFFSetField(f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+                TIFFSetField(f, TIFFTAG_COMPRESSION, compression);
+                if (predictor != PREDICTOR_NONE)
+                {
+                    TIFFSetField(f, TIFFTAG_PREDICTOR, predictor);
+                }
+                TIFFSetField(f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                TIFFSetField(f, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+            }
+
+        } // namespace
+
+        TIFFTest::TIFFTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::TIFFTest", context)
+        {}
+        
+        void TIFFTest::run(const std::vector<std::string>& args)
+        {
+            _writeStrips();
+        }
+
+        void TIFFTest::_writeStrips()
+        {
+            struct Data
+            {
+                uint16 compression;
+                uint16 predictor;
+            };
+            const std::vector<Data> data =
+            {
+                { COMPRESSION_NONE, PREDICTOR_NONE },
+                { COMPRESSION_LZW, PREDICTOR_NONE },
+                { COMPRESSION_ADOBE_DEFLATE, PREDICTOR_HORIZONTAL },
+                { COMPRESSION_PACKBITS, PREDICTOR_NONE }
+            };
+            std::mt19937 random(1);
+            for (const auto& i : data)
+            {
+                for (const auto type : { Image::Type::RGB_U8, Image::Type::RGB_U16 })
+                {
+                    // The strips do not divide the image evenly, and there is
+                    // more than one batch of strips.
+                    const Image::Info info(37, 100, type);
+                    const uint32 rowsPerStrip = 8;
+                    const uint32 stripCount = 13;
+                    const size_t threadCount = 3;
+                    auto image = Image::Image::create(info);
+                    const size_t scanlineByteCount = static_cast<size_t>(info.size.w) * Image::getByteCount(type);
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        uint8_t* p = image->getData(y);
+                        for (size_t x = 0; x < scanlineByteCount; ++x)
+                        {
+                            p[x] = static_cast<uint8_t>(x / 4 + y + random() % 3);
+                        }
+                    }
+
+                    // Write the image with the batches of strips, and one
+                    // scanline at a time with libtiff.
+                    const std::string fileName = "TIFFTest.tif";
+                    const std::string scanlineFileName = "TIFFTestScanline.tif";
+                    {
+                        File f;
+                        f.f = TIFFOpen(fileName.c_str(), "w");
+                        DJV_ASSERT(f.f);
+                        setFields(f.f, info, i.compression, i.predictor, rowsPerStrip);
+                        IO::TIFF::writeStrips(f.f, *image, threadCount);
+                    }
+                    {
+                        File f;
+                        f.f = TIFFOpen(scanlineFileName.c_str(), "w");
+                        DJV_ASSERT(f.f);
+                        setFields(f.f, info, i.compression, i.predictor, rowsPerStrip);
+                        std::vector<uint8_t> scanline(scanlineByteCount);
+                        for (uint16_t y = 0; y < info.size.h; ++y)
+                        {
+                            // The predictor can modify the scanline.
+                            memcpy(scanline.data(), image->getData(y), scanlineByteCount);
+                            DJV_ASSERT(TIFFWriteScanline(f.f, scanline.data(), y, 0) != -1);
+                        }
+                    }
+
+                    File f;
+                    f.f = TIFFOpen(fileName.c_str(), "r");
+                    DJV_ASSERT(f.f);
+                    File scanlineF;
+                    scanlineF.f = TIFFOpen(scanlineFileName.c_str(), "r");
+                    DJV_ASSERT(scanlineF.f);
+                    DJV_ASSERT(stripCount == TIFFNumberOfStrips(f.f));
+                    DJV_ASSERT(stripCount == TIFFNumberOfStrips(scanlineF.f));
+
+                    // Check that the strips are in order inside the file.
+                    size_t fileSize = 0;
+                    {
+                        FileSystem::FileIO io;
+                        io.open(fileName, FileSystem::FileIO::Mode::Read);
+                        fileSize = io.getSize();
+                    }
+                    uint64* offsets = nullptr;
+                    uint64* byteCounts = nullptr;
+                    DJV_ASSERT(TIFFGetField(f.f, TIFFTAG_STRIPOFFSETS, &offsets));
+                    DJV_ASSERT(TIFFGetField(f.f, TIFFTAG_STRIPBYTECOUNTS, &byteCounts));
+                    for (uint32 j = 0; j < stripCount; ++j)
+                    {
+                        DJV_ASSERT(byteCounts[j] > 0);
+                        DJV_ASSERT(offsets[j] >= (j > 0 ? offsets[j - 1] + byteCounts[j - 1] : 8));
+                        DJV_ASSERT(offsets[j] + byteCounts[j] <= fileSize);
+                    }
+
+                    // Compare the decoded strips.
+                    const tmsize_t stripSize = TIFFStripSize(f.f);
+                    std::vector<uint8_t> strip(stripSize);
+                    std::vector<uint8_t> scanlineStrip(stripSize);
+                    for (uint32 j = 0; j < stripCount; ++j)
+                    {
+                        const uint32 y0 = j * rowsPerStrip;
+                        const uint32 rows = std::min(rowsPerStrip, static_cast<uint32>(info.size.h) - y0);
+                        const tmsize_t size = static_cast<tmsize_t>(rows * scanlineByteCount);
+                        DJV_ASSERT(size == TIFFReadEncodedStrip(f.f, j, strip.data(), stripSize));
+                        DJV_ASSERT(size == TIFFReadEncodedStrip(scanlineF.f, j, scanlineStrip.data(), stripSize));
+                        DJV_ASSERT(0 == memcmp(strip.data(), scanlineStrip.data(), size));
+                        for (uint32 y = 0; y < rows; ++y)
+                        {
+                            DJV_ASSERT(0 == memcmp(strip.data() + y * scanlineByteCount, image->getData(y0 + y), scanlineByteCount));
+                        }
+                    }
+                }
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/AsyncFileIOTest.h>
+
+#include <djvCore/AsyncFileIO.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+
+#include <cstring>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        AsyncFileIOTest::AsyncFileIOTest(const std::shared_ptr<Context>& context) :
+            ITest("djv::CoreTest::AsyncFileIOTest", context),
+            _fileName("AsyncFileIOTest"),
+            _text("Hello world!")
+        {}
+        
+        void AsyncFileIOTest::run(const std::vector<std::string>& args)
+        {
+            FileSystem::FileIO io;
+            io.open(_fileName, FileSystem::FileIO::Mode::Write);
+            io.write(_text);
+            io.close();
+
+            _buffer();
+            _read();
+            _error();
+            _fileIO();
+        }
+
+        void AsyncFileIOTest::_buffer()
+        {
+            {
+                auto buffer = FileSystem::ReadBuffer::create(100);
+                DJV_ASSERT(buffer->getData());
+                DJV_ASSERT(100 == buffer->getSize());
+                DJV_ASSERT(0 == reinterpret_cast<size_t>(buffer->getData()) % FileSystem::ReadBuffer::defaultAlignment);
+            }
+
+            {
+                auto buffer = FileSystem::ReadBuffer::create(0);
+                DJV_ASSERT(!buffer->getData());
+                DJV_ASSERT(0 == buffer->getSize());
+            }
+
+            {
+                std::vector<uint8_t> data(10);
+                auto buffer = FileSystem::ReadBuffer::create(data.data(), data.size());
+                DJV_ASSERT(data.data() == buffer->getData());
+                DJV_ASSERT(data.size() == buffer->getSize());
+            }
+        }
+
+        void AsyncFileIOTest::_read()
+        {
+            for (auto backend : { FileSystem::AsyncFileIO::Backend::IOURing, FileSystem::AsyncFileIO::Backend::ThreadPool })
+            {
+                auto asyncIO = FileSystem::AsyncFileIO::create(2, backend);
+                {
+                    std::stringstream ss;
+                    ss << "backend: " << static_cast<int>(asyncIO->getBackend());
+                    _print(ss.str());
+                }
+                DJV_ASSERT(2 == asyncIO->getQueueDepth());
+                if (FileSystem::AsyncFileIO::Backend::ThreadPool == backend)
+                {
+                    DJV_ASSERT(backend == asyncIO->getBackend());
+                }
+
+                {
+                    auto result = asyncIO->read(FileSystem::AsyncReadRequest(_fileName)).get();
+                    DJV_ASSERT(_fileName == result.fileName);
+                    DJV_ASSERT(0 == result.offset);
+                    DJV_ASSERT(_text.size() == result.size);
+                    DJV_ASSERT(0 == memcmp(_text.data(), result.buffer->getData(), _text.size()));
+                }
+
+                {
+                    // Submit more requests than the queue depth.
+                    std::vector<FileSystem::AsyncReadRequest> requests;
+                    for (size_t i = 0; i < _text.size(); ++i)
+                    {
+                        requests.push_back(FileSystem::AsyncReadRequest(_fileName, i, 1));
+                    }
+                    auto futures = asyncIO->read(requests);
+                    DJV_ASSERT(requests.size() == futures.size());
+                    for (size_t i = 0; i < futures.size(); ++i)
+                    {
+                        const auto result = futures[i].get();
+                        DJV_ASSERT(i == result.offset);
+                        DJV_ASSERT(1 == result.size);
+                        DJV_ASSERT(_text[i] == static_cast<char>(result.buffer->getData()[0]));
+                    }
+                }
+
+                {
+                    std::vector<uint8_t> data(_text.size());
+                    FileSystem::AsyncReadRequest request(_fileName, 6);
+                    request.buffer = FileSystem::ReadBuffer::create(data.data(), data.size());
+                    const auto result = asyncIO->read(request).get();
+                    DJV_ASSERT(_text.size() - 6 == result.size);
+                    DJV_ASSERT(data.data() == result.buffer->getData());
+                    DJV_ASSERT(0 == memcmp(_text.data() + 6, data.data(), result.size));
+                }
+
+                {
+                    const auto result = asyncIO->read(FileSystem::AsyncReadRequest(_fileName, _text.size())).get();
+                    DJV_ASSERT(0 == result.size);
+                }
+            }
+        }
+
+        void AsyncFileIOTest::_error()
+        {
+            for (auto backend : { FileSystem::AsyncFileIO::Backend::IOURing, FileSystem::AsyncFileIO::Backend::ThreadPool })
+            {
+                auto asyncIO = FileSystem::AsyncFileIO::create(2, backend);
+                std::vector<FileSystem::AsyncReadRequest> requests;
+                requests.push_back(FileSystem::AsyncReadRequest(""));
+                requests.push_back(FileSystem::AsyncReadRequest(_fileName, _text.size() + 1));
+                requests.push_back(FileSystem::AsyncReadRequest(_fileName, 0, _text.size() + 1));
+                FileSystem::AsyncReadRequest request(_fileName);
+                request.buffer = FileSystem::ReadBuffer::create(1);
+                requests.push_back(request);
+                for (auto& i : asyncIO->read(requests))
+                {
+                    try
+                    {
+                        i.get();
+                        DJV_ASSERT(false);
+                    }
+                    catch (const FileSystem::Error& e)
+                    {
+                        _print(e.what());
+                    }
+                }
+            }
+        }
+
+        void AsyncFileIOTest::_fileIO()
+        {
+            auto result = FileSystem::AsyncFileIO::getGlobal()->read(FileSystem::AsyncReadRequest(_fileName)).get();
+            FileSystem::FileIO io;
+            io.open(_fileName, result.buffer, result.size);
+            DJV_ASSERT(io.isOpen());
+            DJV_ASSERT(io.isMMap());
+            DJV_ASSERT(_fileName == io.getFileName());
+            DJV_ASSERT(_text.size() == io.getSize());
+            char buf[String::cStringLength];
+            FileSystem::FileIO::readWord(io, buf);
+            DJV_ASSERT(std::string("Hello") == buf);
+            io.setPos(6);
+            DJV_ASSERT(0 == memcmp(io.mmapP(), _text.data() + 6, _text.size() - 6));
+
+            FileSystem::FileIO io2(std::move(io));
+            DJV_ASSERT(!io.isOpen());
+            DJV_ASSERT(io2.isMMap());
+            result.buffer.reset();
+            DJV_ASSERT("world!" == FileSystem::FileIO::readContents(io2));
+
+            io2.close();
+            DJV_ASSERT(!io2.isOpen());
+            DJV_ASSERT(!io2.isMMap());
+        }
+
+    } // namespace CoreTest
+} // namespace djv
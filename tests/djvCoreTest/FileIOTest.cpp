@@ -31,6 +31,7 @@
 
 #include <djvCore/FileIO.h>
 
+#include <cstring>
 #include <sstream>
 
 using namespace djv::Core;
@@ -51,6 +52,8 @@ namespace djv
             _io();
             _error();
             _endian();
+            _mmap();
+            _prefetch();
             _temp();
         }
 
@@ -265,6 +268,52 @@ namespace djv
             DJV_ASSERT(a == _b);
         }
 
+        void FileIOTest::_mmap()
+        {
+            FileSystem::FileIO io;
+            io.open(_fileName, FileSystem::FileIO::Mode::Write);
+            io.write(_text + " " + _text2);
+            DJV_ASSERT(!io.isMMap());
+            DJV_ASSERT(!io.mmapP());
+
+            DJV_ASSERT(!io.hasMMap());
+            io.setMMap(true);
+            DJV_ASSERT(io.hasMMap());
+            io.open(_fileName, FileSystem::FileIO::Mode::Read);
+            DJV_ASSERT(io.isMMap());
+            DJV_ASSERT(io.getSize() == static_cast<size_t>(io.mmapEnd() - io.mmapP()));
+            io.mmapWillNeed(io.getSize());
+            char buf[String::cStringLength];
+            FileSystem::FileIO::readWord(io, buf);
+            DJV_ASSERT(_text == buf);
+            io.setPos(_text.size() + 1);
+            DJV_ASSERT(0 == memcmp(io.mmapP(), _text2.data(), _text2.size()));
+
+            FileSystem::FileIO io2(std::move(io));
+            DJV_ASSERT(!io.isMMap());
+            DJV_ASSERT(io2.isMMap());
+            DJV_ASSERT(_text2 == FileSystem::FileIO::readContents(io2));
+
+            io2.close();
+            DJV_ASSERT(!io2.isMMap());
+            io2.open(_fileName, FileSystem::FileIO::Mode::ReadWrite);
+            DJV_ASSERT(!io2.isMMap());
+        }
+
+        void FileIOTest::_prefetch()
+        {
+            {
+                FileSystem::FileIO io;
+                io.open(_fileName, FileSystem::FileIO::Mode::Write);
+                io.write(_text);
+            }
+            FileSystem::FileIO::prefetch(_fileName);
+            FileSystem::FileIO::prefetch(std::string());
+            FileSystem::FileIO io;
+            io.open(_fileName, FileSystem::FileIO::Mode::Read);
+            DJV_ASSERT(_text == FileSystem::FileIO::readContents(io));
+        }
+
         void FileIOTest::_temp()
         {
             FileSystem::FileIO io;
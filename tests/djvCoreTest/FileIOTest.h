@@ -46,6 +46,8 @@ namespace djv
             void _io();
             void _error();
             void _endian();
+            void _mmap();
+            void _prefetch();
             void _temp();
 
             std::string _fileName;
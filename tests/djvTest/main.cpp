@@ -28,6 +28,7 @@
 //------------------------------------------------------------------------------
 
 #include <djvCoreTest/AnimationTest.h>
+#include <djvCoreTest/AsyncFileIOTest.h>
 #include <djvCoreTest/BBoxTest.h>
 #include <djvCoreTest/CacheTest.h>
 #include <djvCoreTest/ContextTest.h>
@@ -62,19 +63,34 @@
 #include <djvAVTest/AVSystemTest.h>
 #include <djvAVTest/AudioDataTest.h>
 #include <djvAVTest/AudioTest.h>
+#include <djvAVTest/CineonTest.h>
 #include <djvAVTest/ColorTest.h>
+#include <djvAVTest/DPXTest.h>
 #include <djvAVTest/EnumTest.h>
 #include <djvAVTest/FontSystemTest.h>
 #include <djvAVTest/IOTest.h>
+#include <djvAVTest/IOCacheManagerTest.h>
+#include <djvAVTest/IOCachePolicyTest.h>
+#include <djvAVTest/IODiskCacheTest.h>
+#include <djvAVTest/IOThreadPoolTest.h>
+#include <djvAVTest/ImageCompressedDataTest.h>
 #include <djvAVTest/ImageConvertTest.h>
+#include <djvAVTest/ImageDataPoolTest.h>
 #include <djvAVTest/ImageDataTest.h>
 #include <djvAVTest/ImageTest.h>
 #include <djvAVTest/OCIOSystemTest.h>
 #include <djvAVTest/OCIOTest.h>
 #include <djvAVTest/PixelTest.h>
+#include <djvAVTest/PPMTest.h>
 #include <djvAVTest/Render2DTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TagsTest.h>
+#if defined(FFmpeg_FOUND)
+#include <djvAVTest/FFmpegTest.h>
+#endif // FFmpeg_FOUND
+#if defined(TIFF_FOUND)
+#include <djvAVTest/TIFFTest.h>
+#endif // TIFF_FOUND
 
 #include <djvUITest/EnumTest.h>
 #include <djvUITest/WidgetTest.h>
@@ -104,6 +120,7 @@ int main(int argc, char ** argv)
         
         std::vector<std::shared_ptr<Test::ITest> > tests;
         tests.emplace_back(new CoreTest::AnimationTest(context));
+        tests.emplace_back(new CoreTest::AsyncFileIOTest(context));
         tests.emplace_back(new CoreTest::BBoxTest(context));
         tests.emplace_back(new CoreTest::CacheTest(context));
         tests.emplace_back(new CoreTest::DirectoryModelTest(context));
@@ -137,19 +154,34 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AVTest::AVSystemTest(context));
         tests.emplace_back(new AVTest::AudioDataTest(context));
         tests.emplace_back(new AVTest::AudioTest(context));
+        tests.emplace_back(new AVTest::CineonTest(context));
         tests.emplace_back(new AVTest::ColorTest(context));
+        tests.emplace_back(new AVTest::DPXTest(context));
         tests.emplace_back(new AVTest::EnumTest(context));
         tests.emplace_back(new AVTest::FontSystemTest(context));
         tests.emplace_back(new AVTest::IOTest(context));
+        tests.emplace_back(new AVTest::IOCacheManagerTest(context));
+        tests.emplace_back(new AVTest::IOCachePolicyTest(context));
+        tests.emplace_back(new AVTest::IODiskCacheTest(context));
+        tests.emplace_back(new AVTest::IOThreadPoolTest(context));
+        tests.emplace_back(new AVTest::ImageCompressedDataTest(context));
         tests.emplace_back(new AVTest::ImageConvertTest(context));
+        tests.emplace_back(new AVTest::ImageDataPoolTest(context));
         tests.emplace_back(new AVTest::ImageDataTest(context));
         tests.emplace_back(new AVTest::ImageTest(context));
         tests.emplace_back(new AVTest::OCIOSystemTest(context));
         tests.emplace_back(new AVTest::OCIOTest(context));
         tests.emplace_back(new AVTest::PixelTest(context));
+        tests.emplace_back(new AVTest::PPMTest(context));
         tests.emplace_back(new AVTest::Render2DTest(context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(context));
         tests.emplace_back(new AVTest::TagsTest(context));
+#if defined(FFmpeg_FOUND)
+        tests.emplace_back(new AVTest::FFmpegTest(context));
+#endif // FFmpeg_FOUND
+#if defined(TIFF_FOUND)
+        tests.emplace_back(new AVTest::TIFFTest(context));
+#endif // TIFF_FOUND
 
         tests.emplace_back(new UITest::EnumTest(context));
         tests.emplace_back(new UITest::WidgetTest(context));